@@ -0,0 +1,113 @@
+// Scénarios scriptés des mini-jeux pour --bench (voir engine/bench.h)
+#include "bench_scenarios.h"
+#include "engine/bench.h"
+#include "engine/input.h"
+#include "minigames/pousse_pousse/pousse_pousse.h"
+#include "minigames/traffic/traffic.h"
+#include "minigames/gateau/gateau.h"
+#include <math.h>
+
+static MinigameAPI current;
+
+// Mise à jour puis publication de l'état à dessiner (engine/pipeline.h)
+static void minigameUpdate(float dt) {
+    if (current.update) current.update(dt);
+    if (current.publish) current.publish();
+}
+static void minigameDraw(void) { if (current.draw) current.draw(); }
+static void minigameTeardown(void) { if (current.unload) current.unload(); }
+
+// --- Pousse-pousse : déplacements, annulations et remises à zéro ---
+static const int POUSSE_PATTERN[] = {
+    KEY_RIGHT, KEY_RIGHT, KEY_DOWN, KEY_DOWN, KEY_LEFT, KEY_UP, KEY_LEFT, KEY_UP,
+    KEY_DOWN, KEY_RIGHT, KEY_UP, KEY_LEFT
+};
+#define POUSSE_PATTERN_LEN (int)(sizeof(POUSSE_PATTERN) / sizeof(POUSSE_PATTERN[0]))
+
+static int pousseSkipLevels; // niveaux passés (N) avant la mesure
+
+static void pousseSetup(void) {
+    current = GetMinigamePoussePousse();
+    current.init();
+}
+
+void BenchScriptPousse(int frame) {
+    // les N tombent pendant la chauffe
+    InputScriptKey(KEY_N, frame < pousseSkipLevels * 2 && frame % 2 == 1);
+    int step = frame / 4;
+    for (int i = 0; i < POUSSE_PATTERN_LEN; ++i) InputScriptKey(POUSSE_PATTERN[i], false);
+    if (frame % 4 == 0) InputScriptKey(POUSSE_PATTERN[step % POUSSE_PATTERN_LEN], true);
+    InputScriptKey(KEY_LEFT_CONTROL, frame % 60 == 58 || frame % 60 == 59);
+    InputScriptKey(KEY_Z, frame % 60 == 59);
+    InputScriptKey(KEY_R, frame % 240 == 239);
+}
+
+static void pousseSmallSetup(void) { pousseSkipLevels = 0; pousseSetup(); }
+static void pousseLargeSetup(void) { pousseSkipLevels = 5; pousseSetup(); } // "Le grand entrepôt"
+
+// --- Gâteau : ouverture du frigo, glisser-déposer, mélange, annulation ---
+#define GATEAU_CYCLE 180
+
+static void gateauSetup(void) {
+    current = GetMinigameGateau();
+    current.init();
+}
+
+void BenchScriptGateau(int frame) {
+    InputScriptKey(KEY_LEFT_CONTROL, false);
+    InputScriptKey(KEY_Z, false);
+    if (frame < 20) { // clic sur le frigo puis attente de l'ouverture
+        InputScriptMouse((Vector2){ 50, 100 }, frame == 0 ? 1 : 0);
+        return;
+    }
+    int cycle = (frame - 20) / GATEAU_CYCLE;
+    int t = (frame - 20) % GATEAU_CYCLE;
+    int i = cycle % 20;
+    Vector2 from = { 60.0f + (i % 5) * 36.0f, 80.0f + (i / 5) * 66.0f };
+    Vector2 bowl = { 400, 260 };
+    if (t <= 20) { // saisie puis glisser vers le bol
+        float k = t / 20.0f;
+        InputScriptMouse((Vector2){ from.x + (bowl.x - from.x) * k, from.y + (bowl.y - from.y) * k }, 1);
+    } else if (t == 21) {
+        InputScriptMouse(bowl, 0);
+    } else if (t < 142) { // mélange en cercles
+        float a = (t - 22) * 0.2f;
+        InputScriptMouse((Vector2){ bowl.x + cosf(a) * 60.0f, bowl.y + sinf(a) * 30.0f }, 1);
+    } else {
+        InputScriptMouse(bowl, 0);
+        InputScriptKey(KEY_LEFT_CONTROL, t == 150 || t == 151);
+        InputScriptKey(KEY_Z, t == 151);
+    }
+}
+
+// --- Traffic : zigzag sur la route, relance après une partie perdue ---
+static float trafficDensity = 1.0f;
+
+static void trafficSetup(void) {
+    TrafficSetDensity(trafficDensity);
+    current = GetMinigameTraffic();
+    current.init();
+}
+
+void BenchScriptTraffic(int frame) {
+    bool left = (frame / 40) % 2 == 0;
+    InputScriptKey(KEY_LEFT, left);
+    InputScriptKey(KEY_RIGHT, !left);
+    InputScriptKey(KEY_R, frame % 30 == 0);
+}
+
+static void trafficTeardown(void) {
+    minigameTeardown();
+    TrafficSetDensity(1.0f);
+}
+
+static void trafficNormalSetup(void) { trafficDensity = 1.0f; trafficSetup(); }
+static void trafficDenseSetup(void) { trafficDensity = 6.0f; trafficSetup(); }
+
+void BenchRegisterMinigames(void) {
+    BenchRegister(&(BenchScenario){ "pousse", pousseSmallSetup, BenchScriptPousse, minigameUpdate, minigameDraw, minigameTeardown, 0 });
+    BenchRegister(&(BenchScenario){ "pousse_large", pousseLargeSetup, BenchScriptPousse, minigameUpdate, minigameDraw, minigameTeardown, 0 });
+    BenchRegister(&(BenchScenario){ "gateau", gateauSetup, BenchScriptGateau, minigameUpdate, minigameDraw, minigameTeardown, 0 });
+    BenchRegister(&(BenchScenario){ "traffic", trafficNormalSetup, BenchScriptTraffic, minigameUpdate, minigameDraw, trafficTeardown, 0, true });
+    BenchRegister(&(BenchScenario){ "traffic_dense", trafficDenseSetup, BenchScriptTraffic, minigameUpdate, minigameDraw, trafficTeardown, 0, true });
+}
@@ -0,0 +1,12 @@
+#ifndef BENCH_SCENARIOS_H
+#define BENCH_SCENARIOS_H
+
+// Scénarios du banc d'essai pour chaque mini-jeu (le hub est enregistré par main.c)
+void BenchRegisterMinigames(void);
+
+// Entrées scriptées d'un mini-jeu pour l'image "frame" (aussi rejouées par --soak)
+void BenchScriptPousse(int frame);
+void BenchScriptGateau(int frame);
+void BenchScriptTraffic(int frame);
+
+#endif // BENCH_SCENARIOS_H
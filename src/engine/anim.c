@@ -0,0 +1,369 @@
+// Animations par feuilles de sprites décrites dans un manifeste texte
+#include "anim.h"
+#include "hotreload.h"
+#include "trace.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ANIM_PATH_LEN 128
+#define ANIM_MAX_TEXTURE_SIZE 4096
+
+// Description brute d'une feuille, lue avant l'empaquetage
+struct AnimSheetSource {
+    char frames[ANIM_MAX_SHEET_FRAMES][ANIM_PATH_LEN];
+    int frameCount;
+    char fallback[ANIM_PATH_LEN];
+    char image[ANIM_PATH_LEN];
+    int imageCols, imageRows;
+};
+
+static void trimLine(char *s) {
+    size_t n = strlen(s);
+    while (n > 0 && (s[n-1] == '\n' || s[n-1] == '\r' || s[n-1] == ' ' || s[n-1] == '\t')) s[--n] = '\0';
+}
+
+// clip=nom:0,1,4-6@0.12[,0.2...][:once]
+static bool parseClip(AnimClip *clip, int sheet, const char *spec) {
+    char buf[256];
+    snprintf(buf, sizeof(buf), "%s", spec);
+
+    char *framesPart = strchr(buf, ':');
+    if (!framesPart) return false;
+    *framesPart++ = '\0';
+    char *durPart = strchr(framesPart, '@');
+    if (!durPart) return false;
+    *durPart++ = '\0';
+    char *flags = strchr(durPart, ':');
+    if (flags) *flags++ = '\0';
+
+    size_t nameLen = strlen(buf);
+    if (nameLen >= ANIM_NAME_LEN) return false;
+
+    memset(clip, 0, sizeof(*clip));
+    memcpy(clip->name, buf, nameLen + 1);
+    clip->sheet = sheet;
+    clip->loop = !(flags && strcmp(flags, "once") == 0);
+
+    for (char *tok = strtok(framesPart, ","); tok; tok = strtok(NULL, ",")) {
+        int a, b;
+        int n = sscanf(tok, "%d-%d", &a, &b);
+        if (n < 1) return false;
+        if (n == 1) b = a;
+        for (int f = a; f <= b && clip->frameCount < ANIM_MAX_CLIP_FRAMES; ++f) clip->frames[clip->frameCount++] = f;
+    }
+    if (clip->frameCount == 0) return false;
+
+    // Durées : une par frame, la dernière donnée se répète
+    float last = 0.1f;
+    int d = 0;
+    for (char *tok = strtok(durPart, ","); tok && d < clip->frameCount; tok = strtok(NULL, ",")) {
+        last = (float)atof(tok);
+        if (last < 0.01f) last = 0.01f;
+        clip->durations[d++] = last;
+    }
+    for (; d < clip->frameCount; ++d) clip->durations[d] = last;
+    return true;
+}
+
+static Image loadFrameImage(const AnimSheetSource *src, int i) {
+    Image img = LoadImage(src->frames[i]);
+    if (!img.data && src->fallback[0]) img = LoadImage(src->fallback);
+    return img;
+}
+
+// Planche de la feuille (dimensions de cellule fixées au premier chargement)
+static Image buildAtlas(AnimSheet *sheet) {
+    const AnimSheetSource *src = sheet->source;
+    Image atlas = { 0 };
+
+    if (src->image[0]) {
+        // Planche déjà découpée en grille
+        int cols = src->imageCols > 0 ? src->imageCols : 1;
+        int rows = src->imageRows > 0 ? src->imageRows : 1;
+        atlas = LoadImage(src->image);
+        if (!atlas.data) return atlas;
+        if (sheet->cellW <= 0 || sheet->cellH <= 0) {
+            sheet->cellW = atlas.width / cols;
+            sheet->cellH = atlas.height / rows;
+        }
+        if (atlas.width != cols * sheet->cellW || atlas.height != rows * sheet->cellH) {
+            ImageResize(&atlas, cols * sheet->cellW, rows * sheet->cellH);
+        }
+        sheet->columns = cols;
+        sheet->frameCount = cols * rows;
+        if (sheet->frameCount > ANIM_MAX_SHEET_FRAMES) sheet->frameCount = ANIM_MAX_SHEET_FRAMES;
+        for (int i = 0; i < sheet->frameCount; ++i) sheet->frameValid[i] = true;
+    } else {
+        // Frames isolées empaquetées dans une seule texture
+        int n = src->frameCount;
+        if (n == 0) return atlas;
+        if (sheet->cellW <= 0 || sheet->cellH <= 0) {
+            for (int i = 0; i < n && sheet->cellW <= 0; ++i) {
+                Image probe = loadFrameImage(src, i);
+                if (probe.data) { sheet->cellW = probe.width; sheet->cellH = probe.height; UnloadImage(probe); }
+            }
+            if (sheet->cellW <= 0) return atlas;
+        }
+        int cols = n;
+        int maxCols = ANIM_MAX_TEXTURE_SIZE / sheet->cellW;
+        if (maxCols < 1) maxCols = 1;
+        if (cols > maxCols) cols = maxCols;
+        int rows = (n + cols - 1) / cols;
+        atlas = GenImageColor(cols * sheet->cellW, rows * sheet->cellH, BLANK);
+        bool any = false;
+        for (int i = 0; i < n; ++i) {
+            Image img = loadFrameImage(src, i);
+            if (!img.data) continue;
+            if (img.width != sheet->cellW || img.height != sheet->cellH) ImageResize(&img, sheet->cellW, sheet->cellH);
+            Rectangle srcRec = { 0, 0, (float)img.width, (float)img.height };
+            Rectangle dstRec = { (float)((i % cols) * sheet->cellW), (float)((i / cols) * sheet->cellH), (float)sheet->cellW, (float)sheet->cellH };
+            ImageDraw(&atlas, img, srcRec, dstRec, WHITE);
+            UnloadImage(img);
+            sheet->frameValid[i] = true;
+            any = true;
+        }
+        if (!any) { UnloadImage(atlas); return (Image){ 0 }; }
+        sheet->columns = cols;
+        sheet->frameCount = n;
+    }
+    return atlas;
+}
+
+static void keepAlpha(AnimSheet *sheet, Image atlas) {
+    free(sheet->alpha);
+    sheet->alpha = NULL;
+    Color *colors = LoadImageColors(atlas);
+    if (!colors) return;
+    size_t count = (size_t)atlas.width * (size_t)atlas.height;
+    sheet->alpha = malloc(count);
+    if (sheet->alpha) {
+        for (size_t i = 0; i < count; ++i) sheet->alpha[i] = colors[i].a;
+        sheet->alphaWidth = atlas.width;
+    }
+    UnloadImageColors(colors);
+}
+
+static void buildSheet(AnimSheet *sheet) {
+    Image atlas = buildAtlas(sheet);
+    if (!atlas.data) return;
+    keepAlpha(sheet, atlas);
+    sheet->texture = LoadTextureFromImage(atlas);
+    UnloadImage(atlas);
+    SetTextureFilter(sheet->texture, TEXTURE_FILTER_BILINEAR);
+}
+
+// Une frame a changé : planche reconstruite et envoyée dans la même texture.
+// Les cellules étant fixées, ses dimensions ne changent pas ; les clips non plus.
+static void sheetChanged(void *arg) {
+    AnimSheet *sheet = arg;
+    AnimSheet rebuilt = *sheet;
+    Image atlas = buildAtlas(&rebuilt);
+    if (!atlas.data) return;
+    if (sheet->texture.id != 0 && atlas.width == sheet->texture.width && atlas.height == sheet->texture.height) {
+        if (atlas.format != sheet->texture.format) ImageFormat(&atlas, sheet->texture.format);
+        UpdateTexture(sheet->texture, atlas.data);
+        keepAlpha(sheet, atlas); // masques recalculés au prochain lancement du mini-jeu
+    }
+    UnloadImage(atlas);
+}
+
+// Rechargement à chaud : une surveillance par fichier source de la feuille
+static void watchSource(AnimSheet *sheet, const char *path) {
+    if (!path[0] || sheet->watchCount >= ANIM_MAX_WATCHES) return;
+    int w = HotReloadWatchFile(path, sheetChanged, sheet);
+    if (w >= 0) sheet->watches[sheet->watchCount++] = w;
+}
+
+int AnimLoadManifest(AnimBank *bank, const char *path) {
+    TRACE_SCOPE("asset.anims");
+    memset(bank, 0, sizeof(*bank));
+
+    FILE *f = fopen(path, "r");
+    if (!f) return 0;
+    int current = -1;
+    char line[256];
+    while (fgets(line, sizeof(line), f)) {
+        trimLine(line);
+        if (line[0] == '#' || line[0] == '\0') continue;
+        char name[ANIM_NAME_LEN];
+        char value[ANIM_PATH_LEN];
+        int a, b;
+        if (sscanf(line, "[sheet %31[^]]]", name) == 1) {
+            current = -1;
+            if (bank->sheetCount >= ANIM_MAX_SHEETS) continue;
+            AnimSheetSource *src = calloc(1, sizeof(AnimSheetSource));
+            if (!src) continue;
+            current = bank->sheetCount++;
+            bank->sheets[current].source = src;
+            snprintf(bank->sheets[current].name, sizeof(bank->sheets[current].name), "%s", name);
+        } else if (current < 0) {
+            continue;
+        } else if (sscanf(line, "cell=%d,%d", &a, &b) == 2) {
+            bank->sheets[current].cellW = a;
+            bank->sheets[current].cellH = b;
+        } else if (sscanf(line, "image=%127[^,],%d,%d", value, &a, &b) == 3) {
+            AnimSheetSource *src = bank->sheets[current].source;
+            strcpy(src->image, value);
+            src->imageCols = a;
+            src->imageRows = b;
+        } else if (sscanf(line, "frame=%127s", value) == 1) {
+            AnimSheetSource *src = bank->sheets[current].source;
+            if (src->frameCount < ANIM_MAX_SHEET_FRAMES) strcpy(src->frames[src->frameCount++], value);
+        } else if (sscanf(line, "fallback=%127s", value) == 1) {
+            strcpy(bank->sheets[current].source->fallback, value);
+        } else if (strncmp(line, "clip=", 5) == 0 && bank->clipCount < ANIM_MAX_CLIPS) {
+            if (parseClip(&bank->clips[bank->clipCount], current, line + 5)) bank->clipCount++;
+        }
+    }
+    fclose(f);
+
+    for (int s = 0; s < bank->sheetCount; ++s) buildSheet(&bank->sheets[s]);
+
+    if (HotReloadEnabled()) {
+        for (int s = 0; s < bank->sheetCount; ++s) {
+            AnimSheet *sheet = &bank->sheets[s];
+            if (sheet->texture.id == 0) continue;
+            const AnimSheetSource *src = sheet->source;
+            watchSource(sheet, src->image);
+            for (int i = 0; i < src->frameCount; ++i) watchSource(sheet, src->frames[i]);
+            watchSource(sheet, src->fallback);
+        }
+    }
+
+    // On ne garde que les clips dont les frames existent réellement
+    int kept = 0;
+    for (int c = 0; c < bank->clipCount; ++c) {
+        AnimClip clip = bank->clips[c];
+        const AnimSheet *sheet = &bank->sheets[clip.sheet];
+        if (sheet->texture.id == 0) continue;
+        int n = 0;
+        clip.totalDuration = 0.0f;
+        for (int i = 0; i < clip.frameCount; ++i) {
+            int fr = clip.frames[i];
+            if (fr < 0 || fr >= sheet->frameCount || !sheet->frameValid[fr]) continue;
+            clip.frames[n] = fr;
+            clip.durations[n] = clip.durations[i];
+            clip.totalDuration += clip.durations[n];
+            n++;
+        }
+        if (n == 0) continue;
+        clip.frameCount = n;
+        bank->clips[kept++] = clip;
+    }
+    bank->clipCount = kept;
+    return kept;
+}
+
+void AnimUnloadBank(AnimBank *bank) {
+    for (int s = 0; s < bank->sheetCount; ++s) {
+        AnimSheet *sheet = &bank->sheets[s];
+        for (int i = 0; i < sheet->watchCount; ++i) HotReloadUnwatch(sheet->watches[i]);
+        if (sheet->texture.id) UnloadTexture(sheet->texture);
+        free(sheet->alpha);
+        free(sheet->source);
+    }
+    memset(bank, 0, sizeof(*bank));
+}
+
+int AnimFindClip(const AnimBank *bank, const char *name) {
+    for (int c = 0; c < bank->clipCount; ++c) {
+        if (strcmp(bank->clips[c].name, name) == 0) return c;
+    }
+    return -1;
+}
+
+int AnimFindClipsWithPrefix(const AnimBank *bank, const char *prefix, int *out, int maxOut) {
+    int n = 0;
+    size_t len = strlen(prefix);
+    for (int c = 0; c < bank->clipCount && n < maxOut; ++c) {
+        if (strncmp(bank->clips[c].name, prefix, len) == 0) out[n++] = c;
+    }
+    return n;
+}
+
+void AnimPlay(AnimPlayer *player, int clip) {
+    if (player->clip == clip && !player->finished) return;
+    player->clip = clip;
+    player->frame = 0;
+    player->timer = 0.0f;
+    player->finished = false;
+}
+
+void AnimUpdate(const AnimBank *bank, AnimPlayer *player, float dt) {
+    if (player->clip < 0 || player->clip >= bank->clipCount || player->finished) return;
+    const AnimClip *clip = &bank->clips[player->clip];
+    player->timer += dt;
+    while (player->timer >= clip->durations[player->frame]) {
+        player->timer -= clip->durations[player->frame];
+        if (player->frame + 1 < clip->frameCount) {
+            player->frame++;
+        } else if (clip->loop) {
+            player->frame = 0;
+        } else {
+            player->finished = true;
+            player->timer = 0.0f;
+            break;
+        }
+    }
+}
+
+int AnimFrameAt(const AnimBank *bank, int clip, float time) {
+    if (clip < 0 || clip >= bank->clipCount) return 0;
+    const AnimClip *c = &bank->clips[clip];
+    float t = c->loop ? fmodf(time, c->totalDuration) : time;
+    for (int i = 0; i < c->frameCount; ++i) {
+        if (t < c->durations[i]) return i;
+        t -= c->durations[i];
+    }
+    return c->frameCount - 1;
+}
+
+void AnimDrawFrame(const AnimBank *bank, int clip, int frame, Rectangle dst, Color tint) {
+    if (clip < 0 || clip >= bank->clipCount) return;
+    const AnimClip *c = &bank->clips[clip];
+    const AnimSheet *sheet = &bank->sheets[c->sheet];
+    if (frame < 0 || frame >= c->frameCount) frame = 0;
+    int cell = c->frames[frame];
+    Rectangle src = {
+        (float)((cell % sheet->columns) * sheet->cellW),
+        (float)((cell / sheet->columns) * sheet->cellH),
+        (float)sheet->cellW,
+        (float)sheet->cellH
+    };
+    DrawTexturePro(sheet->texture, src, dst, (Vector2){ 0, 0 }, 0.0f, tint);
+}
+
+bool AnimFrameMask(const AnimBank *bank, int clip, int frame, int width, int height, Bitmask *mask) {
+    if (clip < 0 || clip >= bank->clipCount) return false;
+    const AnimClip *c = &bank->clips[clip];
+    const AnimSheet *sheet = &bank->sheets[c->sheet];
+    const unsigned char *alpha = sheet->alpha;
+    if (!alpha || !BitmaskCreate(mask, width, height)) return false;
+    if (frame < 0 || frame >= c->frameCount) frame = 0;
+    int cell = c->frames[frame];
+    int cellX = (cell % sheet->columns) * sheet->cellW;
+    int cellY = (cell / sheet->columns) * sheet->cellH;
+    int stride = sheet->alphaWidth;
+    for (int y = 0; y < height; ++y) {
+        int y0 = cellY + y * sheet->cellH / height;
+        int y1 = cellY + (y + 1) * sheet->cellH / height;
+        if (y1 <= y0) y1 = y0 + 1;
+        for (int x = 0; x < width; ++x) {
+            int x0 = cellX + x * sheet->cellW / width;
+            int x1 = cellX + (x + 1) * sheet->cellW / width;
+            if (x1 <= x0) x1 = x0 + 1;
+            int sum = 0;
+            for (int sy = y0; sy < y1; ++sy) {
+                for (int sx = x0; sx < x1; ++sx) sum += alpha[(size_t)sy * stride + sx];
+            }
+            if (sum * 2 >= (x1 - x0) * (y1 - y0) * 255) BitmaskSet(mask, x, y);
+        }
+    }
+    return true;
+}
+
+void AnimDraw(const AnimBank *bank, const AnimPlayer *player, Rectangle dst, Color tint) {
+    AnimDrawFrame(bank, player->clip, player->frame, dst, tint);
+}
@@ -0,0 +1,82 @@
+#ifndef ENGINE_ANIM_H
+#define ENGINE_ANIM_H
+
+#include "raylib.h"
+#include "bitmask.h"
+
+// Animations pilotées par un manifeste (voir assets/traffic/anims.ini).
+// Chaque feuille est une seule texture : les frames isolées listées dans le
+// manifeste sont redimensionnées et empaquetées en grille au chargement.
+
+#define ANIM_MAX_SHEETS 8
+#define ANIM_MAX_CLIPS 32
+#define ANIM_MAX_SHEET_FRAMES 64
+#define ANIM_MAX_CLIP_FRAMES 16
+#define ANIM_NAME_LEN 32
+#define ANIM_MAX_WATCHES (ANIM_MAX_SHEET_FRAMES + 2) // fichiers sources surveillés par feuille
+
+typedef struct AnimSheetSource AnimSheetSource; // chemins lus dans le manifeste
+
+typedef struct {
+    char name[ANIM_NAME_LEN];
+    Texture2D texture;
+    int cellW, cellH;
+    int columns;
+    int frameCount;
+    bool frameValid[ANIM_MAX_SHEET_FRAMES];
+    // Propres à la feuille, libérés par AnimUnloadBank
+    AnimSheetSource *source;                // relu au rechargement à chaud
+    unsigned char *alpha;                   // alpha de la planche, pour les masques
+    int alphaWidth;
+    int watches[ANIM_MAX_WATCHES];
+    int watchCount;
+} AnimSheet;
+
+typedef struct {
+    char name[ANIM_NAME_LEN];
+    int sheet;
+    int frameCount;
+    int frames[ANIM_MAX_CLIP_FRAMES];       // cellules dans la feuille
+    float durations[ANIM_MAX_CLIP_FRAMES];  // durée de chaque frame (s)
+    float totalDuration;
+    bool loop;
+} AnimClip;
+
+typedef struct {
+    AnimSheet sheets[ANIM_MAX_SHEETS];
+    int sheetCount;
+    AnimClip clips[ANIM_MAX_CLIPS];
+    int clipCount;
+} AnimBank;
+
+typedef struct {
+    int clip;
+    int frame;
+    float timer;
+    bool finished;
+} AnimPlayer;
+
+// Charge toutes les feuilles et clips du manifeste, retourne le nombre de clips utilisables.
+// bank doit être vierge ou déjà déchargée : chaque banque garde ses propres données.
+int AnimLoadManifest(AnimBank *bank, const char *path);
+void AnimUnloadBank(AnimBank *bank);
+
+int AnimFindClip(const AnimBank *bank, const char *name);
+// Variantes : tous les clips dont le nom commence par prefix (ex. "obstacle")
+int AnimFindClipsWithPrefix(const AnimBank *bank, const char *prefix, int *out, int maxOut);
+
+void AnimPlay(AnimPlayer *player, int clip);
+void AnimUpdate(const AnimBank *bank, AnimPlayer *player, float dt);
+
+// Frame d'un clip à un instant donné (animations sans état, ex. obstacles)
+int AnimFrameAt(const AnimBank *bank, int clip, float time);
+
+void AnimDrawFrame(const AnimBank *bank, int clip, int frame, Rectangle dst, Color tint);
+
+// Masque de collision d'une frame à sa taille d'affichage : un pixel est plein
+// si l'alpha moyen de la zone de la cellule qu'il couvre atteint 50 %.
+// L'alpha des feuilles est gardé en mémoire au chargement ; libérer avec BitmaskFree.
+bool AnimFrameMask(const AnimBank *bank, int clip, int frame, int width, int height, Bitmask *mask);
+void AnimDraw(const AnimBank *bank, const AnimPlayer *player, Rectangle dst, Color tint);
+
+#endif // ENGINE_ANIM_H
@@ -0,0 +1,189 @@
+// Moteur audio : banque d'effets préchargée + pool de voix mixé sur le thread audio
+#include "audio.h"
+#include "config.h"
+#include "trace.h"
+#include "raylib.h"
+#include <stdatomic.h>
+#include <string.h>
+
+#define AUDIO_COMMAND_QUEUE 64 // puissance de 2
+
+typedef struct {
+    float *samples;        // PCM float stéréo entrelacé
+    unsigned int frames;
+} SfxBuffer;
+
+typedef struct {
+    int sfx;               // -1 : voix libre
+    unsigned int pos;
+    float volume;
+    float pan;
+    unsigned int startSeq; // ordre de démarrage, pour voler la plus ancienne
+} Voice;
+
+typedef struct {
+    int sfx;
+    float volume;
+    float pan;
+} AudioCommand;
+
+static const char *SFX_FILES[SFX_COUNT] = {
+    "assets/sfx/fridge_open.wav",
+    "assets/sfx/pick.wav",
+    "assets/sfx/drop.wav",
+    "assets/sfx/decor.wav",
+    "assets/sfx/coin.wav",
+    "assets/sfx/crash.wav",
+    "assets/sfx/push.wav",
+    "assets/sfx/win.wav"
+};
+
+static SfxBuffer bank[SFX_COUNT];
+static Voice voices[AUDIO_MAX_VOICES];   // accédées uniquement par le thread audio
+static unsigned int voiceSeq;
+static AudioStream mixStream;
+static bool ready;
+
+// File SPSC : un producteur à la fois (thread principal ou de simulation) -> thread audio
+static AudioCommand commands[AUDIO_COMMAND_QUEUE];
+static atomic_uint commandHead;  // écrit par le producteur
+static atomic_uint commandTail;  // écrit par le thread audio
+
+static _Atomic float masterVolume = 1.0f;
+static _Atomic float busVolume[AUDIO_BUS_COUNT] = { 1.0f, 1.0f };
+
+static float clamp01(float v) {
+    return v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v);
+}
+
+static void startVoice(const AudioCommand *cmd) {
+    int slot = -1;
+    unsigned int oldest = 0;
+    for (int i = 0; i < AUDIO_MAX_VOICES; ++i) {
+        if (voices[i].sfx < 0) { slot = i; break; }
+        unsigned int age = voiceSeq - voices[i].startSeq;
+        if (slot < 0 || age > oldest) { slot = i; oldest = age; }
+    }
+    // Pool plein : on vole la voix démarrée le plus tôt
+    voices[slot] = (Voice){ cmd->sfx, 0, cmd->volume, cmd->pan, voiceSeq++ };
+}
+
+// Thread audio : aucune allocation, aucun verrou
+static void mixCallback(void *buffer, unsigned int frames) {
+    float *out = (float *)buffer;
+    memset(out, 0, frames * 2 * sizeof(float));
+
+    unsigned int tail = atomic_load_explicit(&commandTail, memory_order_relaxed);
+    unsigned int head = atomic_load_explicit(&commandHead, memory_order_acquire);
+    while (tail != head) {
+        startVoice(&commands[tail & (AUDIO_COMMAND_QUEUE - 1)]);
+        tail++;
+    }
+    atomic_store_explicit(&commandTail, tail, memory_order_release);
+
+    float gain = atomic_load(&masterVolume) * atomic_load(&busVolume[AUDIO_BUS_SFX]);
+    for (int v = 0; v < AUDIO_MAX_VOICES; ++v) {
+        Voice *voice = &voices[v];
+        if (voice->sfx < 0) continue;
+        const SfxBuffer *sb = &bank[voice->sfx];
+        float gl = gain * voice->volume * (voice->pan > 0.0f ? 1.0f - voice->pan : 1.0f);
+        float gr = gain * voice->volume * (voice->pan < 0.0f ? 1.0f + voice->pan : 1.0f);
+        unsigned int n = sb->frames - voice->pos;
+        if (n > frames) n = frames;
+        const float *src = sb->samples + voice->pos * 2;
+        for (unsigned int f = 0; f < n; ++f) {
+            out[f*2 + 0] += src[f*2 + 0] * gl;
+            out[f*2 + 1] += src[f*2 + 1] * gr;
+        }
+        voice->pos += n;
+        if (voice->pos >= sb->frames) voice->sfx = -1;
+    }
+
+    for (unsigned int i = 0; i < frames * 2; ++i) {
+        if (out[i] > 1.0f) out[i] = 1.0f;
+        else if (out[i] < -1.0f) out[i] = -1.0f;
+    }
+}
+
+static void loadBank(void) {
+    TRACE_SCOPE("asset.sfx");
+    for (int i = 0; i < SFX_COUNT; ++i) {
+        bank[i] = (SfxBuffer){ 0 };
+        if (!FileExists(SFX_FILES[i])) continue;
+        Wave wave = LoadWave(SFX_FILES[i]);
+        if (!wave.data || wave.frameCount == 0) { UnloadWave(wave); continue; }
+        // Conversion unique au format du mixeur (float stéréo)
+        WaveFormat(&wave, AUDIO_SAMPLE_RATE, 32, 2);
+        bank[i].samples = LoadWaveSamples(wave);
+        bank[i].frames = bank[i].samples ? wave.frameCount : 0;
+        UnloadWave(wave);
+    }
+}
+
+bool AudioEngineInit(void) {
+    if (ready) return true;
+    InitAudioDevice();
+    if (!IsAudioDeviceReady()) return false;
+
+    atomic_store(&masterVolume, clamp01(ConfigReadFloat("audio", "master_volume", 1.0f)));
+    atomic_store(&busVolume[AUDIO_BUS_SFX], clamp01(ConfigReadFloat("audio", "sfx_volume", 1.0f)));
+    atomic_store(&busVolume[AUDIO_BUS_MUSIC], clamp01(ConfigReadFloat("audio", "music_volume", 1.0f)));
+
+    loadBank();
+    for (int v = 0; v < AUDIO_MAX_VOICES; ++v) voices[v].sfx = -1;
+    atomic_store(&commandHead, 0);
+    atomic_store(&commandTail, 0);
+
+    mixStream = LoadAudioStream(AUDIO_SAMPLE_RATE, 32, 2);
+    SetAudioStreamCallback(mixStream, mixCallback);
+    PlayAudioStream(mixStream);
+    ready = true;
+    return true;
+}
+
+void AudioEngineShutdown(void) {
+    if (!ready) return;
+    StopAudioStream(mixStream);
+    UnloadAudioStream(mixStream);
+    for (int i = 0; i < SFX_COUNT; ++i) {
+        if (bank[i].samples) UnloadWaveSamples(bank[i].samples);
+        bank[i] = (SfxBuffer){ 0 };
+    }
+    CloseAudioDevice();
+    ready = false;
+}
+
+bool AudioEngineReady(void) {
+    return ready;
+}
+
+void AudioSetMasterVolume(float volume) {
+    atomic_store(&masterVolume, clamp01(volume));
+}
+
+float AudioGetMasterVolume(void) {
+    return atomic_load(&masterVolume);
+}
+
+void AudioSetBusVolume(AudioBus bus, float volume) {
+    if (bus < 0 || bus >= AUDIO_BUS_COUNT) return;
+    atomic_store(&busVolume[bus], clamp01(volume));
+}
+
+float AudioGetBusVolume(AudioBus bus) {
+    if (bus < 0 || bus >= AUDIO_BUS_COUNT) return 0.0f;
+    return atomic_load(&busVolume[bus]);
+}
+
+void AudioPlaySfxEx(SfxId sfx, float volume, float pan) {
+    if (!ready || sfx < 0 || sfx >= SFX_COUNT || bank[sfx].frames == 0) return;
+    unsigned int head = atomic_load_explicit(&commandHead, memory_order_relaxed);
+    unsigned int tail = atomic_load_explicit(&commandTail, memory_order_acquire);
+    if (head - tail >= AUDIO_COMMAND_QUEUE) return; // file pleine : son ignoré
+    commands[head & (AUDIO_COMMAND_QUEUE - 1)] = (AudioCommand){ sfx, clamp01(volume), pan < -1.0f ? -1.0f : (pan > 1.0f ? 1.0f : pan) };
+    atomic_store_explicit(&commandHead, head + 1, memory_order_release);
+}
+
+void AudioPlaySfx(SfxId sfx) {
+    AudioPlaySfxEx(sfx, 1.0f, 0.0f);
+}
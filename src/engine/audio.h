@@ -0,0 +1,47 @@
+#ifndef ENGINE_AUDIO_H
+#define ENGINE_AUDIO_H
+
+#include <stdbool.h>
+
+// Moteur audio global : initialisé une seule fois dans main().
+// Les effets sont préchargés (assets/sfx/) et mixés sur le thread audio
+// dans un pool de voix fixe ; déclencher un son ne fait aucune allocation.
+
+#define AUDIO_MAX_VOICES 16
+#define AUDIO_SAMPLE_RATE 44100
+
+typedef enum {
+    SFX_FRIDGE_OPEN = 0,
+    SFX_PICK,
+    SFX_DROP,
+    SFX_DECOR,
+    SFX_COIN,
+    SFX_CRASH,
+    SFX_PUSH,
+    SFX_WIN,
+    SFX_COUNT
+} SfxId;
+
+typedef enum {
+    AUDIO_BUS_SFX = 0,
+    AUDIO_BUS_MUSIC,
+    AUDIO_BUS_COUNT
+} AudioBus;
+
+bool AudioEngineInit(void);   // volumes lus dans [audio] de config/default.ini
+void AudioEngineShutdown(void);
+bool AudioEngineReady(void);
+
+void AudioSetMasterVolume(float volume);
+float AudioGetMasterVolume(void);
+void AudioSetBusVolume(AudioBus bus, float volume);
+float AudioGetBusVolume(AudioBus bus);
+
+// Déclenchement depuis le update d'un mini-jeu. Un seul producteur à la fois :
+// le thread principal ou le thread de simulation (engine/pipeline.h), jamais
+// les deux en même temps. Les update successifs sont ordonnés par le pipeline.
+void AudioPlaySfx(SfxId sfx);
+// volume 0..1, pan -1 (gauche) .. 1 (droite)
+void AudioPlaySfxEx(SfxId sfx, float volume, float pan);
+
+#endif // ENGINE_AUDIO_H
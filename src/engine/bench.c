@@ -0,0 +1,220 @@
+// Banc d'essai : scénarios scriptés, percentiles de temps d'image, allocations
+#include "bench.h"
+#include "input.h"
+#include "memtrack.h"
+#include "pipeline.h"
+#include "thread.h"
+#include "raylib.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_WARMUP 30
+#define BENCH_DEFAULT_FRAMES 600
+#define BENCH_DT (1.0f / 60.0f)
+
+typedef struct {
+    char name[64];
+    char mode[16];               // "headless" (logique), "render" ou "pipelined"
+    int frames;
+    double ticksPerSec;
+    double p50, p90, p99, max;   // millisecondes
+    double allocsPerFrame;
+    double bytesPerFrame;
+} BenchResult;
+
+static BenchScenario scenarios[BENCH_MAX_SCENARIOS];
+static int scenarioCount;
+
+void BenchParseArgs(BenchOptions *opt, int argc, char **argv) {
+    memset(opt, 0, sizeof(*opt));
+    opt->tolerance = 0.10f;
+    opt->outPath = "bench_results.json";
+    opt->baselinePath = "config/bench_baseline.json";
+    for (int i = 1; i < argc; ++i) {
+        const char *a = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (strcmp(a, "--bench") == 0) opt->enabled = true;
+        else if (strcmp(a, "--bench-save-baseline") == 0) opt->enabled = opt->saveBaseline = true;
+        else if (strcmp(a, "--bench-frames") == 0 && hasValue) opt->frames = atoi(argv[++i]);
+        else if (strcmp(a, "--bench-tolerance") == 0 && hasValue) opt->tolerance = (float)atof(argv[++i]);
+        else if (strcmp(a, "--bench-out") == 0 && hasValue) opt->outPath = argv[++i];
+        else if (strcmp(a, "--bench-baseline") == 0 && hasValue) opt->baselinePath = argv[++i];
+    }
+}
+
+void BenchRegister(const BenchScenario *scenario) {
+    if (scenarioCount >= BENCH_MAX_SCENARIOS) return;
+    scenarios[scenarioCount++] = *scenario;
+}
+
+static int compareDouble(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static double percentile(const double *sorted, int n, double p) {
+    int i = (int)(p * (n - 1) + 0.5);
+    return sorted[i < 0 ? 0 : (i >= n ? n - 1 : i)];
+}
+
+typedef enum { BENCH_HEADLESS, BENCH_RENDER, BENCH_PIPELINED, BENCH_MODE_COUNT } BenchMode;
+static const char *BENCH_MODE_NAMES[BENCH_MODE_COUNT] = { "headless", "render", "pipelined" };
+
+static void runScenario(const BenchScenario *s, BenchMode mode, int frames, double *times, BenchResult *r) {
+    MemTrackStats before = {0}, after = {0};
+    double measured = 0.0;
+
+    SetRandomSeed(1); // mêmes apparitions d'une exécution à l'autre
+    InputSetScripted(true);
+    if (s->setup) s->setup();
+    PipelineReset();
+    for (int f = 0; f < BENCH_WARMUP + frames; ++f) {
+        if (f == BENCH_WARMUP) MemTrackSnapshot(&before);
+        double start = ThreadNowSeconds();
+        InputScriptBeginFrame();
+        if (s->script) s->script(f);
+        if (mode == BENCH_PIPELINED) {
+            PipelineKick(s->update, BENCH_DT);
+            BeginDrawing();
+            ClearBackground((Color){ 30, 34, 46, 255 });
+            if (s->draw) s->draw();
+            PipelineWait();
+            EndDrawing();
+        } else {
+            if (s->update) PipelineRun(s->update, BENCH_DT);
+            if (mode == BENCH_RENDER) {
+                BeginDrawing();
+                ClearBackground((Color){ 30, 34, 46, 255 });
+                if (s->draw) s->draw();
+                EndDrawing();
+            }
+        }
+        double elapsed = ThreadNowSeconds() - start;
+        if (f >= BENCH_WARMUP) {
+            times[f - BENCH_WARMUP] = elapsed;
+            measured += elapsed;
+        }
+    }
+    MemTrackSnapshot(&after);
+    if (s->teardown) s->teardown();
+
+    qsort(times, (size_t)frames, sizeof(double), compareDouble);
+    snprintf(r->name, sizeof(r->name), "%s", s->name);
+    snprintf(r->mode, sizeof(r->mode), "%s", BENCH_MODE_NAMES[mode]);
+    r->frames = frames;
+    r->ticksPerSec = measured > 0.0 ? frames / measured : 0.0;
+    r->p50 = percentile(times, frames, 0.50) * 1000.0;
+    r->p90 = percentile(times, frames, 0.90) * 1000.0;
+    r->p99 = percentile(times, frames, 0.99) * 1000.0;
+    r->max = times[frames - 1] * 1000.0;
+    r->allocsPerFrame = (double)(after.allocs - before.allocs) / frames;
+    r->bytesPerFrame = (double)(after.bytes - before.bytes) / frames;
+}
+
+// Une ligne par résultat : relu tel quel par loadBaseline
+static const char *RESULT_FORMAT =
+    "  {\"name\": \"%s\", \"mode\": \"%s\", \"frames\": %d, \"ticks_per_s\": %.1f, "
+    "\"p50_ms\": %.4f, \"p90_ms\": %.4f, \"p99_ms\": %.4f, \"max_ms\": %.4f, "
+    "\"allocs_per_frame\": %.2f, \"bytes_per_frame\": %.1f}%s\n";
+
+static bool writeResults(const char *path, const BenchResult *results, int count) {
+    FILE *f = fopen(path, "w");
+    if (!f) return false;
+    fprintf(f, "{\"memtrack\": %s, \"results\": [\n", MemTrackEnabled() ? "true" : "false");
+    for (int i = 0; i < count; ++i) {
+        const BenchResult *r = &results[i];
+        fprintf(f, RESULT_FORMAT, r->name, r->mode, r->frames, r->ticksPerSec, r->p50, r->p90, r->p99, r->max,
+                r->allocsPerFrame, r->bytesPerFrame, i + 1 < count ? "," : "");
+    }
+    fprintf(f, "]}\n");
+    fclose(f);
+    return true;
+}
+
+static int loadBaseline(const char *path, BenchResult *out, int capacity) {
+    FILE *f = fopen(path, "r");
+    if (!f) return 0;
+    char line[512];
+    int count = 0;
+    while (count < capacity && fgets(line, sizeof(line), f)) {
+        BenchResult *r = &out[count];
+        if (sscanf(line, " {\"name\": \"%63[^\"]\", \"mode\": \"%15[^\"]\", \"frames\": %d, \"ticks_per_s\": %lf, "
+                         "\"p50_ms\": %lf, \"p90_ms\": %lf, \"p99_ms\": %lf, \"max_ms\": %lf, "
+                         "\"allocs_per_frame\": %lf, \"bytes_per_frame\": %lf",
+                   r->name, r->mode, &r->frames, &r->ticksPerSec, &r->p50, &r->p90, &r->p99, &r->max,
+                   &r->allocsPerFrame, &r->bytesPerFrame) == 10) {
+            count++;
+        }
+    }
+    fclose(f);
+    return count;
+}
+
+static const BenchResult *findResult(const BenchResult *results, int count, const BenchResult *key) {
+    for (int i = 0; i < count; ++i) {
+        if (strcmp(results[i].name, key->name) == 0 && strcmp(results[i].mode, key->mode) == 0) return &results[i];
+    }
+    return NULL;
+}
+
+int BenchRun(const BenchOptions *opt) {
+    static BenchResult results[BENCH_MAX_SCENARIOS * BENCH_MODE_COUNT];
+    static BenchResult baseline[BENCH_MAX_SCENARIOS * BENCH_MODE_COUNT];
+    int resultCount = 0;
+
+    // Sans référence, aucune régression ne peut être détectée : échec immédiat
+    int baselineCount = opt->saveBaseline ? 0 : loadBaseline(opt->baselinePath, baseline, BENCH_MAX_SCENARIOS * BENCH_MODE_COUNT);
+    if (!opt->saveBaseline && baselineCount == 0) {
+        fprintf(stderr, "bench: pas de référence (%s) : lancer une fois avec --bench-save-baseline\n", opt->baselinePath);
+        return 2;
+    }
+
+    int maxFrames = opt->frames > 0 ? opt->frames : BENCH_DEFAULT_FRAMES;
+    for (int i = 0; i < scenarioCount; ++i) {
+        if (opt->frames <= 0 && scenarios[i].frames > maxFrames) maxFrames = scenarios[i].frames;
+    }
+    double *times = malloc(sizeof(double) * (size_t)maxFrames);
+    if (!times) return 1;
+
+    for (int i = 0; i < scenarioCount; ++i) {
+        const BenchScenario *s = &scenarios[i];
+        int frames = opt->frames > 0 ? opt->frames : (s->frames > 0 ? s->frames : BENCH_DEFAULT_FRAMES);
+        for (int mode = 0; mode < BENCH_MODE_COUNT; ++mode) {
+            if (mode == BENCH_PIPELINED && !(s->pipelined && s->update)) continue;
+            runScenario(s, (BenchMode)mode, frames, times, &results[resultCount]);
+            resultCount++;
+        }
+    }
+    free(times);
+    InputSetScripted(false);
+
+    if (!writeResults(opt->outPath, results, resultCount)) {
+        fprintf(stderr, "bench: impossible d'écrire %s\n", opt->outPath);
+    }
+    int regressions = 0;
+    printf("%-16s %-9s %10s %8s %8s %8s %10s\n", "scenario", "mode", "ticks/s", "p50 ms", "p90 ms", "p99 ms", "allocs/img");
+    for (int i = 0; i < resultCount; ++i) {
+        const BenchResult *r = &results[i];
+        const BenchResult *b = findResult(baseline, baselineCount, r);
+        const char *verdict = "";
+        if (b) {
+            bool slower = r->p90 > b->p90 * (1.0 + opt->tolerance)
+                       || r->ticksPerSec < b->ticksPerSec / (1.0 + opt->tolerance);
+            bool moreAllocs = MemTrackEnabled() && r->allocsPerFrame > b->allocsPerFrame + 0.5;
+            if (slower || moreAllocs) {
+                verdict = slower ? "  REGRESSION (temps)" : "  REGRESSION (allocations)";
+                regressions++;
+            }
+        }
+        printf("%-16s %-9s %10.1f %8.3f %8.3f %8.3f %10.2f%s\n", r->name, r->mode, r->ticksPerSec,
+               r->p50, r->p90, r->p99, r->allocsPerFrame, verdict);
+    }
+
+    if (opt->saveBaseline) {
+        if (writeResults(opt->baselinePath, results, resultCount)) printf("référence enregistrée : %s\n", opt->baselinePath);
+    } else {
+        printf("%d régression(s) par rapport à %s (tolérance %.0f %%)\n", regressions, opt->baselinePath, opt->tolerance * 100.0f);
+    }
+    return regressions > 0 ? 1 : 0;
+}
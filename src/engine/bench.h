@@ -0,0 +1,42 @@
+#ifndef ENGINE_BENCH_H
+#define ENGINE_BENCH_H
+
+#include <stdbool.h>
+
+// Banc d'essai (--bench) : chaque scénario rejoue un script d'entrées à pas
+// fixe, d'abord sans rendu (logique seule) puis avec rendu, et enfin avec la
+// mise à jour sur le thread de simulation (engine/pipeline.h) si le scénario
+// le permet. Résultats en JSON (une ligne par scénario et par mode), comparés
+// à un fichier de référence.
+
+#define BENCH_MAX_SCENARIOS 16
+
+typedef struct {
+    const char *name;
+    void (*setup)(void);
+    void (*script)(int frame);   // entrées de l'image (InputScript*)
+    void (*update)(float dt);
+    void (*draw)(void);          // appelé entre BeginDrawing et EndDrawing
+    void (*teardown)(void);
+    int frames;                  // 0 : valeur des options
+    bool pipelined;              // update peut tourner pendant draw (mode "pipelined")
+} BenchScenario;
+
+typedef struct {
+    bool enabled;
+    int frames;                  // images mesurées par scénario et par mode
+    float tolerance;             // écart admis avant de signaler une régression
+    const char *outPath;
+    const char *baselinePath;
+    bool saveBaseline;           // écrit aussi les résultats comme référence
+} BenchOptions;
+
+// Reconnaît --bench, --bench-frames N, --bench-tolerance T, --bench-out F,
+// --bench-baseline F, --bench-save-baseline
+void BenchParseArgs(BenchOptions *opt, int argc, char **argv);
+void BenchRegister(const BenchScenario *scenario);
+// Fenêtre déjà ouverte ; retourne le code de sortie (1 si régression,
+// 2 si la référence manque hors --bench-save-baseline)
+int BenchRun(const BenchOptions *opt);
+
+#endif // ENGINE_BENCH_H
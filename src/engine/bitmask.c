@@ -0,0 +1,74 @@
+// Masques de collision 1 bit, test de chevauchement par mots de 64 bits
+#include "bitmask.h"
+#include <stdlib.h>
+#include <string.h>
+
+bool BitmaskCreate(Bitmask *mask, int width, int height) {
+    memset(mask, 0, sizeof(*mask));
+    if (width <= 0 || height <= 0) return false;
+    int words = (width + 63) / 64;
+    mask->bits = calloc((size_t)words * (size_t)height, sizeof(uint64_t));
+    if (!mask->bits) return false;
+    mask->width = width;
+    mask->height = height;
+    mask->wordsPerRow = words;
+    return true;
+}
+
+void BitmaskFree(Bitmask *mask) {
+    free(mask->bits);
+    memset(mask, 0, sizeof(*mask));
+}
+
+void BitmaskFill(Bitmask *mask) {
+    int tail = mask->width & 63; // bits utiles du dernier mot de chaque ligne
+    for (int y = 0; y < mask->height; ++y) {
+        uint64_t *row = mask->bits + (size_t)y * mask->wordsPerRow;
+        for (int k = 0; k < mask->wordsPerRow; ++k) row[k] = ~0ULL;
+        if (tail) row[mask->wordsPerRow - 1] = (1ULL << tail) - 1;
+    }
+}
+
+void BitmaskSet(Bitmask *mask, int x, int y) {
+    if (x < 0 || y < 0 || x >= mask->width || y >= mask->height) return;
+    mask->bits[(size_t)y * mask->wordsPerRow + (x >> 6)] |= 1ULL << (x & 63);
+}
+
+bool BitmaskGet(const Bitmask *mask, int x, int y) {
+    if (x < 0 || y < 0 || x >= mask->width || y >= mask->height) return false;
+    return (mask->bits[(size_t)y * mask->wordsPerRow + (x >> 6)] >> (x & 63)) & 1;
+}
+
+// 64 bits d'une ligne à partir de la colonne col (éventuellement négative) ;
+// les colonnes hors du masque valent 0
+static uint64_t rowBits(const uint64_t *row, int words, int col) {
+    int word = col >= 0 ? col / 64 : -((-col + 63) / 64);
+    int shift = col - word * 64;
+    uint64_t lo = (word >= 0 && word < words) ? row[word] : 0;
+    if (shift == 0) return lo;
+    uint64_t hi = (word + 1 >= 0 && word + 1 < words) ? row[word + 1] : 0;
+    return (lo >> shift) | (hi << (64 - shift));
+}
+
+bool BitmaskOverlap(const Bitmask *a, int ax, int ay, const Bitmask *b, int bx, int by) {
+    if (!a->bits || !b->bits) return false;
+    // Dans le repère de a, b est décalé de (dx, dy) ; seule l'intersection compte
+    int dx = bx - ax, dy = by - ay;
+    int x0 = dx > 0 ? dx : 0;
+    int y0 = dy > 0 ? dy : 0;
+    int x1 = dx + b->width < a->width ? dx + b->width : a->width;
+    int y1 = dy + b->height < a->height ? dy + b->height : a->height;
+    if (x0 >= x1 || y0 >= y1) return false;
+
+    for (int y = y0; y < y1; ++y) {
+        const uint64_t *rowA = a->bits + (size_t)y * a->wordsPerRow;
+        const uint64_t *rowB = b->bits + (size_t)(y - dy) * b->wordsPerRow;
+        for (int x = x0 & ~63; x < x1; x += 64) {
+            uint64_t wa = rowA[x >> 6];
+            if (x < x0) wa &= ~0ULL << (x0 - x);
+            if (x1 - x < 64) wa &= (1ULL << (x1 - x)) - 1;
+            if (wa && (wa & rowBits(rowB, b->wordsPerRow, x - dx))) return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,27 @@
+#ifndef ENGINE_BITMASK_H
+#define ENGINE_BITMASK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Masques de collision : 1 bit par pixel, chaque ligne en mots de 64 bits
+// (bit 0 du mot k = colonne 64k). Le test de chevauchement travaille mot par
+// mot (décalage + ET) : au plus deux mots par ligne pour un sprite de moins
+// de 128 px de large. Pas de dépendance à raylib.
+
+typedef struct {
+    int width, height;
+    int wordsPerRow;
+    uint64_t *bits;    // height * wordsPerRow mots, bits hors largeur à 0
+} Bitmask;
+
+bool BitmaskCreate(Bitmask *mask, int width, int height);   // tous les bits à 0
+void BitmaskFree(Bitmask *mask);
+void BitmaskFill(Bitmask *mask);                            // masque plein (rectangle)
+void BitmaskSet(Bitmask *mask, int x, int y);
+bool BitmaskGet(const Bitmask *mask, int x, int y);
+
+// Vrai si un pixel plein de a (coin haut-gauche en ax, ay) recouvre un pixel plein de b
+bool BitmaskOverlap(const Bitmask *a, int ax, int ay, const Bitmask *b, int bx, int by);
+
+#endif // ENGINE_BITMASK_H
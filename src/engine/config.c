@@ -0,0 +1,51 @@
+// Lecture des paramètres de config/default.ini
+#include "config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Copie la valeur brute de section.key dans out, faux si absente
+static bool readRaw(const char *section, const char *key, char *out, size_t outSize) {
+    FILE *f = fopen(CONFIG_FILE, "r");
+    if (!f) return false;
+    char line[256];
+    char current[64] = "";
+    bool found = false;
+    size_t keyLen = strlen(key);
+    while (!found && fgets(line, sizeof(line), f)) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '#' || line[0] == ';' || line[0] == '\0') continue;
+        if (sscanf(line, "[%63[^]]]", current) == 1) continue;
+        if (strcmp(current, section) != 0) continue;
+        if (strncmp(line, key, keyLen) == 0 && line[keyLen] == '=') {
+            snprintf(out, outSize, "%s", line + keyLen + 1);
+            found = true;
+        }
+    }
+    fclose(f);
+    return found;
+}
+
+float ConfigReadFloat(const char *section, const char *key, float fallback) {
+    char value[64];
+    if (!readRaw(section, key, value, sizeof(value))) return fallback;
+    char *end = NULL;
+    float v = strtof(value, &end);
+    return end != value ? v : fallback;
+}
+
+int ConfigReadInt(const char *section, const char *key, int fallback) {
+    char value[64];
+    if (!readRaw(section, key, value, sizeof(value))) return fallback;
+    char *end = NULL;
+    long v = strtol(value, &end, 10);
+    return end != value ? (int)v : fallback;
+}
+
+bool ConfigReadBool(const char *section, const char *key, bool fallback) {
+    char value[64];
+    if (!readRaw(section, key, value, sizeof(value))) return fallback;
+    if (strcmp(value, "True") == 0 || strcmp(value, "true") == 0 || strcmp(value, "1") == 0) return true;
+    if (strcmp(value, "False") == 0 || strcmp(value, "false") == 0 || strcmp(value, "0") == 0) return false;
+    return fallback;
+}
@@ -0,0 +1,15 @@
+#ifndef ENGINE_CONFIG_H
+#define ENGINE_CONFIG_H
+
+#include <stdbool.h>
+
+// Lecture ponctuelle de config/default.ini ([section] puis clé=valeur).
+// Les valeurs absentes ou illisibles renvoient fallback.
+
+#define CONFIG_FILE "config/default.ini"
+
+float ConfigReadFloat(const char *section, const char *key, float fallback);
+int ConfigReadInt(const char *section, const char *key, int fallback);
+bool ConfigReadBool(const char *section, const char *key, bool fallback);
+
+#endif // ENGINE_CONFIG_H
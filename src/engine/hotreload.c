@@ -0,0 +1,281 @@
+// Surveillance des fichiers d'assets et rechargement en place
+#include "hotreload.h"
+#include "texture.h"
+#include "thread.h"
+#include "trace.h"
+#include <stdatomic.h>
+#include <string.h>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#define HOT_RELOAD_PATH_LEN 128
+#define HOT_RELOAD_TICK_MS 250   // période du relevé des dates (et délai d'ajout d'un dossier à inotify)
+#define HOT_RELOAD_SETTLE 0.15   // s sans nouvelle écriture avant de relire le fichier
+
+typedef struct {
+    bool used;
+    unsigned int serial;         // change à chaque réutilisation de l'emplacement
+    char path[HOT_RELOAD_PATH_LEN];
+    Texture2D *texture;          // NULL : simple fichier
+    HotReloadFunc fn;
+    void *arg;
+    long long mtime, size;       // dernier état vu par le relevé périodique
+    int wd;                      // inotify : dossier surveillé, -1 tant qu'il n'est pas ajouté
+    bool dirty;                  // modifié, en attente de stabilisation
+    double dirtyAt;
+    bool ready;                  // à appliquer par HotReloadPoll
+    Image pending;               // image décodée (textures)
+} Watch;
+
+static Watch watches[HOT_RELOAD_MAX_WATCHES];
+static atomic_int readyCount;    // évite de verrouiller à chaque image quand rien n'a changé
+static Mutex *lock;
+static Thread *watcher;
+static bool stopping;
+static bool active;
+static int inotifyFd = -1;
+
+static const char *baseName(const char *path) {
+    const char *slash = strrchr(path, '/');
+    const char *back = strrchr(path, '\\');
+    if (back > slash) slash = back;
+    return slash ? slash + 1 : path;
+}
+
+static void markDirty(Watch *w) {
+    w->dirty = true;
+    w->dirtyAt = ThreadNowSeconds(); // une nouvelle écriture repousse la relecture
+}
+
+// Relevé périodique (Windows, ou inotify indisponible) : date et taille
+static void scanModifications(void) {
+    MutexLock(lock);
+    for (int i = 0; i < HOT_RELOAD_MAX_WATCHES; ++i) {
+        Watch *w = &watches[i];
+        if (!w->used) continue;
+        struct stat st;
+        if (stat(w->path, &st) != 0) continue;
+        if ((long long)st.st_mtime == w->mtime && (long long)st.st_size == w->size) continue;
+        w->mtime = (long long)st.st_mtime;
+        w->size = (long long)st.st_size;
+        markDirty(w);
+    }
+    MutexUnlock(lock);
+}
+
+#ifdef __linux__
+static void watchInotify(void) {
+    // Dossiers des nouveaux abonnements (inotify renvoie le même wd pour un dossier déjà suivi)
+    MutexLock(lock);
+    for (int i = 0; i < HOT_RELOAD_MAX_WATCHES; ++i) {
+        Watch *w = &watches[i];
+        if (!w->used || w->wd >= 0) continue;
+        char dir[HOT_RELOAD_PATH_LEN];
+        size_t len = (size_t)(baseName(w->path) - w->path);
+        if (len == 0) strcpy(dir, ".");
+        else { memcpy(dir, w->path, len); dir[len] = '\0'; }
+        w->wd = inotify_add_watch(inotifyFd, dir, IN_CLOSE_WRITE | IN_MOVED_TO);
+    }
+    MutexUnlock(lock);
+
+    struct pollfd pfd = { inotifyFd, POLLIN, 0 };
+    if (poll(&pfd, 1, HOT_RELOAD_TICK_MS) <= 0) return;
+    char buf[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    ssize_t n;
+    while ((n = read(inotifyFd, buf, sizeof(buf))) > 0) {
+        MutexLock(lock);
+        for (char *p = buf; p < buf + n; ) {
+            const struct inotify_event *e = (const struct inotify_event *)p;
+            for (int i = 0; e->len > 0 && i < HOT_RELOAD_MAX_WATCHES; ++i) {
+                Watch *w = &watches[i];
+                if (w->used && w->wd == e->wd && strcmp(baseName(w->path), e->name) == 0) markDirty(w);
+            }
+            p += sizeof(struct inotify_event) + e->len;
+        }
+        MutexUnlock(lock);
+    }
+}
+#endif
+
+// Verrou tenu ; relâché pendant le décodage
+static void decodeSettled(void) {
+    double now = ThreadNowSeconds();
+    for (int i = 0; i < HOT_RELOAD_MAX_WATCHES; ++i) {
+        Watch *w = &watches[i];
+        if (!w->used || !w->dirty || now - w->dirtyAt < HOT_RELOAD_SETTLE) continue;
+        w->dirty = false;
+        if (!w->texture) {
+            if (!w->ready) atomic_fetch_add(&readyCount, 1);
+            w->ready = true;
+            continue;
+        }
+        char path[HOT_RELOAD_PATH_LEN];
+        strcpy(path, w->path);
+        unsigned int serial = w->serial;
+        MutexUnlock(lock);
+        Image img = TextureDecode(path); // .dds s'il est plus récent que le PNG
+        MutexLock(lock);
+        if (!img.data) continue; // fichier illisible : on attend la prochaine écriture
+        if (!w->used || w->serial != serial) { UnloadImage(img); continue; }
+        if (w->ready) UnloadImage(w->pending); // remplacée par une version plus récente
+        else atomic_fetch_add(&readyCount, 1);
+        w->pending = img;
+        w->ready = true;
+    }
+}
+
+static void watcherMain(void *arg) {
+    (void)arg;
+    MutexLock(lock);
+    while (!stopping) {
+        MutexUnlock(lock);
+#ifdef __linux__
+        if (inotifyFd >= 0) watchInotify();
+        else
+#endif
+        {
+            ThreadSleepMs(HOT_RELOAD_TICK_MS);
+            scanModifications();
+        }
+        MutexLock(lock);
+        decodeSettled();
+    }
+    MutexUnlock(lock);
+}
+
+void HotReloadInit(void) {
+    if (active) return;
+    memset(watches, 0, sizeof(watches));
+    atomic_store(&readyCount, 0);
+    lock = MutexCreate();
+    if (!lock) return;
+#ifdef __linux__
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC); // -1 : relevé périodique
+#endif
+    stopping = false;
+    active = true;
+    watcher = ThreadCreate(watcherMain, NULL, "watch");
+    if (!watcher) HotReloadShutdown();
+}
+
+void HotReloadShutdown(void) {
+    if (!active) return;
+    if (watcher) {
+        MutexLock(lock);
+        stopping = true;
+        MutexUnlock(lock);
+        ThreadJoin(watcher);
+        watcher = NULL;
+    }
+    for (int i = 0; i < HOT_RELOAD_MAX_WATCHES; ++i) HotReloadUnwatch(i);
+#ifdef __linux__
+    if (inotifyFd >= 0) close(inotifyFd);
+    inotifyFd = -1;
+#endif
+    MutexDestroy(lock);
+    lock = NULL;
+    active = false;
+}
+
+bool HotReloadEnabled(void) {
+    return active;
+}
+
+static int addWatch(const char *path, Texture2D *texture, HotReloadFunc fn, void *arg) {
+    if (!active || !path || strlen(path) >= HOT_RELOAD_PATH_LEN) return -1;
+    struct stat st;
+    bool exists = stat(path, &st) == 0;
+    MutexLock(lock);
+    for (int i = 0; i < HOT_RELOAD_MAX_WATCHES; ++i) {
+        Watch *w = &watches[i];
+        if (w->used) continue;
+        unsigned int serial = w->serial + 1;
+        memset(w, 0, sizeof(*w));
+        w->used = true;
+        w->serial = serial;
+        strcpy(w->path, path);
+        w->texture = texture;
+        w->fn = fn;
+        w->arg = arg;
+        w->mtime = exists ? (long long)st.st_mtime : 0;
+        w->size = exists ? (long long)st.st_size : 0;
+        w->wd = -1;
+        MutexUnlock(lock);
+        return i;
+    }
+    MutexUnlock(lock);
+    return -1;
+}
+
+int HotReloadWatchTexture(const char *path, Texture2D *texture, HotReloadFunc onReload, void *arg) {
+    if (!texture) return -1;
+    return addWatch(path, texture, onReload, arg);
+}
+
+int HotReloadWatchFile(const char *path, HotReloadFunc onChange, void *arg) {
+    return addWatch(path, NULL, onChange, arg);
+}
+
+void HotReloadUnwatch(int watch) {
+    if (!active || watch < 0 || watch >= HOT_RELOAD_MAX_WATCHES) return;
+    MutexLock(lock);
+    Watch *w = &watches[watch];
+    if (w->used && w->ready) {
+        if (w->pending.data) UnloadImage(w->pending);
+        atomic_fetch_sub(&readyCount, 1);
+    }
+    w->used = false;
+    w->ready = false;
+    w->pending = (Image){0};
+    MutexUnlock(lock);
+}
+
+static bool isCompressed(int format) {
+    return format >= PIXELFORMAT_COMPRESSED_DXT1_RGB;
+}
+
+// Même taille : mise à jour en place, l'identifiant (et ses copies) reste valide.
+// Une texture compressée (.dds) retouchée en PNG est recréée, décompressée.
+static void applyTexture(Texture2D *texture, Image img, const char *path) {
+    bool inPlace = texture->id != 0 && img.width == texture->width && img.height == texture->height &&
+                   !isCompressed(img.format) && !isCompressed(texture->format);
+    if (inPlace) {
+        TRACE_SCOPE("asset.texture");
+        if (img.format != texture->format) ImageFormat(&img, texture->format);
+        UpdateTexture(*texture, img.data);
+        if (texture->mipmaps > 1) GenTextureMipmaps(texture);
+        UnloadImage(img);
+        return;
+    }
+    Texture2D fresh = TextureUpload(&img, path);
+    if (fresh.id != 0) {
+        if (texture->id != 0) UnloadTexture(*texture);
+        *texture = fresh;
+    }
+}
+
+void HotReloadPoll(void) {
+    if (!active || atomic_load(&readyCount) == 0) return;
+    TRACE_SCOPE("hotreload");
+    for (int i = 0; i < HOT_RELOAD_MAX_WATCHES; ++i) {
+        MutexLock(lock);
+        Watch *w = &watches[i];
+        if (!w->used || !w->ready) { MutexUnlock(lock); continue; }
+        w->ready = false;
+        atomic_fetch_sub(&readyCount, 1);
+        Image img = w->pending;
+        w->pending = (Image){0};
+        Texture2D *texture = w->texture;
+        HotReloadFunc fn = w->fn;
+        void *arg = w->arg;
+        MutexUnlock(lock);
+        // Les abonnements ne changent que sur ce thread : path reste valide
+        TraceLog(LOG_INFO, "HOTRELOAD: %s", w->path);
+        if (texture) applyTexture(texture, img, w->path);
+        if (fn) fn(arg);
+    }
+}
@@ -0,0 +1,33 @@
+#ifndef ENGINE_HOTRELOAD_H
+#define ENGINE_HOTRELOAD_H
+
+#include "raylib.h"
+
+// Rechargement à chaud des assets pendant le développement.
+// Un thread surveille les fichiers enregistrés (inotify sous Linux, relevé
+// périodique des dates de modification ailleurs) et décode les images
+// modifiées ; HotReloadPoll applique les changements sur le thread principal :
+// texture mise à jour en place (même identifiant, si la taille n'a pas changé)
+// puis rappel du propriétaire. L'état du jeu n'est pas touché.
+
+#define HOT_RELOAD_MAX_WATCHES 64
+
+typedef void (*HotReloadFunc)(void *arg);
+
+void HotReloadInit(void);      // après InitWindow ; outil de développement, lancé à la demande
+void HotReloadShutdown(void);
+bool HotReloadEnabled(void);
+
+// Retournent un identifiant de surveillance, -1 si inactif ou table pleine.
+// Texture : l'image est décodée hors du thread principal puis *texture est
+// mise à jour ; si ses dimensions changent, la texture est recréée et
+// onReload doit propager le nouvel identifiant (peut être NULL).
+int HotReloadWatchTexture(const char *path, Texture2D *texture, HotReloadFunc onReload, void *arg);
+// Fichier quelconque : onChange est appelé sur le thread principal
+int HotReloadWatchFile(const char *path, HotReloadFunc onChange, void *arg);
+void HotReloadUnwatch(int watch);
+
+// Thread principal, en début d'image (aucune simulation en cours)
+void HotReloadPoll(void);
+
+#endif // ENGINE_HOTRELOAD_H
@@ -0,0 +1,201 @@
+// Entrées : relevé cumulé des sondages raylib (late latch) ou état rejoué par script
+#include "input.h"
+#include "thread.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define INPUT_LATENCY_SAMPLES 512
+
+static bool scripted;
+static bool keys[INPUT_MAX_KEYS], prevKeys[INPUT_MAX_KEYS], repeatKeys[INPUT_MAX_KEYS];
+static int buttons, prevButtons;
+static Vector2 mouse;
+
+// Mode réel : chaque sondage de raylib (dans EndDrawing ou InputLatchNow) est
+// relevé une fois ; les fronts s'accumulent jusqu'à l'image qui les consomme
+static bool pendingPressed[INPUT_MAX_KEYS], pendingReleased[INPUT_MAX_KEYS], pendingRepeat[INPUT_MAX_KEYS];
+static bool framePressed[INPUT_MAX_KEYS], frameReleased[INPUT_MAX_KEYS], frameRepeat[INPUT_MAX_KEYS];
+static int pendingButtonsPressed, pendingButtonsReleased, frameButtonsPressed, frameButtonsReleased;
+static bool polled = true;          // un sondage raylib n'a pas encore été relevé
+static bool inFrame;                // entre InputBeginFrame et InputFramePresented
+static double pollTime;             // heure du sondage pas encore relevé
+static double lastPoll;             // heure du sondage précédent
+
+// Latence : heure estimée de la plus ancienne entrée affichée par cette image / la suivante
+static double eventThisFrame, eventNextFrame;
+static float latencies[INPUT_LATENCY_SAMPLES];
+static int latencyCount, latencyHead;
+
+static bool validKey(int key) {
+    return key >= 0 && key < INPUT_MAX_KEYS;
+}
+
+static void noteEvent(double *slot, double when) {
+    if (*slot == 0.0 || when < *slot) *slot = when;
+}
+
+// Relève l'état du dernier sondage ; un événement est daté au milieu de
+// l'intervalle entre ce sondage et le précédent
+static void latch(double pollTime) {
+    double when = lastPoll > 0.0 ? (lastPoll + pollTime) * 0.5 : pollTime;
+    bool edge = false;
+    for (int k = 0; k < INPUT_MAX_KEYS; ++k) {
+        if (IsKeyPressed(k)) { pendingPressed[k] = true; edge = true; }
+        if (IsKeyReleased(k)) pendingReleased[k] = true;
+        if (IsKeyPressedRepeat(k)) { pendingRepeat[k] = true; edge = true; }
+        keys[k] = IsKeyDown(k);
+    }
+    buttons = 0;
+    for (int b = 0; b < INPUT_MAX_BUTTONS; ++b) {
+        if (IsMouseButtonPressed(b)) { pendingButtonsPressed |= 1 << b; edge = true; }
+        if (IsMouseButtonReleased(b)) pendingButtonsReleased |= 1 << b;
+        if (IsMouseButtonDown(b)) buttons |= 1 << b;
+    }
+    Vector2 m = GetMousePosition();
+    bool moved = m.x != mouse.x || m.y != mouse.y;
+    mouse = m;
+
+    // un front relevé après la mise à jour n'est lu qu'à l'image suivante ;
+    // la souris, elle, sert dès le dessin de l'image en cours
+    if (edge) noteEvent(inFrame ? &eventNextFrame : &eventThisFrame, when);
+    if (moved) noteEvent(&eventThisFrame, when);
+    lastPoll = pollTime;
+}
+
+static void latchIfPolled(void) {
+    if (!polled) return;
+    polled = false;
+    latch(pollTime);
+}
+
+void InputBeginFrame(void) {
+    if (scripted) return;
+    if (pollTime == 0.0) pollTime = ThreadNowSeconds(); // première image
+    latchIfPolled();
+    memcpy(framePressed, pendingPressed, sizeof(framePressed));
+    memcpy(frameReleased, pendingReleased, sizeof(frameReleased));
+    memcpy(frameRepeat, pendingRepeat, sizeof(frameRepeat));
+    memset(pendingPressed, 0, sizeof(pendingPressed));
+    memset(pendingReleased, 0, sizeof(pendingReleased));
+    memset(pendingRepeat, 0, sizeof(pendingRepeat));
+    frameButtonsPressed = pendingButtonsPressed;
+    frameButtonsReleased = pendingButtonsReleased;
+    pendingButtonsPressed = pendingButtonsReleased = 0;
+    inFrame = true;
+}
+
+void InputLatchNow(void) {
+    if (scripted) return;
+    latchIfPolled(); // le sondage d'EndDrawing d'abord : ses fronts ne doivent pas être écrasés
+    PollInputEvents();
+    pollTime = ThreadNowSeconds();
+    polled = true;
+    latchIfPolled();
+}
+
+void InputFramePresented(void) {
+    if (scripted) return;
+    double now = ThreadNowSeconds();
+    if (eventThisFrame > 0.0) {
+        latencies[latencyHead] = (float)((now - eventThisFrame) * 1000.0);
+        latencyHead = (latencyHead + 1) % INPUT_LATENCY_SAMPLES;
+        if (latencyCount < INPUT_LATENCY_SAMPLES) latencyCount++;
+    }
+    eventThisFrame = eventNextFrame;
+    eventNextFrame = 0.0;
+    inFrame = false;
+    pollTime = now;
+    polled = true; // EndDrawing vient de sonder
+}
+
+static int compareFloat(const void *a, const void *b) {
+    float x = *(const float *)a, y = *(const float *)b;
+    return (x > y) - (x < y);
+}
+
+int InputLatencyPercentiles(float *p50, float *p90, float *p99) {
+    static float sorted[INPUT_LATENCY_SAMPLES];
+    int n = latencyCount;
+    *p50 = *p90 = *p99 = 0.0f;
+    if (n == 0) return 0;
+    memcpy(sorted, latencies, sizeof(float) * n);
+    qsort(sorted, n, sizeof(float), compareFloat);
+    *p50 = sorted[(n - 1) * 50 / 100];
+    *p90 = sorted[(n - 1) * 90 / 100];
+    *p99 = sorted[(n - 1) * 99 / 100];
+    return n;
+}
+
+bool InputKeyDown(int key) {
+    return validKey(key) && keys[key];
+}
+
+bool InputKeyPressed(int key) {
+    if (!validKey(key)) return false;
+    return scripted ? keys[key] && !prevKeys[key] : framePressed[key];
+}
+
+bool InputKeyPressedRepeat(int key) {
+    if (!validKey(key)) return false;
+    return scripted ? repeatKeys[key] : frameRepeat[key];
+}
+
+bool InputMouseDown(int button) {
+    return (buttons >> button) & 1;
+}
+
+bool InputMousePressed(int button) {
+    int pressed = scripted ? buttons & ~prevButtons : frameButtonsPressed;
+    return (pressed >> button) & 1;
+}
+
+bool InputMouseReleased(int button) {
+    int released = scripted ? prevButtons & ~buttons : frameButtonsReleased;
+    return (released >> button) & 1;
+}
+
+Vector2 InputMousePosition(void) {
+    return mouse;
+}
+
+void InputSetScripted(bool on) {
+    scripted = on;
+    memset(keys, 0, sizeof(keys));
+    memset(prevKeys, 0, sizeof(prevKeys));
+    memset(repeatKeys, 0, sizeof(repeatKeys));
+    memset(pendingPressed, 0, sizeof(pendingPressed));
+    memset(pendingReleased, 0, sizeof(pendingReleased));
+    memset(pendingRepeat, 0, sizeof(pendingRepeat));
+    memset(framePressed, 0, sizeof(framePressed));
+    memset(frameReleased, 0, sizeof(frameReleased));
+    memset(frameRepeat, 0, sizeof(frameRepeat));
+    buttons = prevButtons = 0;
+    pendingButtonsPressed = pendingButtonsReleased = frameButtonsPressed = frameButtonsReleased = 0;
+    mouse = (Vector2){ 0, 0 };
+    polled = true;
+    inFrame = false;
+    eventThisFrame = eventNextFrame = 0.0;
+}
+
+bool InputIsScripted(void) {
+    return scripted;
+}
+
+void InputScriptBeginFrame(void) {
+    memcpy(prevKeys, keys, sizeof(keys));
+    memset(repeatKeys, 0, sizeof(repeatKeys));
+    prevButtons = buttons;
+}
+
+void InputScriptKey(int key, bool down) {
+    if (validKey(key)) keys[key] = down;
+}
+
+void InputScriptRepeat(int key) {
+    if (validKey(key)) repeatKeys[key] = keys[key] && prevKeys[key];
+}
+
+void InputScriptMouse(Vector2 position, int buttonMask) {
+    mouse = position;
+    buttons = buttonMask;
+}
@@ -0,0 +1,42 @@
+#ifndef ENGINE_INPUT_H
+#define ENGINE_INPUT_H
+
+#include "raylib.h"
+#include <stdbool.h>
+
+// Entrées du jeu : relevées depuis raylib, ou rejouées depuis un script (bench,
+// tests d'endurance). Le hub et les mini-jeux passent tous par ces fonctions
+// plutôt que par IsKeyPressed & co.
+// En mode réel, chaque sondage de raylib est relevé une fois et les appuis sont
+// cumulés jusqu'à l'image qui les lit : on peut donc sonder de nouveau en
+// cours d'image (late latch) sans perdre de front.
+
+#define INPUT_MAX_KEYS 512
+#define INPUT_MAX_BUTTONS 3
+
+bool InputKeyDown(int key);
+bool InputKeyPressed(int key);
+bool InputKeyPressedRepeat(int key);
+bool InputMouseDown(int button);
+bool InputMousePressed(int button);
+bool InputMouseReleased(int button);
+Vector2 InputMousePosition(void);
+
+// Boucle principale (sans effet en mode script)
+void InputBeginFrame(void);      // avant la mise à jour : publie les appuis relevés
+void InputLatchNow(void);        // sonde maintenant ; la souris est à jour pour le dessin
+void InputFramePresented(void);  // juste après EndDrawing
+// Latence entrée -> image présentée (ms) sur les dernières images ayant reçu
+// une entrée ; retourne le nombre de mesures
+int InputLatencyPercentiles(float *p50, float *p90, float *p99);
+
+// Mode script : l'état est fixé image par image ; pressé / relâché sont
+// déduits de l'image précédente
+void InputSetScripted(bool scripted);
+bool InputIsScripted(void);
+void InputScriptBeginFrame(void);          // l'état courant devient l'image précédente
+void InputScriptKey(int key, bool down);
+void InputScriptRepeat(int key);           // répétition clavier pour cette image
+void InputScriptMouse(Vector2 position, int buttonMask); // bit b : bouton b enfoncé
+
+#endif // ENGINE_INPUT_H
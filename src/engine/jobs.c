@@ -0,0 +1,305 @@
+// Jobs : une file de Chase-Lev par thread de travail, vol de travail, compteurs
+#include "jobs.h"
+#include "thread.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+#define JOBS_MAX_WORKERS 32
+#define JOBS_DEQUE_SIZE 4096      // puissance de deux
+#define JOBS_INJECT_SIZE 4096
+#define JOBS_MAX_DEFERRED 256
+#define JOBS_MAX_CHUNKS 128
+
+typedef struct {
+    JobFunc fn;
+    void *arg;
+    JobCounter *counter;
+} Job;
+
+// Le propriétaire empile et dépile en bas ; les autres threads volent en haut
+typedef struct {
+    atomic_llong top, bottom;
+    Job jobs[JOBS_DEQUE_SIZE];
+    Thread *thread;
+} Worker;
+
+static Worker *workers;
+static int workerCount;
+static _Thread_local int workerIndex = -1;   // file du thread courant (-1 : autre thread)
+static _Thread_local unsigned int stealSeed;
+
+// File commune des threads extérieurs (principal, simulation, musique...)
+static Mutex *injectLock;
+static Job inject[JOBS_INJECT_SIZE];
+static int injectHead, injectCount;
+
+// Jobs en attente d'une dépendance
+typedef struct {
+    JobCounter *dependsOn;
+    Job job;
+} Deferred;
+static Mutex *deferredLock;
+static Deferred deferred[JOBS_MAX_DEFERRED];
+static int deferredCount;
+
+// Sommeil des threads inoccupés et réveil de ceux qui attendent un compteur
+static Mutex *sleepLock;
+static CondVar *wakeCond, *doneCond;
+static atomic_int queued;                    // jobs déposés, pas encore pris
+static atomic_bool quit;
+
+static bool dequePush(Worker *w, Job job) {
+    long long b = atomic_load_explicit(&w->bottom, memory_order_relaxed);
+    long long t = atomic_load_explicit(&w->top, memory_order_acquire);
+    if (b - t >= JOBS_DEQUE_SIZE) return false;
+    w->jobs[b & (JOBS_DEQUE_SIZE - 1)] = job;
+    atomic_store_explicit(&w->bottom, b + 1, memory_order_seq_cst);
+    return true;
+}
+
+static bool dequeTake(Worker *w, Job *out) {
+    long long b = atomic_load_explicit(&w->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&w->bottom, b, memory_order_seq_cst);
+    long long t = atomic_load_explicit(&w->top, memory_order_seq_cst);
+    if (t > b) {
+        atomic_store_explicit(&w->bottom, b + 1, memory_order_relaxed);
+        return false;
+    }
+    *out = w->jobs[b & (JOBS_DEQUE_SIZE - 1)];
+    if (t < b) return true;
+    // dernier élément : course avec les voleurs
+    bool won = atomic_compare_exchange_strong_explicit(&w->top, &t, t + 1, memory_order_seq_cst, memory_order_relaxed);
+    atomic_store_explicit(&w->bottom, b + 1, memory_order_relaxed);
+    return won;
+}
+
+static bool dequeSteal(Worker *w, Job *out) {
+    long long t = atomic_load_explicit(&w->top, memory_order_seq_cst);
+    long long b = atomic_load_explicit(&w->bottom, memory_order_seq_cst);
+    if (t >= b) return false;
+    Job job = w->jobs[t & (JOBS_DEQUE_SIZE - 1)];
+    if (!atomic_compare_exchange_strong_explicit(&w->top, &t, t + 1, memory_order_seq_cst, memory_order_relaxed)) return false;
+    *out = job;
+    return true;
+}
+
+static bool injectPop(Job *out) {
+    MutexLock(injectLock);
+    bool found = injectCount > 0;
+    if (found) {
+        *out = inject[injectHead];
+        injectHead = (injectHead + 1) % JOBS_INJECT_SIZE;
+        injectCount--;
+    }
+    MutexUnlock(injectLock);
+    return found;
+}
+
+static bool findJob(Job *out) {
+    bool found = (workerIndex >= 0 && dequeTake(&workers[workerIndex], out)) || injectPop(out);
+    if (!found) {
+        // victime de départ tirée au hasard : les voleurs ne se ruent pas tous sur la même file
+        stealSeed = stealSeed * 1664525u + 1013904223u;
+        int start = (int)((stealSeed >> 16) % (unsigned int)workerCount);
+        for (int k = 0; k < workerCount && !found; ++k) {
+            int v = (start + k) % workerCount;
+            if (v != workerIndex) found = dequeSteal(&workers[v], out);
+        }
+    }
+    if (found) atomic_fetch_sub(&queued, 1);
+    return found;
+}
+
+static void releaseDeferred(void);
+
+static void execute(Job job) {
+    job.fn(job.arg);
+    if (job.counter && atomic_fetch_sub(&job.counter->pending, 1) == 1) {
+        releaseDeferred();
+        MutexLock(sleepLock);
+        CondBroadcast(doneCond);
+        MutexUnlock(sleepLock);
+    }
+}
+
+static void submit(Job job) {
+    if (workerCount == 0) {
+        execute(job);
+        return;
+    }
+    if (workerIndex < 0 || !dequePush(&workers[workerIndex], job)) {
+        MutexLock(injectLock);
+        bool full = injectCount == JOBS_INJECT_SIZE;
+        if (!full) {
+            inject[(injectHead + injectCount) % JOBS_INJECT_SIZE] = job;
+            injectCount++;
+        }
+        MutexUnlock(injectLock);
+        if (full) { // files pleines : exécution sur place
+            execute(job);
+            return;
+        }
+    }
+    atomic_fetch_add(&queued, 1);
+    MutexLock(sleepLock);
+    CondSignal(wakeCond);
+    MutexUnlock(sleepLock);
+}
+
+static void releaseDeferred(void) {
+    Job ready[JOBS_MAX_DEFERRED];
+    int n = 0;
+    MutexLock(deferredLock);
+    for (int i = 0; i < deferredCount;) {
+        if (atomic_load(&deferred[i].dependsOn->pending) == 0) {
+            ready[n++] = deferred[i].job;
+            deferred[i] = deferred[--deferredCount];
+        } else {
+            ++i;
+        }
+    }
+    MutexUnlock(deferredLock);
+    for (int i = 0; i < n; ++i) submit(ready[i]);
+}
+
+static void workerMain(void *arg) {
+    workerIndex = (int)(intptr_t)arg;
+    stealSeed = 0x9E3779B9u * (unsigned int)(workerIndex + 1);
+    for (;;) {
+        Job job;
+        if (findJob(&job)) {
+            execute(job);
+            continue;
+        }
+        MutexLock(sleepLock);
+        while (atomic_load(&queued) == 0 && !atomic_load(&quit)) CondWait(wakeCond, sleepLock);
+        MutexUnlock(sleepLock);
+        if (atomic_load(&quit) && atomic_load(&queued) == 0) break;
+    }
+}
+
+void JobsInit(int count) {
+    if (sleepLock) return;
+    if (count <= 0) count = ThreadHardwareConcurrency() - 1;
+    if (count > JOBS_MAX_WORKERS) count = JOBS_MAX_WORKERS;
+    injectLock = MutexCreate();
+    deferredLock = MutexCreate();
+    sleepLock = MutexCreate();
+    wakeCond = CondCreate();
+    doneCond = CondCreate();
+    atomic_store(&quit, false);
+    atomic_store(&queued, 0);
+    injectHead = injectCount = deferredCount = 0;
+    workerCount = 0;
+    workers = count > 0 ? calloc((size_t)count, sizeof(Worker)) : NULL;
+    if (!workers) return; // tout s'exécute sur place
+    // fixé avant le démarrage : les threads lisent workerCount pour voler.
+    // Une file sans thread (création échouée) reste vide, sans conséquence.
+    workerCount = count;
+    int started = 0;
+    for (int i = 0; i < count; ++i) {
+        workers[i].thread = ThreadCreate(workerMain, (void *)(intptr_t)i, "job");
+        if (workers[i].thread) started++;
+    }
+    if (started == 0) {
+        workerCount = 0;
+        free(workers);
+        workers = NULL;
+    }
+}
+
+void JobsShutdown(void) {
+    if (!sleepLock) return;
+    MutexLock(sleepLock);
+    atomic_store(&quit, true);
+    CondBroadcast(wakeCond);
+    MutexUnlock(sleepLock);
+    for (int i = 0; i < workerCount; ++i) ThreadJoin(workers[i].thread); // NULL accepté
+    free(workers);
+    workers = NULL;
+    workerCount = 0;
+    CondDestroy(doneCond);
+    CondDestroy(wakeCond);
+    MutexDestroy(sleepLock);
+    MutexDestroy(deferredLock);
+    MutexDestroy(injectLock);
+    sleepLock = NULL;
+}
+
+int JobsWorkerCount(void) {
+    return workerCount;
+}
+
+void JobsRun(JobFunc fn, void *arg, JobCounter *counter) {
+    if (counter) atomic_fetch_add(&counter->pending, 1);
+    submit((Job){ fn, arg, counter });
+}
+
+void JobsRunAfter(JobCounter *dependsOn, JobFunc fn, void *arg, JobCounter *counter) {
+    if (counter) atomic_fetch_add(&counter->pending, 1);
+    Job job = { fn, arg, counter };
+    if (dependsOn && workerCount > 0) {
+        // vérifié sous le verrou : le job qui termine dependsOn le verra forcément
+        MutexLock(deferredLock);
+        bool waiting = atomic_load(&dependsOn->pending) > 0 && deferredCount < JOBS_MAX_DEFERRED;
+        if (waiting) deferred[deferredCount++] = (Deferred){ dependsOn, job };
+        MutexUnlock(deferredLock);
+        if (waiting) return;
+    }
+    JobsWait(dependsOn); // table pleine (ou pas de thread de travail) : attente sur place
+    submit(job);
+}
+
+bool JobsDone(JobCounter *counter) {
+    return !counter || atomic_load(&counter->pending) == 0;
+}
+
+void JobsWait(JobCounter *counter) {
+    if (!counter) return;
+    while (atomic_load(&counter->pending) > 0) {
+        Job job;
+        if (workerCount > 0 && findJob(&job)) {
+            execute(job);
+            continue;
+        }
+        MutexLock(sleepLock);
+        if (atomic_load(&counter->pending) > 0 && atomic_load(&queued) == 0) CondWaitTimeout(doneCond, sleepLock, 1);
+        MutexUnlock(sleepLock);
+    }
+}
+
+typedef struct {
+    JobRangeFunc fn;
+    void *arg;
+    int begin, end;
+} Chunk;
+
+static void runChunk(void *arg) {
+    Chunk *c = arg;
+    c->fn(c->begin, c->end, c->arg);
+}
+
+void JobsParallelFor(int count, int grain, JobRangeFunc fn, void *arg) {
+    if (count <= 0) return;
+    if (grain < 1) grain = 1;
+    int chunks = (count + grain - 1) / grain;
+    int maxChunks = (workerCount + 1) * 4;  // assez de tranches pour équilibrer par vol
+    if (maxChunks > JOBS_MAX_CHUNKS) maxChunks = JOBS_MAX_CHUNKS;
+    if (chunks > maxChunks) chunks = maxChunks;
+    if (chunks <= 1 || workerCount == 0) {
+        fn(0, count, arg);
+        return;
+    }
+    int size = (count + chunks - 1) / chunks;
+    Chunk parts[JOBS_MAX_CHUNKS];
+    JobCounter done;
+    atomic_init(&done.pending, 0);
+    int n = 0;
+    for (int begin = size; begin < count; begin += size) {
+        parts[n] = (Chunk){ fn, arg, begin, begin + size < count ? begin + size : count };
+        JobsRun(runChunk, &parts[n], &done);
+        n++;
+    }
+    fn(0, size, arg); // première tranche sur le thread appelant
+    JobsWait(&done);
+}
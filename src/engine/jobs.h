@@ -0,0 +1,38 @@
+#ifndef ENGINE_JOBS_H
+#define ENGINE_JOBS_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+
+// Système de jobs : un thread par cœur (moins le thread principal), chacun avec
+// sa file à double entrée. Un job lancé depuis un job va dans la file de son
+// thread ; les threads inoccupés volent dans celles des autres. Les autres
+// threads (principal, simulation...) déposent dans une file commune.
+// Sans thread de travail (machine à un cœur), les jobs s'exécutent tout de suite.
+
+typedef void (*JobFunc)(void *arg);
+typedef void (*JobRangeFunc)(int begin, int end, void *arg);
+
+// Compteur de jobs en cours : incrémenté au lancement, décrémenté à la fin.
+// À initialiser à zéro ; sert à attendre un groupe de jobs ou à en dépendre.
+typedef struct {
+    atomic_int pending;
+} JobCounter;
+
+void JobsInit(int workers);     // 0 : un par cœur, moins le thread principal
+void JobsShutdown(void);        // attend la fin de tous les jobs
+int JobsWorkerCount(void);
+
+// counter peut être NULL (job sans suivi)
+void JobsRun(JobFunc fn, void *arg, JobCounter *counter);
+// Lancé seulement quand dependsOn est revenu à zéro
+void JobsRunAfter(JobCounter *dependsOn, JobFunc fn, void *arg, JobCounter *counter);
+bool JobsDone(JobCounter *counter);
+// Le thread appelant exécute d'autres jobs en attendant
+void JobsWait(JobCounter *counter);
+
+// Découpe [0, count) en tranches d'au moins grain éléments, traitées en
+// parallèle (le thread appelant compris) ; retourne quand tout est fait
+void JobsParallelFor(int count, int grain, JobRangeFunc fn, void *arg);
+
+#endif // ENGINE_JOBS_H
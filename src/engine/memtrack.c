@@ -0,0 +1,92 @@
+// Compteurs d'allocations (redirection de malloc & co. par l'éditeur de liens)
+#include "memtrack.h"
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdio.h>
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <unistd.h>
+#endif
+
+static atomic_llong allocCount, freeCount, allocBytes;
+static atomic_llong liveResources[MEMTRACK_RESOURCE_COUNT];
+
+#ifdef GN_MEMTRACK
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+void __real_free(void *ptr);
+
+void *__wrap_malloc(size_t size) {
+    atomic_fetch_add_explicit(&allocCount, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&allocBytes, (long long)size, memory_order_relaxed);
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size) {
+    atomic_fetch_add_explicit(&allocCount, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&allocBytes, (long long)(count * size), memory_order_relaxed);
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+    if (size == 0 && ptr) {
+        atomic_fetch_add_explicit(&freeCount, 1, memory_order_relaxed);
+    } else {
+        atomic_fetch_add_explicit(&allocCount, 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&allocBytes, (long long)size, memory_order_relaxed);
+        if (ptr) atomic_fetch_add_explicit(&freeCount, 1, memory_order_relaxed);
+    }
+    return __real_realloc(ptr, size);
+}
+
+void __wrap_free(void *ptr) {
+    if (ptr) atomic_fetch_add_explicit(&freeCount, 1, memory_order_relaxed);
+    __real_free(ptr);
+}
+#endif
+
+bool MemTrackEnabled(void) {
+#ifdef GN_MEMTRACK
+    return true;
+#else
+    return false;
+#endif
+}
+
+void MemTrackSnapshot(MemTrackStats *out) {
+    out->allocs = atomic_load_explicit(&allocCount, memory_order_relaxed);
+    out->frees = atomic_load_explicit(&freeCount, memory_order_relaxed);
+    out->bytes = atomic_load_explicit(&allocBytes, memory_order_relaxed);
+    for (int i = 0; i < MEMTRACK_RESOURCE_COUNT; ++i) {
+        out->live[i] = atomic_load_explicit(&liveResources[i], memory_order_relaxed);
+    }
+}
+
+const char *MemTrackResourceName(MemTrackResource resource) {
+    static const char *names[MEMTRACK_RESOURCE_COUNT] = { "images", "textures", "shaders", "audio" };
+    return resource >= 0 && resource < MEMTRACK_RESOURCE_COUNT ? names[resource] : "?";
+}
+
+void MemTrackCountResource(MemTrackResource resource, int delta) {
+    if (resource < 0 || resource >= MEMTRACK_RESOURCE_COUNT) return;
+    atomic_fetch_add_explicit(&liveResources[resource], delta, memory_order_relaxed);
+}
+
+long long MemTrackResidentBytes(void) {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return (long long)counters.WorkingSetSize;
+    return 0;
+#else
+    // /proc/self/statm : taille totale puis pages résidentes
+    FILE *f = fopen("/proc/self/statm", "r");
+    if (!f) return 0;
+    long long total = 0, resident = 0;
+    int n = fscanf(f, "%lld %lld", &total, &resident);
+    fclose(f);
+    return n == 2 ? resident * (long long)sysconf(_SC_PAGESIZE) : 0;
+#endif
+}
@@ -0,0 +1,37 @@
+#ifndef ENGINE_MEMTRACK_H
+#define ENGINE_MEMTRACK_H
+
+#include <stdbool.h>
+
+// Comptage des allocations et des ressources raylib du jeu. Actif seulement
+// si compilé avec GN_MEMTRACK et lié avec -Wl,--wrap=... (exécutable
+// instrumenté du Makefile, cibles "bench" et "soak") ; sinon les compteurs
+// restent à zéro.
+// Seuls les appels et les octets demandés sont comptés : aucun en-tête n'est
+// ajouté aux blocs, une libération par du code non redirigé reste donc sûre.
+
+typedef enum {
+    MEMTRACK_IMAGES = 0,   // Image (mémoire CPU)
+    MEMTRACK_TEXTURES,     // Texture2D et RenderTexture2D
+    MEMTRACK_SHADERS,
+    MEMTRACK_AUDIO,        // Wave, AudioStream, Music
+    MEMTRACK_RESOURCE_COUNT
+} MemTrackResource;
+
+typedef struct {
+    long long allocs;   // malloc, calloc, realloc
+    long long frees;
+    long long bytes;    // octets demandés (cumul)
+    long long live[MEMTRACK_RESOURCE_COUNT]; // ressources chargées et pas encore libérées
+} MemTrackStats;
+
+bool MemTrackEnabled(void);
+void MemTrackSnapshot(MemTrackStats *out);
+const char *MemTrackResourceName(MemTrackResource resource);
+// Mémoire résidente du processus (0 si inconnue sur cette plateforme)
+long long MemTrackResidentBytes(void);
+
+// Appelé par les redirections des fonctions Load / Unload de raylib
+void MemTrackCountResource(MemTrackResource resource, int delta);
+
+#endif // ENGINE_MEMTRACK_H
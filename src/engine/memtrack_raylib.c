@@ -0,0 +1,119 @@
+// Compteurs des ressources raylib (redirection des Load / Unload par l'éditeur
+// de liens, voir TRACK_FLAGS dans Makefile.mingw). Fichier séparé de
+// memtrack.c : raylib.h et windows.h ne cohabitent pas.
+#include "memtrack.h"
+#include "raylib.h"
+
+#ifdef GN_MEMTRACK
+Image __real_LoadImage(const char *fileName);
+Image __real_GenImageColor(int width, int height, Color color);
+void __real_UnloadImage(Image image);
+Texture2D __real_LoadTextureFromImage(Image image);
+void __real_UnloadTexture(Texture2D texture);
+RenderTexture2D __real_LoadRenderTexture(int width, int height);
+void __real_UnloadRenderTexture(RenderTexture2D target);
+Shader __real_LoadShaderFromMemory(const char *vsCode, const char *fsCode);
+void __real_UnloadShader(Shader shader);
+Wave __real_LoadWave(const char *fileName);
+void __real_UnloadWave(Wave wave);
+float *__real_LoadWaveSamples(Wave wave);
+void __real_UnloadWaveSamples(float *samples);
+AudioStream __real_LoadAudioStream(unsigned int sampleRate, unsigned int sampleSize, unsigned int channels);
+void __real_UnloadAudioStream(AudioStream stream);
+Music __real_LoadMusicStream(const char *fileName);
+void __real_UnloadMusicStream(Music music);
+
+// Seules les ressources réellement chargées comptent (un échec ne sera pas libéré)
+Image __wrap_LoadImage(const char *fileName) {
+    Image image = __real_LoadImage(fileName);
+    if (image.data) MemTrackCountResource(MEMTRACK_IMAGES, 1);
+    return image;
+}
+
+Image __wrap_GenImageColor(int width, int height, Color color) {
+    Image image = __real_GenImageColor(width, height, color);
+    if (image.data) MemTrackCountResource(MEMTRACK_IMAGES, 1);
+    return image;
+}
+
+void __wrap_UnloadImage(Image image) {
+    if (image.data) MemTrackCountResource(MEMTRACK_IMAGES, -1);
+    __real_UnloadImage(image);
+}
+
+Texture2D __wrap_LoadTextureFromImage(Image image) {
+    Texture2D texture = __real_LoadTextureFromImage(image);
+    if (texture.id) MemTrackCountResource(MEMTRACK_TEXTURES, 1);
+    return texture;
+}
+
+void __wrap_UnloadTexture(Texture2D texture) {
+    if (texture.id) MemTrackCountResource(MEMTRACK_TEXTURES, -1);
+    __real_UnloadTexture(texture);
+}
+
+RenderTexture2D __wrap_LoadRenderTexture(int width, int height) {
+    RenderTexture2D target = __real_LoadRenderTexture(width, height);
+    if (target.id) MemTrackCountResource(MEMTRACK_TEXTURES, 1);
+    return target;
+}
+
+void __wrap_UnloadRenderTexture(RenderTexture2D target) {
+    if (target.id) MemTrackCountResource(MEMTRACK_TEXTURES, -1);
+    __real_UnloadRenderTexture(target);
+}
+
+Shader __wrap_LoadShaderFromMemory(const char *vsCode, const char *fsCode) {
+    MemTrackCountResource(MEMTRACK_SHADERS, 1);
+    return __real_LoadShaderFromMemory(vsCode, fsCode);
+}
+
+void __wrap_UnloadShader(Shader shader) {
+    MemTrackCountResource(MEMTRACK_SHADERS, -1);
+    __real_UnloadShader(shader);
+}
+
+Wave __wrap_LoadWave(const char *fileName) {
+    Wave wave = __real_LoadWave(fileName);
+    if (wave.data) MemTrackCountResource(MEMTRACK_AUDIO, 1);
+    return wave;
+}
+
+void __wrap_UnloadWave(Wave wave) {
+    if (wave.data) MemTrackCountResource(MEMTRACK_AUDIO, -1);
+    __real_UnloadWave(wave);
+}
+
+float *__wrap_LoadWaveSamples(Wave wave) {
+    float *samples = __real_LoadWaveSamples(wave);
+    if (samples) MemTrackCountResource(MEMTRACK_AUDIO, 1);
+    return samples;
+}
+
+void __wrap_UnloadWaveSamples(float *samples) {
+    if (samples) MemTrackCountResource(MEMTRACK_AUDIO, -1);
+    __real_UnloadWaveSamples(samples);
+}
+
+AudioStream __wrap_LoadAudioStream(unsigned int sampleRate, unsigned int sampleSize, unsigned int channels) {
+    AudioStream stream = __real_LoadAudioStream(sampleRate, sampleSize, channels);
+    if (stream.buffer) MemTrackCountResource(MEMTRACK_AUDIO, 1);
+    return stream;
+}
+
+void __wrap_UnloadAudioStream(AudioStream stream) {
+    if (stream.buffer) MemTrackCountResource(MEMTRACK_AUDIO, -1);
+    __real_UnloadAudioStream(stream);
+}
+
+Music __wrap_LoadMusicStream(const char *fileName) {
+    Music music = __real_LoadMusicStream(fileName);
+    if (music.ctxData) MemTrackCountResource(MEMTRACK_AUDIO, 1);
+    return music;
+}
+
+void __wrap_UnloadMusicStream(Music music) {
+    if (music.ctxData) MemTrackCountResource(MEMTRACK_AUDIO, -1);
+    __real_UnloadMusicStream(music);
+}
+#endif
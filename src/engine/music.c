@@ -0,0 +1,192 @@
+// Musique en streaming : deux platines en fondu enchaîné + un flux préchargé,
+// tous possédés par le thread musique (seul à appeler les fonctions Music de raylib).
+#include "music.h"
+#include "audio.h"
+#include "thread.h"
+#include "trace.h"
+#include "raylib.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#define MUSIC_COMMAND_QUEUE 16       // puissance de 2
+#define MUSIC_STREAM_FRAMES 4096     // taille d'un demi-tampon du flux (~93 ms)
+#define MUSIC_TICK_MS 10
+
+typedef enum { MUSIC_CMD_PLAY = 0, MUSIC_CMD_PREFETCH, MUSIC_CMD_STOP } MusicCommandType;
+
+typedef struct {
+    MusicCommandType type;
+    char path[MUSIC_PATH_LEN];
+    float fade;
+} MusicCommand;
+
+typedef struct {
+    Music music;
+    bool loaded;
+    char path[MUSIC_PATH_LEN];
+    float gain;      // gain de fondu courant 0..1
+    float target;
+    float rate;      // variation de gain par seconde
+} Deck;
+
+// État du thread musique
+static Deck decks[2];
+static int activeDeck;
+static Deck prefetched;
+
+static MusicCommand commands[MUSIC_COMMAND_QUEUE];
+static atomic_uint commandHead;
+static atomic_uint commandTail;
+static atomic_bool running;
+static Thread *musicThread;
+
+static void unloadDeck(Deck *d) {
+    if (d->loaded) {
+        StopMusicStream(d->music);
+        UnloadMusicStream(d->music);
+    }
+    memset(d, 0, sizeof(*d));
+}
+
+static bool openDeck(Deck *d, const char *path) {
+    TRACE_SCOPE("asset.music");
+    memset(d, 0, sizeof(*d));
+    if (!FileExists(path)) return false;
+    d->music = LoadMusicStream(path);
+    if (!IsMusicValid(d->music)) return false;
+    d->music.looping = true;
+    d->loaded = true;
+    snprintf(d->path, sizeof(d->path), "%s", path);
+    return true;
+}
+
+static void handlePlay(const MusicCommand *cmd) {
+    Deck *current = &decks[activeDeck];
+    float rate = cmd->fade > 0.01f ? 1.0f / cmd->fade : 100.0f;
+    if (current->loaded && strcmp(current->path, cmd->path) == 0) {
+        current->target = 1.0f;
+        current->rate = rate;
+        return;
+    }
+
+    int next = 1 - activeDeck;
+    Deck *incoming = &decks[next];
+    if (incoming->loaded && strcmp(incoming->path, cmd->path) == 0) {
+        // Retour vers le morceau en cours de fondu de sortie : on le fait remonter
+        incoming->target = 1.0f;
+        incoming->rate = rate;
+        current->target = 0.0f;
+        current->rate = rate;
+        activeDeck = next;
+        return;
+    }
+    unloadDeck(incoming); // un éventuel fondu de sortie encore en cours est coupé
+    if (prefetched.loaded && strcmp(prefetched.path, cmd->path) == 0) {
+        *incoming = prefetched;
+        memset(&prefetched, 0, sizeof(prefetched));
+    } else {
+        openDeck(incoming, cmd->path);
+    }
+    if (incoming->loaded) {
+        incoming->gain = 0.0f;
+        incoming->target = 1.0f;
+        incoming->rate = rate;
+        SetMusicVolume(incoming->music, 0.0f);
+        PlayMusicStream(incoming->music);
+    }
+    current->target = 0.0f;
+    current->rate = rate;
+    activeDeck = next;
+}
+
+static void handlePrefetch(const MusicCommand *cmd) {
+    if (strcmp(prefetched.path, cmd->path) == 0) return;
+    for (int i = 0; i < 2; ++i) if (decks[i].loaded && strcmp(decks[i].path, cmd->path) == 0) return;
+    unloadDeck(&prefetched);
+    openDeck(&prefetched, cmd->path);
+}
+
+static void musicThreadMain(void *arg) {
+    (void)arg;
+    double last = ThreadNowSeconds();
+    while (atomic_load(&running)) {
+        TRACE_BEGIN("music.tick");
+        unsigned int tail = atomic_load_explicit(&commandTail, memory_order_relaxed);
+        unsigned int head = atomic_load_explicit(&commandHead, memory_order_acquire);
+        while (tail != head) {
+            const MusicCommand *cmd = &commands[tail & (MUSIC_COMMAND_QUEUE - 1)];
+            if (cmd->type == MUSIC_CMD_PLAY) handlePlay(cmd);
+            else if (cmd->type == MUSIC_CMD_PREFETCH) handlePrefetch(cmd);
+            else for (int i = 0; i < 2; ++i) { decks[i].target = 0.0f; decks[i].rate = cmd->fade > 0.01f ? 1.0f / cmd->fade : 100.0f; }
+            tail++;
+        }
+        atomic_store_explicit(&commandTail, tail, memory_order_release);
+
+        double now = ThreadNowSeconds();
+        float dt = (float)(now - last);
+        last = now;
+        float bus = AudioGetMasterVolume() * AudioGetBusVolume(AUDIO_BUS_MUSIC);
+        for (int i = 0; i < 2; ++i) {
+            Deck *d = &decks[i];
+            if (!d->loaded) continue;
+            if (d->gain < d->target) { d->gain += d->rate * dt; if (d->gain > d->target) d->gain = d->target; }
+            else if (d->gain > d->target) { d->gain -= d->rate * dt; if (d->gain < d->target) d->gain = d->target; }
+            if (d->gain <= 0.0f && d->target <= 0.0f) { unloadDeck(d); continue; }
+            SetMusicVolume(d->music, d->gain * bus);
+            // Décodage des blocs consommés vers le tampon circulaire du flux
+            UpdateMusicStream(d->music);
+        }
+        TRACE_END();
+        ThreadSleepMs(MUSIC_TICK_MS);
+    }
+    unloadDeck(&decks[0]);
+    unloadDeck(&decks[1]);
+    unloadDeck(&prefetched);
+}
+
+static void postCommand(MusicCommandType type, const char *path, float fade) {
+    if (!musicThread) return;
+    unsigned int head = atomic_load_explicit(&commandHead, memory_order_relaxed);
+    unsigned int tail = atomic_load_explicit(&commandTail, memory_order_acquire);
+    if (head - tail >= MUSIC_COMMAND_QUEUE) return;
+    MusicCommand *cmd = &commands[head & (MUSIC_COMMAND_QUEUE - 1)];
+    cmd->type = type;
+    cmd->fade = fade;
+    cmd->path[0] = '\0';
+    if (path) strncat(cmd->path, path, MUSIC_PATH_LEN - 1);
+    atomic_store_explicit(&commandHead, head + 1, memory_order_release);
+}
+
+void MusicInit(void) {
+    if (musicThread || !AudioEngineReady()) return;
+    // Petits tampons de flux : la mémoire par morceau reste de l'ordre de quelques dizaines de Ko
+    SetAudioStreamBufferSizeDefault(MUSIC_STREAM_FRAMES);
+    memset(decks, 0, sizeof(decks));
+    memset(&prefetched, 0, sizeof(prefetched));
+    activeDeck = 0;
+    atomic_store(&commandHead, 0);
+    atomic_store(&commandTail, 0);
+    atomic_store(&running, true);
+    musicThread = ThreadCreate(musicThreadMain, NULL, "music");
+}
+
+void MusicShutdown(void) {
+    if (!musicThread) return;
+    atomic_store(&running, false);
+    ThreadJoin(musicThread);
+    musicThread = NULL;
+}
+
+void MusicPlay(const char *path, float fadeSeconds) {
+    if (path) postCommand(MUSIC_CMD_PLAY, path, fadeSeconds);
+}
+
+void MusicPrefetch(const char *path) {
+    if (path) postCommand(MUSIC_CMD_PREFETCH, path, 0.0f);
+}
+
+void MusicStop(float fadeSeconds) {
+    postCommand(MUSIC_CMD_STOP, NULL, fadeSeconds);
+}
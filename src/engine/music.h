@@ -0,0 +1,19 @@
+#ifndef ENGINE_MUSIC_H
+#define ENGINE_MUSIC_H
+
+// Musiques OGG en streaming, décodées sur un thread audio dédié.
+// Le thread principal ne fait que poster des commandes (aucun décodage,
+// aucune E/S fichier) : lecture avec fondu enchaîné et préchargement.
+
+#define MUSIC_PATH_LEN 128
+
+void MusicInit(void);      // après AudioEngineInit()
+void MusicShutdown(void);  // avant AudioEngineShutdown()
+
+// Fondu enchaîné vers path (ne fait rien si ce morceau joue déjà)
+void MusicPlay(const char *path, float fadeSeconds);
+// Ouvre le flux à l'avance (en-têtes et premiers blocs) pour un démarrage sans latence
+void MusicPrefetch(const char *path);
+void MusicStop(float fadeSeconds);
+
+#endif // ENGINE_MUSIC_H
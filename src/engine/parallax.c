@@ -0,0 +1,147 @@
+// Défilement vertical multi-couches en un seul quad (shader de décalage UV)
+#include "parallax.h"
+#include "trace.h"
+#include "rlgl.h"
+#include <math.h>
+#include <string.h>
+
+// Le quad transmet la position écran (px) en coordonnée de texture :
+// chaque couche calcule ses UV à partir de sa zone et de sa tuile.
+static const char *PARALLAX_FS =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "in vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform sampler2D texture1;\n"
+    "uniform sampler2D texture2;\n"
+    "uniform sampler2D texture3;\n"
+    "uniform vec4 colDiffuse;\n"
+    "uniform int layerCount;\n"
+    "uniform vec4 layerArea[4];\n"   // x, y, w, h (px)
+    "uniform vec3 layerTile[4];\n"   // largeur, hauteur de tuile (px), décalage V
+    "out vec4 finalColor;\n"
+    "vec4 sampleLayer(sampler2D tex, int i, vec2 p) {\n"
+    "    vec4 a = layerArea[i];\n"
+    "    if (p.x < a.x || p.y < a.y || p.x >= a.x + a.z || p.y >= a.y + a.w) return vec4(0.0);\n"
+    "    vec2 uv = vec2((p.x - a.x) / layerTile[i].x, (p.y - a.y) / layerTile[i].y - layerTile[i].z);\n"
+    "    return texture(tex, uv);\n"
+    "}\n"
+    "vec4 over(vec4 dst, vec4 src) {\n"
+    "    return vec4(src.rgb * src.a + dst.rgb * (1.0 - src.a), src.a + dst.a * (1.0 - src.a));\n"
+    "}\n"
+    "void main() {\n"
+    "    vec2 p = fragTexCoord;\n"
+    "    vec4 c = vec4(0.0);\n"
+    "    if (layerCount > 0) c = over(c, sampleLayer(texture0, 0, p));\n"
+    "    if (layerCount > 1) c = over(c, sampleLayer(texture1, 1, p));\n"
+    "    if (layerCount > 2) c = over(c, sampleLayer(texture2, 2, p));\n"
+    "    if (layerCount > 3) c = over(c, sampleLayer(texture3, 3, p));\n"
+    "    if (c.a <= 0.0) discard;\n"
+    "    finalColor = vec4(c.rgb / c.a, c.a) * colDiffuse * fragColor;\n"
+    "}\n";
+
+void ParallaxInit(ParallaxPass *pass) {
+    TRACE_SCOPE("asset.shader");
+    memset(pass, 0, sizeof(*pass));
+    pass->shader = LoadShaderFromMemory(NULL, PARALLAX_FS);
+    // En cas d'échec raylib renvoie le shader par défaut : on passe en mode dégradé
+    pass->useShader = pass->shader.id != 0 && pass->shader.id != rlGetShaderIdDefault();
+    if (!pass->useShader) return;
+    pass->locLayerCount = GetShaderLocation(pass->shader, "layerCount");
+    pass->locLayerArea = GetShaderLocation(pass->shader, "layerArea");
+    pass->locLayerTile = GetShaderLocation(pass->shader, "layerTile");
+    pass->locSamplers[0] = -1; // texture0 : texture du quad, liée par le batch
+    pass->locSamplers[1] = GetShaderLocation(pass->shader, "texture1");
+    pass->locSamplers[2] = GetShaderLocation(pass->shader, "texture2");
+    pass->locSamplers[3] = GetShaderLocation(pass->shader, "texture3");
+}
+
+void ParallaxUnload(ParallaxPass *pass) {
+    if (pass->useShader) UnloadShader(pass->shader);
+    memset(pass, 0, sizeof(*pass));
+}
+
+int ParallaxAddLayer(ParallaxPass *pass, Texture2D texture, Rectangle area, float tileWidth, float speed) {
+    if (texture.id == 0 || pass->layerCount >= PARALLAX_MAX_LAYERS) return -1;
+    SetTextureWrap(texture, TEXTURE_WRAP_REPEAT);
+    int i = pass->layerCount++;
+    pass->layers[i] = (ParallaxLayer){ texture, area, tileWidth, speed };
+    return i;
+}
+
+void ParallaxSetLayerArea(ParallaxPass *pass, int layer, Rectangle area, float tileWidth) {
+    if (layer < 0 || layer >= pass->layerCount) return;
+    pass->layers[layer].area = area;
+    pass->layers[layer].tileWidth = tileWidth;
+}
+
+void ParallaxSetLayerTexture(ParallaxPass *pass, int layer, Texture2D texture) {
+    if (layer < 0 || layer >= pass->layerCount || texture.id == 0) return;
+    SetTextureWrap(texture, TEXTURE_WRAP_REPEAT);
+    pass->layers[layer].texture = texture;
+}
+
+static void layerTile(const ParallaxLayer *l, float distance, float *tileW, float *tileH, float *offsetV) {
+    *tileW = l->tileWidth > 0.0f ? l->tileWidth : l->area.width;
+    *tileH = *tileW * (float)l->texture.height / (float)l->texture.width;
+    // Décalage ramené dans [0,1) côté CPU : pas de perte de précision sur les longues parties
+    *offsetV = fmodf(distance * l->speed, *tileH) / *tileH;
+}
+
+void ParallaxDraw(const ParallaxPass *pass, float distance) {
+    if (pass->layerCount == 0) return;
+
+    if (!pass->useShader) {
+        // Mode dégradé : un quad par couche, la répétition vient du wrap de texture
+        for (int i = 0; i < pass->layerCount; ++i) {
+            const ParallaxLayer *l = &pass->layers[i];
+            float tileW, tileH, offsetV;
+            layerTile(l, distance, &tileW, &tileH, &offsetV);
+            Rectangle src = {
+                0.0f,
+                -offsetV * (float)l->texture.height,
+                l->area.width / tileW * (float)l->texture.width,
+                l->area.height / tileH * (float)l->texture.height
+            };
+            DrawTexturePro(l->texture, src, l->area, (Vector2){ 0, 0 }, 0.0f, WHITE);
+        }
+        return;
+    }
+
+    float areas[PARALLAX_MAX_LAYERS * 4] = { 0 };
+    float tiles[PARALLAX_MAX_LAYERS * 3] = { 0 };
+    Rectangle bounds = pass->layers[0].area;
+    for (int i = 0; i < pass->layerCount; ++i) {
+        const ParallaxLayer *l = &pass->layers[i];
+        layerTile(l, distance, &tiles[i*3 + 0], &tiles[i*3 + 1], &tiles[i*3 + 2]);
+        areas[i*4 + 0] = l->area.x;
+        areas[i*4 + 1] = l->area.y;
+        areas[i*4 + 2] = l->area.width;
+        areas[i*4 + 3] = l->area.height;
+        float x0 = fminf(bounds.x, l->area.x);
+        float y0 = fminf(bounds.y, l->area.y);
+        float x1 = fmaxf(bounds.x + bounds.width, l->area.x + l->area.width);
+        float y1 = fmaxf(bounds.y + bounds.height, l->area.y + l->area.height);
+        bounds = (Rectangle){ x0, y0, x1 - x0, y1 - y0 };
+    }
+
+    BeginShaderMode(pass->shader);
+    SetShaderValue(pass->shader, pass->locLayerCount, &pass->layerCount, SHADER_UNIFORM_INT);
+    SetShaderValueV(pass->shader, pass->locLayerArea, areas, SHADER_UNIFORM_VEC4, PARALLAX_MAX_LAYERS);
+    SetShaderValueV(pass->shader, pass->locLayerTile, tiles, SHADER_UNIFORM_VEC3, PARALLAX_MAX_LAYERS);
+    for (int i = 1; i < pass->layerCount; ++i) SetShaderValueTexture(pass->shader, pass->locSamplers[i], pass->layers[i].texture);
+
+    // Un seul quad couvrant l'union des zones ; texcoords = position écran
+    float x0 = bounds.x, y0 = bounds.y;
+    float x1 = bounds.x + bounds.width, y1 = bounds.y + bounds.height;
+    rlSetTexture(pass->layers[0].texture.id);
+    rlBegin(RL_QUADS);
+    rlColor4ub(255, 255, 255, 255);
+    rlTexCoord2f(x0, y0); rlVertex2f(x0, y0);
+    rlTexCoord2f(x0, y1); rlVertex2f(x0, y1);
+    rlTexCoord2f(x1, y1); rlVertex2f(x1, y1);
+    rlTexCoord2f(x1, y0); rlVertex2f(x1, y0);
+    rlEnd();
+    rlSetTexture(0);
+    EndShaderMode();
+}
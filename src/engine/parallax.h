@@ -0,0 +1,42 @@
+#ifndef ENGINE_PARALLAX_H
+#define ENGINE_PARALLAX_H
+
+#include "raylib.h"
+
+// Couches défilantes verticales (route, bas-côtés, décor) composées en une
+// seule passe : un quad, un shader qui décale la coordonnée V de chaque couche.
+// Le coût ne dépend ni de la taille des tuiles ni de la hauteur de l'écran.
+
+#define PARALLAX_MAX_LAYERS 4 // limité par les unités de texture du batch raylib
+
+typedef struct {
+    Texture2D texture;
+    Rectangle area;     // zone écran couverte (px)
+    float tileWidth;    // largeur d'une répétition (px), 0 = largeur de la zone
+    float speed;        // facteur de défilement (1 = vitesse de la route)
+} ParallaxLayer;
+
+typedef struct {
+    Shader shader;
+    bool useShader;     // faux si le shader n'a pas compilé : un quad par couche
+    int locLayerCount;
+    int locLayerArea;
+    int locLayerTile;
+    int locSamplers[PARALLAX_MAX_LAYERS];
+    ParallaxLayer layers[PARALLAX_MAX_LAYERS];
+    int layerCount;
+} ParallaxPass;
+
+void ParallaxInit(ParallaxPass *pass);
+void ParallaxUnload(ParallaxPass *pass);
+
+// Couches composées dans l'ordre d'ajout (la première est au fond)
+int ParallaxAddLayer(ParallaxPass *pass, Texture2D texture, Rectangle area, float tileWidth, float speed);
+void ParallaxSetLayerArea(ParallaxPass *pass, int layer, Rectangle area, float tileWidth);
+// Texture rechargée (nouvel identifiant ou nouvelles dimensions)
+void ParallaxSetLayerTexture(ParallaxPass *pass, int layer, Texture2D texture);
+
+// distance : pixels parcourus (le contenu descend quand elle augmente)
+void ParallaxDraw(const ParallaxPass *pass, float distance);
+
+#endif // ENGINE_PARALLAX_H
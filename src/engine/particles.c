@@ -0,0 +1,292 @@
+// Système de particules : pool fixe en SoA + rendu batché depuis un atlas
+#include "particles.h"
+#include "pipeline.h"
+#include "trace.h"
+#include "rlgl.h"
+#include <math.h>
+#include <string.h>
+
+#define ATLAS_CELL 32
+
+// Stockage SoA : boucles d'intégration simples et vectorisables
+static float pX[PARTICLE_CAPACITY];
+static float pY[PARTICLE_CAPACITY];
+static float pVX[PARTICLE_CAPACITY];
+static float pVY[PARTICLE_CAPACITY];
+static float pAge[PARTICLE_CAPACITY];      // âge normalisé 0..1
+static float pInvLife[PARTICLE_CAPACITY];  // 1 / durée de vie
+static float pDrag[PARTICLE_CAPACITY];
+static float pGravity[PARTICLE_CAPACITY];
+static unsigned char pPreset[PARTICLE_CAPACITY];
+static int aliveCount;
+
+// Ce que le rendu lit : copié par ParticlesPublish dans l'instantané arrière
+// du pipeline, le pool peut ainsi avancer pendant le dessin
+typedef struct {
+    float x[PARTICLE_CAPACITY];
+    float y[PARTICLE_CAPACITY];
+    float age[PARTICLE_CAPACITY];
+    unsigned char preset[PARTICLE_CAPACITY];
+    int count;
+} ParticleSnapshot;
+static ParticleSnapshot snapshots[2];
+
+typedef struct {
+    bool used;
+    bool active;
+    int preset;
+    float rate;
+    float accumulator;
+    Vector2 pos;
+    Vector2 offset;
+    const float *anchorX;
+    const float *anchorY;
+} Emitter;
+
+static ParticlePreset presets[PARTICLE_MAX_PRESETS];
+static int presetCount;
+static Emitter emitters[PARTICLE_MAX_EMITTERS];
+
+static Texture2D atlas;
+static rlRenderBatch batch;
+static bool batchReady;
+static unsigned int rngState = 0x9E3779B9u;
+
+static float randf(void) {
+    // xorshift32 : bien plus rapide que GetRandomValue pour des milliers de tirages
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return (float)(rngState >> 8) * (1.0f / 16777216.0f);
+}
+
+static float randRange(float lo, float hi) {
+    return lo + (hi - lo) * randf();
+}
+
+static unsigned char lerpByte(unsigned char a, unsigned char b, float t) {
+    return (unsigned char)((float)a + ((float)b - (float)a) * t);
+}
+
+static float spriteAlpha(ParticleSprite sprite, float dx, float dy) {
+    float d = sqrtf(dx*dx + dy*dy);
+    switch (sprite) {
+        case PARTICLE_SPRITE_DOT: {
+            float a = 1.0f - d;
+            return a > 0.0f ? a*a : 0.0f;
+        }
+        case PARTICLE_SPRITE_STAR: {
+            // croix fine + halo central
+            float cross = fmaxf(1.0f - fabsf(dx)*6.0f, 0.0f) * fmaxf(1.0f - fabsf(dy), 0.0f)
+                        + fmaxf(1.0f - fabsf(dy)*6.0f, 0.0f) * fmaxf(1.0f - fabsf(dx), 0.0f);
+            float core = fmaxf(1.0f - d*2.5f, 0.0f);
+            return fminf(cross + core, 1.0f);
+        }
+        case PARTICLE_SPRITE_BUBBLE: {
+            float ring = 1.0f - fabsf(d - 0.8f) * 8.0f;
+            float fill = d < 0.8f ? 0.15f : 0.0f;
+            return fminf(fmaxf(ring, 0.0f) + fill, 1.0f);
+        }
+        case PARTICLE_SPRITE_PUFF: {
+            float a = 1.0f - d;
+            return a > 0.0f ? a*0.8f : 0.0f;
+        }
+        default: return 0.0f;
+    }
+}
+
+static Texture2D buildAtlas(void) {
+    TRACE_SCOPE("asset.particles");
+    // Atlas procédural : une cellule blanche par sprite, teintée au rendu
+    const int w = ATLAS_CELL * PARTICLE_SPRITE_COUNT;
+    const int h = ATLAS_CELL;
+    Color *pixels = MemAlloc(w * h * sizeof(Color));
+    if (!pixels) return (Texture2D){0};
+    for (int s = 0; s < PARTICLE_SPRITE_COUNT; ++s) {
+        for (int y = 0; y < h; ++y) {
+            for (int x = 0; x < ATLAS_CELL; ++x) {
+                float dx = ((float)x + 0.5f) / (ATLAS_CELL * 0.5f) - 1.0f;
+                float dy = ((float)y + 0.5f) / (ATLAS_CELL * 0.5f) - 1.0f;
+                float a = spriteAlpha((ParticleSprite)s, dx, dy);
+                pixels[y*w + s*ATLAS_CELL + x] = (Color){ 255, 255, 255, (unsigned char)(a * 255.0f) };
+            }
+        }
+    }
+    Image img = { pixels, w, h, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+    Texture2D tex = LoadTextureFromImage(img);
+    UnloadImage(img);
+    SetTextureFilter(tex, TEXTURE_FILTER_BILINEAR);
+    return tex;
+}
+
+void ParticlesInit(void) {
+    ParticlesClear();
+    atlas = buildAtlas();
+    // Batch dédié dimensionné sur le pool : jamais de flush intermédiaire
+    batch = rlLoadRenderBatch(1, PARTICLE_CAPACITY);
+    batchReady = true;
+}
+
+void ParticlesShutdown(void) {
+    if (atlas.id) UnloadTexture(atlas);
+    atlas = (Texture2D){0};
+    if (batchReady) rlUnloadRenderBatch(batch);
+    batchReady = false;
+    ParticlesClear();
+}
+
+void ParticlesClear(void) {
+    aliveCount = 0;
+    snapshots[0].count = snapshots[1].count = 0;
+    presetCount = 0;
+    memset(emitters, 0, sizeof(emitters));
+}
+
+int ParticlesRegisterPreset(const ParticlePreset *preset) {
+    if (!preset || presetCount >= PARTICLE_MAX_PRESETS) return -1;
+    presets[presetCount] = *preset;
+    return presetCount++;
+}
+
+static void spawn(int preset, Vector2 pos) {
+    if (aliveCount >= PARTICLE_CAPACITY) return; // pool plein : on ignore
+    const ParticlePreset *p = &presets[preset];
+    int i = aliveCount++;
+    float ang = p->angle + randRange(-p->spread, p->spread);
+    float spd = randRange(p->speedMin, p->speedMax);
+    float r = p->jitter * randf();
+    float ra = randf() * 6.2831853f;
+    pX[i] = pos.x + cosf(ra) * r;
+    pY[i] = pos.y + sinf(ra) * r;
+    pVX[i] = cosf(ang) * spd;
+    pVY[i] = sinf(ang) * spd;
+    pAge[i] = 0.0f;
+    float life = randRange(p->lifeMin, p->lifeMax);
+    pInvLife[i] = life > 0.001f ? 1.0f / life : 1000.0f;
+    pDrag[i] = p->drag;
+    pGravity[i] = p->gravity;
+    pPreset[i] = (unsigned char)preset;
+}
+
+void ParticlesBurst(int preset, Vector2 pos, int count) {
+    if (preset < 0 || preset >= presetCount) return;
+    for (int i = 0; i < count; ++i) spawn(preset, pos);
+}
+
+int ParticlesAddEmitter(int preset, float ratePerSecond) {
+    if (preset < 0 || preset >= presetCount) return -1;
+    for (int i = 0; i < PARTICLE_MAX_EMITTERS; ++i) {
+        if (emitters[i].used) continue;
+        emitters[i] = (Emitter){ .used = true, .active = true, .preset = preset, .rate = ratePerSecond };
+        return i;
+    }
+    return -1;
+}
+
+static Emitter *getEmitter(int emitter) {
+    if (emitter < 0 || emitter >= PARTICLE_MAX_EMITTERS || !emitters[emitter].used) return NULL;
+    return &emitters[emitter];
+}
+
+void ParticlesSetEmitterPosition(int emitter, Vector2 pos) {
+    Emitter *e = getEmitter(emitter);
+    if (e) e->pos = pos;
+}
+
+void ParticlesAttachEmitter(int emitter, const float *anchorX, const float *anchorY, Vector2 offset) {
+    Emitter *e = getEmitter(emitter);
+    if (!e) return;
+    e->anchorX = anchorX;
+    e->anchorY = anchorY;
+    e->offset = offset;
+}
+
+void ParticlesSetEmitterActive(int emitter, bool active) {
+    Emitter *e = getEmitter(emitter);
+    if (e) e->active = active;
+}
+
+void ParticlesRemoveEmitter(int emitter) {
+    Emitter *e = getEmitter(emitter);
+    if (e) e->used = false;
+}
+
+void ParticlesUpdate(float dt) {
+    for (int i = 0; i < PARTICLE_MAX_EMITTERS; ++i) {
+        Emitter *e = &emitters[i];
+        if (!e->used || !e->active) continue;
+        if (e->anchorX && e->anchorY) e->pos = (Vector2){ *e->anchorX + e->offset.x, *e->anchorY + e->offset.y };
+        e->accumulator += e->rate * dt;
+        int n = (int)e->accumulator;
+        e->accumulator -= (float)n;
+        for (int k = 0; k < n; ++k) spawn(e->preset, e->pos);
+    }
+
+    // Intégration : boucle sans branchement sur des tableaux contigus
+    const int n = aliveCount;
+    for (int i = 0; i < n; ++i) {
+        float damp = 1.0f - pDrag[i] * dt;
+        pVX[i] *= damp;
+        pVY[i] = pVY[i] * damp + pGravity[i] * dt;
+        pX[i] += pVX[i] * dt;
+        pY[i] += pVY[i] * dt;
+        pAge[i] += pInvLife[i] * dt;
+    }
+
+    // Retrait des particules mortes : échange avec la dernière (pool reste dense)
+    int i = 0;
+    while (i < aliveCount) {
+        if (pAge[i] < 1.0f) { ++i; continue; }
+        int last = --aliveCount;
+        pX[i] = pX[last]; pY[i] = pY[last];
+        pVX[i] = pVX[last]; pVY[i] = pVY[last];
+        pAge[i] = pAge[last]; pInvLife[i] = pInvLife[last];
+        pDrag[i] = pDrag[last]; pGravity[i] = pGravity[last];
+        pPreset[i] = pPreset[last];
+    }
+}
+
+void ParticlesPublish(void) {
+    ParticleSnapshot *s = &snapshots[PipelineBackSlot()];
+    const size_t n = (size_t)aliveCount;
+    memcpy(s->x, pX, n * sizeof(float));
+    memcpy(s->y, pY, n * sizeof(float));
+    memcpy(s->age, pAge, n * sizeof(float));
+    memcpy(s->preset, pPreset, n);
+    s->count = aliveCount;
+}
+
+void ParticlesDraw(void) {
+    const ParticleSnapshot *s = &snapshots[PipelineFrontSlot()];
+    if (s->count == 0 || !batchReady || atlas.id == 0) return;
+    const float cellU = 1.0f / (float)PARTICLE_SPRITE_COUNT;
+
+    // Bascule sur le batch dédié (vide le batch courant pour garder l'ordre de rendu)
+    rlSetRenderBatchActive(&batch);
+    rlSetTexture(atlas.id);
+    rlBegin(RL_QUADS);
+    for (int i = 0; i < s->count; ++i) {
+        const ParticlePreset *p = &presets[s->preset[i]];
+        float t = s->age[i];
+        float x = s->x[i], y = s->y[i];
+        float half = 0.5f * (p->sizeStart + (p->sizeEnd - p->sizeStart) * t);
+        float u0 = (float)p->sprite * cellU;
+        float u1 = u0 + cellU;
+        rlColor4ub(lerpByte(p->colorStart.r, p->colorEnd.r, t),
+                   lerpByte(p->colorStart.g, p->colorEnd.g, t),
+                   lerpByte(p->colorStart.b, p->colorEnd.b, t),
+                   lerpByte(p->colorStart.a, p->colorEnd.a, t));
+        rlTexCoord2f(u0, 0.0f); rlVertex2f(x - half, y - half);
+        rlTexCoord2f(u0, 1.0f); rlVertex2f(x - half, y + half);
+        rlTexCoord2f(u1, 1.0f); rlVertex2f(x + half, y + half);
+        rlTexCoord2f(u1, 0.0f); rlVertex2f(x + half, y - half);
+    }
+    rlEnd();
+    rlSetTexture(0);
+    // Retour au batch par défaut : le pool entier part en un seul draw call
+    rlSetRenderBatchActive(NULL);
+}
+
+int ParticlesAliveCount(void) {
+    return aliveCount;
+}
@@ -0,0 +1,61 @@
+#ifndef ENGINE_PARTICLES_H
+#define ENGINE_PARTICLES_H
+
+#include "raylib.h"
+
+// Système de particules partagé par les mini-jeux.
+// Pool à capacité fixe stocké en SoA (aucune allocation par particule),
+// rendu en un seul draw call depuis un petit atlas généré au démarrage.
+
+#define PARTICLE_CAPACITY 16384
+#define PARTICLE_MAX_PRESETS 16
+#define PARTICLE_MAX_EMITTERS 32
+
+typedef enum {
+    PARTICLE_SPRITE_DOT = 0,  // disque doux
+    PARTICLE_SPRITE_STAR,     // étincelle (pièces)
+    PARTICLE_SPRITE_BUBBLE,   // bulle (anneau)
+    PARTICLE_SPRITE_PUFF,     // bouffée de fumée
+    PARTICLE_SPRITE_COUNT
+} ParticleSprite;
+
+typedef struct {
+    ParticleSprite sprite;
+    float lifeMin, lifeMax;     // durée de vie (s)
+    float speedMin, speedMax;   // vitesse initiale (px/s)
+    float angle, spread;        // direction (radians) et demi-ouverture
+    float sizeStart, sizeEnd;   // taille (px) en début / fin de vie
+    float gravity;              // accélération verticale (px/s^2)
+    float drag;                 // amortissement de la vitesse (1/s)
+    float jitter;               // rayon de dispersion de la position d'émission (px)
+    Color colorStart, colorEnd;
+} ParticlePreset;
+
+// Cycle de vie global (après InitWindow / avant CloseWindow)
+void ParticlesInit(void);
+void ParticlesShutdown(void);
+
+// Vide le pool et détruit tous les émetteurs et presets (changement de mini-jeu)
+void ParticlesClear(void);
+
+// Enregistre un preset, retourne son identifiant (-1 si la table est pleine)
+int ParticlesRegisterPreset(const ParticlePreset *preset);
+
+// Émission ponctuelle (ramassage, collision...)
+void ParticlesBurst(int preset, Vector2 pos, int count);
+
+// Émetteurs continus : position fixe ou attachée à une entité (x/y suivis chaque frame)
+int ParticlesAddEmitter(int preset, float ratePerSecond);
+void ParticlesSetEmitterPosition(int emitter, Vector2 pos);
+void ParticlesAttachEmitter(int emitter, const float *anchorX, const float *anchorY, Vector2 offset);
+void ParticlesSetEmitterActive(int emitter, bool active);
+void ParticlesRemoveEmitter(int emitter);
+
+void ParticlesUpdate(float dt);
+// Copie l'état à dessiner dans l'instantané arrière (voir engine/pipeline.h) ;
+// ParticlesDraw ne dessine que le dernier instantané publié
+void ParticlesPublish(void);
+void ParticlesDraw(void);
+int ParticlesAliveCount(void);
+
+#endif // ENGINE_PARTICLES_H
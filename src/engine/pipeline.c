@@ -0,0 +1,103 @@
+// Pipeline simulation / rendu : un thread de simulation et deux instantanés
+#include "pipeline.h"
+#include "thread.h"
+#include "trace.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+static Thread *simThread;
+static Mutex *lock;
+static CondVar *kickCond, *doneCond;
+static PipelineStep queuedStep;  // protégé par lock
+static float queuedDt;
+static bool stepQueued;          // vrai de PipelineKick à la fin de l'étape
+static bool quit;
+
+// Thread principal uniquement
+static int front;
+static bool primed;              // un instantané a été publié depuis PipelineReset
+static bool kicked;              // une étape tourne sur le thread de simulation
+
+static void simMain(void *arg) {
+    (void)arg;
+    MutexLock(lock);
+    for (;;) {
+        while (!stepQueued && !quit) CondWait(kickCond, lock);
+        if (quit) break;
+        PipelineStep step = queuedStep;
+        float dt = queuedDt;
+        MutexUnlock(lock);
+        TRACE_BEGIN("sim.step");
+        step(dt);
+        TRACE_END();
+        MutexLock(lock);
+        stepQueued = false;
+        CondSignal(doneCond);
+    }
+    MutexUnlock(lock);
+}
+
+void PipelineInit(void) {
+    if (simThread) return;
+    lock = MutexCreate();
+    kickCond = CondCreate();
+    doneCond = CondCreate();
+    quit = false;
+    simThread = ThreadCreate(simMain, NULL, "sim");
+}
+
+void PipelineShutdown(void) {
+    if (!simThread) return;
+    PipelineWait();
+    MutexLock(lock);
+    quit = true;
+    CondSignal(kickCond);
+    MutexUnlock(lock);
+    ThreadJoin(simThread);
+    simThread = NULL;
+    CondDestroy(kickCond);
+    CondDestroy(doneCond);
+    MutexDestroy(lock);
+}
+
+void PipelineRun(PipelineStep step, float dt) {
+    step(dt);
+    front ^= 1;
+    primed = true;
+}
+
+void PipelineKick(PipelineStep step, float dt) {
+    if (!simThread || !primed) {
+        PipelineRun(step, dt); // rien à dessiner en parallèle : étape immédiate
+        return;
+    }
+    MutexLock(lock);
+    queuedStep = step;
+    queuedDt = dt;
+    stepQueued = true;
+    CondSignal(kickCond);
+    MutexUnlock(lock);
+    kicked = true;
+}
+
+void PipelineWait(void) {
+    if (!kicked) return;
+    MutexLock(lock);
+    while (stepQueued) CondWait(doneCond, lock);
+    MutexUnlock(lock);
+    kicked = false;
+    front ^= 1;
+}
+
+void PipelineReset(void) {
+    PipelineWait();
+    primed = false;
+}
+
+int PipelineFrontSlot(void) {
+    return front;
+}
+
+int PipelineBackSlot(void) {
+    return front ^ 1;
+}
@@ -0,0 +1,29 @@
+#ifndef ENGINE_PIPELINE_H
+#define ENGINE_PIPELINE_H
+
+// Pipeline simulation / rendu. L'étape de simulation de l'image N tourne sur
+// un thread dédié pendant que le thread principal (seul autorisé à appeler
+// OpenGL) dessine l'image N-1. Les modules qui y participent écrivent leur état
+// à dessiner dans l'instantané arrière et ne dessinent que l'instantané avant ;
+// les deux sont échangés quand l'étape est terminée.
+
+typedef void (*PipelineStep)(float dt);
+
+void PipelineInit(void);       // démarre le thread de simulation
+void PipelineShutdown(void);
+
+// Exécute l'étape sur le thread appelant puis échange les instantanés
+void PipelineRun(PipelineStep step, float dt);
+// Lance l'étape sur le thread de simulation et retourne aussitôt. Sans
+// instantané encore publié (après PipelineReset), l'étape est exécutée tout de
+// suite, comme PipelineRun.
+void PipelineKick(PipelineStep step, float dt);
+// Attend l'étape lancée par PipelineKick puis échange les instantanés
+void PipelineWait(void);
+// Nouvel état (début d'un mini-jeu) : l'instantané avant n'est plus valide
+void PipelineReset(void);
+
+int PipelineFrontSlot(void);   // instantané à dessiner (0 ou 1)
+int PipelineBackSlot(void);    // instantané en cours d'écriture par l'étape
+
+#endif // ENGINE_PIPELINE_H
@@ -0,0 +1,181 @@
+// Test d'endurance : écarts de mémoire et de ressources imputés à chaque mini-jeu
+#include "soak.h"
+#include "config.h"
+#include "memtrack.h"
+#include "thread.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SOAK_MAX_SUBSYSTEMS 8
+
+typedef struct {
+    long long heap;                            // allocations vivantes
+    long long live[MEMTRACK_RESOURCE_COUNT];
+    long long rss;
+} SoakSample;
+
+typedef struct {
+    char name[32];
+    bool seen;                                 // première visite faite
+    int visits;                                // visites comptées (hors première)
+    SoakSample growth;                         // cumul des écarts
+    SoakSample worst;                          // plus forte hausse sur une visite
+    int growingVisits;                         // visites terminées plus haut que leur début
+} SoakSubsystem;
+
+static SoakOptions options;
+static double startTime;
+static SoakSubsystem subsystems[SOAK_MAX_SUBSYSTEMS];
+static int subsystemCount;
+static int current = -1;                       // sous-système du relevé précédent
+static bool warmup;                            // la visite en cours est la première
+static SoakSample lastSample, firstSample;
+static int cycles;
+static char failure[128];
+
+void SoakParseArgs(SoakOptions *opt, int argc, char **argv) {
+    memset(opt, 0, sizeof(*opt));
+    opt->seconds = 900.0f;
+    opt->visitFrames = 300;
+    opt->reportPath = "soak_report.txt";
+    for (int i = 1; i < argc; ++i) {
+        const char *a = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (strcmp(a, "--soak") == 0) opt->enabled = true;
+        else if (strcmp(a, "--soak-seconds") == 0 && hasValue) opt->seconds = (float)atof(argv[++i]);
+        else if (strcmp(a, "--soak-visit") == 0 && hasValue) opt->visitFrames = atoi(argv[++i]);
+        else if (strcmp(a, "--soak-report") == 0 && hasValue) opt->reportPath = argv[++i];
+    }
+    if (opt->visitFrames < 60) opt->visitFrames = 60;
+}
+
+static void takeSample(SoakSample *s) {
+    MemTrackStats stats;
+    MemTrackSnapshot(&stats);
+    s->heap = stats.allocs - stats.frees;
+    for (int i = 0; i < MEMTRACK_RESOURCE_COUNT; ++i) s->live[i] = stats.live[i];
+    s->rss = MemTrackResidentBytes();
+}
+
+static int findSubsystem(const char *name) {
+    for (int i = 0; i < subsystemCount; ++i) if (strcmp(subsystems[i].name, name) == 0) return i;
+    if (subsystemCount >= SOAK_MAX_SUBSYSTEMS) return -1;
+    SoakSubsystem *s = &subsystems[subsystemCount];
+    memset(s, 0, sizeof(*s));
+    snprintf(s->name, sizeof(s->name), "%s", name);
+    return subsystemCount++;
+}
+
+static long long maxll(long long a, long long b) { return a > b ? a : b; }
+
+// Écart depuis le relevé précédent, imputé au mini-jeu qui vient d'être visité
+static void closeVisit(const SoakSample *now) {
+    if (current < 0) return;
+    cycles++;
+    if (warmup) return;
+    SoakSubsystem *s = &subsystems[current];
+    SoakSample d;
+    d.heap = now->heap - lastSample.heap;
+    d.rss = now->rss - lastSample.rss;
+    bool grew = d.heap > 0 || d.rss > 0;
+    for (int i = 0; i < MEMTRACK_RESOURCE_COUNT; ++i) {
+        d.live[i] = now->live[i] - lastSample.live[i];
+        if (d.live[i] > 0) grew = true;
+        s->growth.live[i] += d.live[i];
+        s->worst.live[i] = maxll(s->worst.live[i], d.live[i]);
+    }
+    s->growth.heap += d.heap;
+    s->growth.rss += d.rss;
+    s->worst.heap = maxll(s->worst.heap, d.heap);
+    s->worst.rss = maxll(s->worst.rss, d.rss);
+    s->visits++;
+    if (grew) s->growingVisits++;
+}
+
+void SoakBegin(const SoakOptions *opt) {
+    options = *opt;
+    startTime = ThreadNowSeconds();
+    subsystemCount = 0;
+    current = -1;
+    cycles = 0;
+    failure[0] = '\0';
+    takeSample(&firstSample);
+    lastSample = firstSample;
+}
+
+void SoakMark(const char *subsystem) {
+    SoakSample now;
+    takeSample(&now);
+    closeVisit(&now);
+    current = findSubsystem(subsystem);
+    // première visite : elle charge les caches conservés d'une partie à l'autre
+    warmup = current >= 0 && !subsystems[current].seen;
+    if (current >= 0) subsystems[current].seen = true;
+    lastSample = now;
+}
+
+bool SoakFinished(void) {
+    return failure[0] != '\0' || ThreadNowSeconds() - startTime >= options.seconds;
+}
+
+void SoakFail(const char *reason) {
+    snprintf(failure, sizeof(failure), "%s", reason);
+}
+
+static void report(FILE *out, const SoakSample *end, long long heapSlack, long long rssSlack, int *leaks) {
+    double elapsed = ThreadNowSeconds() - startTime;
+    fprintf(out, "soak : %.0f s, %d cycles, allocations vivantes %lld -> %lld, RSS %.1f -> %.1f Mo\n",
+            elapsed, cycles, firstSample.heap, end->heap, firstSample.rss / 1048576.0, end->rss / 1048576.0);
+    if (!MemTrackEnabled()) fprintf(out, "(exécutable non instrumenté : seule la RSS est mesurée, voir \"make soak\")\n");
+    fprintf(out, "%-12s %7s %8s", "mini-jeu", "visites", "tas");
+    for (int i = 0; i < MEMTRACK_RESOURCE_COUNT; ++i) fprintf(out, " %9s", MemTrackResourceName((MemTrackResource)i));
+    fprintf(out, " %10s  verdict\n", "RSS (Ko)");
+
+    *leaks = 0;
+    for (int k = 0; k < subsystemCount; ++k) {
+        const SoakSubsystem *s = &subsystems[k];
+        char verdict[96] = "ok";
+        int len = 0;
+        // le tas et la RSS fluctuent un peu ; une ressource raylib de plus est déjà une fuite
+        if (s->growth.heap > heapSlack) len += snprintf(verdict + len, sizeof(verdict) - len, "%s tas", len ? "," : "FUITE :");
+        for (int i = 0; i < MEMTRACK_RESOURCE_COUNT; ++i) {
+            if (s->growth.live[i] > 0 && len < (int)sizeof(verdict)) {
+                len += snprintf(verdict + len, sizeof(verdict) - len, "%s %s", len ? "," : "FUITE :", MemTrackResourceName((MemTrackResource)i));
+            }
+        }
+        if (s->growth.rss > rssSlack && len < (int)sizeof(verdict)) {
+            len += snprintf(verdict + len, sizeof(verdict) - len, "%s RSS", len ? "," : "FUITE :");
+        }
+        if (len) (*leaks)++;
+
+        fprintf(out, "%-12s %7d %+8lld", s->name, s->visits, s->growth.heap);
+        for (int i = 0; i < MEMTRACK_RESOURCE_COUNT; ++i) fprintf(out, " %+9lld", s->growth.live[i]);
+        fprintf(out, " %+10lld  %s\n", s->growth.rss / 1024, verdict);
+        if (len) {
+            fprintf(out, "%-12s %d visite(s) en hausse, pire visite : tas %+lld, RSS %+lld Ko\n", "",
+                    s->growingVisits, s->worst.heap, s->worst.rss / 1024);
+        }
+    }
+    if (failure[0]) fprintf(out, "ÉCHEC : %s\n", failure);
+    fprintf(out, "%s\n", *leaks || failure[0] ? "résultat : ÉCHEC" : "résultat : OK");
+}
+
+int SoakEnd(void) {
+    SoakSample end;
+    takeSample(&end);
+    closeVisit(&end);
+    current = -1;
+
+    // tolérances : [soak] de config/default.ini
+    long long heapSlack = ConfigReadInt("soak", "heap_slack", 32);
+    long long rssSlack = (long long)ConfigReadInt("soak", "rss_slack_kb", 8192) * 1024;
+    int leaks = 0;
+    report(stdout, &end, heapSlack, rssSlack, &leaks);
+    FILE *f = fopen(options.reportPath, "w");
+    if (f) {
+        report(f, &end, heapSlack, rssSlack, &leaks);
+        fclose(f);
+    }
+    return leaks || failure[0] ? 1 : 0;
+}
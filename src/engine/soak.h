@@ -0,0 +1,30 @@
+#ifndef ENGINE_SOAK_H
+#define ENGINE_SOAK_H
+
+#include <stdbool.h>
+
+// Test d'endurance (--soak) : le jeu enchaîne hub -> zone -> mini-jeu -> hub
+// avec des entrées scriptées. Un relevé (allocations vivantes, ressources
+// raylib, mémoire résidente) est pris au hub avant chaque visite ; l'écart
+// jusqu'au relevé suivant est imputé au mini-jeu visité. La première visite
+// de chaque mini-jeu (caches, threads) n'est pas comptée.
+
+typedef struct {
+    bool enabled;
+    float seconds;               // durée totale (900 : "stabilité 15 min")
+    int visitFrames;             // images passées dans chaque mini-jeu
+    const char *reportPath;
+} SoakOptions;
+
+// Reconnaît --soak, --soak-seconds S, --soak-visit N, --soak-report F
+void SoakParseArgs(SoakOptions *opt, int argc, char **argv);
+void SoakBegin(const SoakOptions *opt);
+// Relevé au hub, juste avant d'entrer dans le mini-jeu "subsystem"
+void SoakMark(const char *subsystem);
+bool SoakFinished(void);
+// Enregistre un blocage du script (état inattendu) : le test échoue
+void SoakFail(const char *reason);
+// Dernier relevé, rapport par sous-système ; retourne 1 en cas de fuite
+int SoakEnd(void);
+
+#endif // ENGINE_SOAK_H
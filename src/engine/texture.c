@@ -0,0 +1,61 @@
+// Textures compressées GPU (.dds) avec retour au PNG
+#include "texture.h"
+#include "trace.h"
+#include <string.h>
+#include <sys/stat.h>
+
+bool TextureCompressedPath(const char *path, char *out, int size) {
+    const char *dot = strrchr(path, '.');
+    const char *slash = strrchr(path, '/');
+    if (!dot || (slash && dot < slash)) return false;
+    int stem = (int)(dot - path);
+    if (stem + 5 > size) return false;
+    memcpy(out, path, (size_t)stem);
+    strcpy(out + stem, ".dds");
+    return true;
+}
+
+// Un .dds plus ancien que son PNG est périmé (image retouchée depuis la conversion)
+static bool compressedIsFresh(const char *compressed, const char *source) {
+    struct stat c, s;
+    if (stat(compressed, &c) != 0) return false;
+    if (stat(source, &s) != 0) return true;
+    return c.st_mtime >= s.st_mtime;
+}
+
+Image TextureDecode(const char *path) {
+    TRACE_SCOPE("asset.decode");
+    char compressed[TEXTURE_PATH_LEN];
+    if (TextureCompressedPath(path, compressed, sizeof(compressed)) && compressedIsFresh(compressed, path)) {
+        Image image = LoadImage(compressed);
+        if (image.data) return image;
+    }
+    return LoadImage(path);
+}
+
+Texture2D TextureUpload(Image *image, const char *path) {
+    TRACE_SCOPE("asset.texture");
+    Texture2D texture = {0};
+    if (!image->data) return texture;
+    if (image->format >= PIXELFORMAT_COMPRESSED_DXT1_RGB) {
+        // Mips comprises ; refusée (id 0) si le GPU ne gère pas le format
+        texture = LoadTextureFromImage(*image);
+        if (texture.id == 0) {
+            UnloadImage(*image);
+            *image = LoadImage(path);
+        }
+    }
+    if (texture.id == 0 && image->data) {
+        texture = LoadTextureFromImage(*image);
+        if (texture.id != 0) GenTextureMipmaps(&texture);
+    }
+    if (texture.mipmaps > 1) SetTextureFilter(texture, TEXTURE_FILTER_TRILINEAR);
+    if (image->data) UnloadImage(*image);
+    *image = (Image){0};
+    return texture;
+}
+
+Texture2D TextureLoad(const char *path) {
+    Image image = TextureDecode(path);
+    return TextureUpload(&image, path);
+}
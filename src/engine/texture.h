@@ -0,0 +1,23 @@
+#ifndef ENGINE_TEXTURE_H
+#define ENGINE_TEXTURE_H
+
+#include "raylib.h"
+
+// Chargement des grandes textures (fonds, route, décor).
+// Si tools/texconv a produit une variante compressée GPU (x.png -> x.dds,
+// BC1 opaque ou BC3 avec alpha, chaîne de mips précalculée) et qu'elle n'est
+// pas plus ancienne que le PNG, elle est envoyée telle quelle : 4 à 8 fois
+// moins de mémoire vidéo qu'en RGBA et pas de conversion à l'envoi. Sinon (pas
+// de .dds, PNG modifié depuis, GPU sans DXT), le PNG est envoyé décompressé et
+// ses mips sont générées par le GPU.
+
+#define TEXTURE_PATH_LEN 256
+
+// Chemin de la variante compressée ; faux si le chemin n'a pas d'extension
+bool TextureCompressedPath(const char *path, char *out, int size);
+
+Image TextureDecode(const char *path);                    // tout thread
+Texture2D TextureUpload(Image *image, const char *path);  // thread principal ; libère l'image
+Texture2D TextureLoad(const char *path);
+
+#endif // ENGINE_TEXTURE_H
@@ -0,0 +1,147 @@
+// Threads, verrous et variables de condition (pthreads)
+// Ce fichier n'inclut pas raylib.h : il peut inclure les en-têtes système.
+#include "thread.h"
+#include "trace.h"
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+struct Thread {
+    pthread_t handle;
+    ThreadFunc fn;
+    void *arg;
+    const char *name;
+};
+
+struct Mutex {
+    pthread_mutex_t handle;
+};
+
+struct CondVar {
+    pthread_cond_t handle;
+};
+
+static void *threadEntry(void *p) {
+    Thread *t = (Thread *)p;
+    TraceThreadStart(t->name); // nom du thread dans les traces (tampon attribué au premier événement)
+    t->fn(t->arg);
+    TraceThreadExit();
+    return NULL;
+}
+
+Thread *ThreadCreate(ThreadFunc fn, void *arg, const char *name) {
+    Thread *t = malloc(sizeof(Thread));
+    if (!t) return NULL;
+    t->fn = fn;
+    t->arg = arg;
+    t->name = name;
+    if (pthread_create(&t->handle, NULL, threadEntry, t) != 0) {
+        free(t);
+        return NULL;
+    }
+#if defined(__linux__) && defined(_GNU_SOURCE)
+    if (name) pthread_setname_np(t->handle, name);
+#else
+    (void)name;
+#endif
+    return t;
+}
+
+void ThreadJoin(Thread *thread) {
+    if (!thread) return;
+    pthread_join(thread->handle, NULL);
+    free(thread);
+}
+
+Mutex *MutexCreate(void) {
+    Mutex *m = malloc(sizeof(Mutex));
+    if (m) pthread_mutex_init(&m->handle, NULL);
+    return m;
+}
+
+void MutexDestroy(Mutex *mutex) {
+    if (!mutex) return;
+    pthread_mutex_destroy(&mutex->handle);
+    free(mutex);
+}
+
+void MutexLock(Mutex *mutex) {
+    pthread_mutex_lock(&mutex->handle);
+}
+
+void MutexUnlock(Mutex *mutex) {
+    pthread_mutex_unlock(&mutex->handle);
+}
+
+CondVar *CondCreate(void) {
+    CondVar *c = malloc(sizeof(CondVar));
+    if (c) pthread_cond_init(&c->handle, NULL);
+    return c;
+}
+
+void CondDestroy(CondVar *cond) {
+    if (!cond) return;
+    pthread_cond_destroy(&cond->handle);
+    free(cond);
+}
+
+void CondWait(CondVar *cond, Mutex *mutex) {
+    pthread_cond_wait(&cond->handle, &mutex->handle);
+}
+
+bool CondWaitTimeout(CondVar *cond, Mutex *mutex, int milliseconds) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    ts.tv_sec += milliseconds / 1000;
+    ts.tv_nsec += (long)(milliseconds % 1000) * 1000000L;
+    if (ts.tv_nsec >= 1000000000L) { ts.tv_sec += 1; ts.tv_nsec -= 1000000000L; }
+    return pthread_cond_timedwait(&cond->handle, &mutex->handle, &ts) != ETIMEDOUT;
+}
+
+void CondSignal(CondVar *cond) {
+    pthread_cond_signal(&cond->handle);
+}
+
+void CondBroadcast(CondVar *cond) {
+    pthread_cond_broadcast(&cond->handle);
+}
+
+void ThreadSleepMs(int milliseconds) {
+#ifdef _WIN32
+    Sleep((DWORD)milliseconds);
+#else
+    struct timespec ts = { milliseconds / 1000, (long)(milliseconds % 1000) * 1000000L };
+    nanosleep(&ts, NULL);
+#endif
+}
+
+double ThreadNowSeconds(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER now;
+    if (freq.QuadPart == 0) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    return (double)now.QuadPart / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif
+}
+
+int ThreadHardwareConcurrency(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+#endif
+}
@@ -0,0 +1,36 @@
+#ifndef ENGINE_THREAD_H
+#define ENGINE_THREAD_H
+
+#include <stdbool.h>
+
+// Couche de threads minimale (pthreads, winpthreads sous MinGW).
+// Types opaques : aucun en-tête système n'est exposé aux fichiers qui
+// incluent raylib.h (conflits connus avec windows.h).
+
+typedef struct Thread Thread;
+typedef struct Mutex Mutex;
+typedef struct CondVar CondVar;
+typedef void (*ThreadFunc)(void *arg);
+
+// name : nom court pour le débogage (peut être NULL)
+Thread *ThreadCreate(ThreadFunc fn, void *arg, const char *name);
+void ThreadJoin(Thread *thread);
+
+Mutex *MutexCreate(void);
+void MutexDestroy(Mutex *mutex);
+void MutexLock(Mutex *mutex);
+void MutexUnlock(Mutex *mutex);
+
+CondVar *CondCreate(void);
+void CondDestroy(CondVar *cond);
+void CondWait(CondVar *cond, Mutex *mutex);
+// Retourne faux si le délai a expiré
+bool CondWaitTimeout(CondVar *cond, Mutex *mutex, int milliseconds);
+void CondSignal(CondVar *cond);
+void CondBroadcast(CondVar *cond);
+
+void ThreadSleepMs(int milliseconds);
+double ThreadNowSeconds(void);      // horloge monotone, utilisable hors du thread principal
+int ThreadHardwareConcurrency(void);
+
+#endif // ENGINE_THREAD_H
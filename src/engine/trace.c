@@ -0,0 +1,172 @@
+// Capture de traces : tampons circulaires par thread, export JSON Chrome
+#include "trace.h"
+#include "thread.h"
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TRACE_MAX_THREADS 32
+#define TRACE_EVENTS 65536        // par thread (puissance de 2), ~1,5 Mo
+#define TRACE_DEPTH 32            // zones imbriquées
+#define TRACE_READ_MARGIN 1024    // zone du tampon possiblement réécrite pendant l'export
+
+typedef struct {
+    const char *name;
+    double start;                 // secondes (ThreadNowSeconds)
+    double duration;
+} TraceEvent;
+
+typedef struct {
+    TraceEvent *events;
+    atomic_uint_fast64_t written; // événements écrits depuis l'attribution du tampon
+    const char *stack[TRACE_DEPTH];
+    double stackStart[TRACE_DEPTH];
+    int depth;
+    char name[32];
+    int tid;
+    bool inUse;                   // attribué à un thread vivant
+    double lastEnd;               // fin du dernier événement écrit
+} TraceBuffer;
+
+static TraceBuffer buffers[TRACE_MAX_THREADS];
+static int bufferCount;
+static int nextTid = 1;
+static Mutex *registryLock;
+static atomic_bool active;
+static float windowSeconds;
+static double origin;
+
+static _Thread_local TraceBuffer *local;
+static _Thread_local bool workerThread;     // lancé par ThreadCreate
+static _Thread_local const char *threadName;
+
+void TraceStart(float seconds) {
+    if (atomic_load(&active)) return;
+    registryLock = MutexCreate();
+    windowSeconds = seconds > 0.0f ? seconds : 10.0f;
+    origin = ThreadNowSeconds();
+    atomic_store(&active, registryLock != NULL);
+}
+
+bool TraceActive(void) {
+    return atomic_load_explicit(&active, memory_order_relaxed);
+}
+
+// Un tampon libéré n'est réattribué qu'une fois ses événements sortis de la fenêtre
+static TraceBuffer *acquireBuffer(void) {
+    double now = ThreadNowSeconds();
+    TraceBuffer *b = NULL;
+    MutexLock(registryLock);
+    for (int i = 0; i < bufferCount && !b; ++i) {
+        if (!buffers[i].inUse && buffers[i].lastEnd < now - windowSeconds) b = &buffers[i];
+    }
+    if (!b && bufferCount < TRACE_MAX_THREADS) {
+        TraceEvent *events = malloc(sizeof(TraceEvent) * TRACE_EVENTS);
+        if (events) {
+            b = &buffers[bufferCount++];
+            b->events = events;
+        }
+    }
+    if (b) {
+        atomic_store(&b->written, 0);
+        b->depth = 0;
+        b->lastEnd = 0.0;
+        b->tid = nextTid++;
+        b->inUse = true;
+        snprintf(b->name, sizeof(b->name), "%s", workerThread ? (threadName ? threadName : "worker") : "main");
+    }
+    MutexUnlock(registryLock);
+    return b;
+}
+
+void TraceBegin(const char *name) {
+    if (!TraceActive()) return;
+    if (!local && !(local = acquireBuffer())) return;
+    if (local->depth < TRACE_DEPTH) {
+        local->stack[local->depth] = name;
+        local->stackStart[local->depth] = ThreadNowSeconds();
+    }
+    local->depth++;
+}
+
+void TraceEnd(void) {
+    if (!TraceActive() || !local || local->depth == 0) return;
+    int d = --local->depth;
+    if (d >= TRACE_DEPTH) return;
+    double end = ThreadNowSeconds();
+    uint_fast64_t n = atomic_load_explicit(&local->written, memory_order_relaxed);
+    TraceEvent *e = &local->events[n & (TRACE_EVENTS - 1)];
+    e->name = local->stack[d];
+    e->start = local->stackStart[d];
+    e->duration = end - e->start;
+    local->lastEnd = end;
+    atomic_store_explicit(&local->written, n + 1, memory_order_release);
+}
+
+TraceScope TraceScopeBegin(const char *name) {
+    TraceBegin(name);
+    return 0;
+}
+
+void TraceScopeEnd(TraceScope *scope) {
+    (void)scope;
+    TraceEnd();
+}
+
+void TraceThreadStart(const char *name) {
+    workerThread = true;
+    threadName = name;
+}
+
+void TraceThreadExit(void) {
+    if (!local) return;
+    MutexLock(registryLock);
+    local->inUse = false;
+    MutexUnlock(registryLock);
+    local = NULL;
+}
+
+bool TraceWrite(const char *path) {
+    if (!TraceActive()) return false;
+    FILE *f = fopen(path, "w");
+    if (!f) return false;
+    double cutoff = ThreadNowSeconds() - windowSeconds;
+    int count = 0;
+    fprintf(f, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+    fprintf(f, "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"args\": {\"name\": \"Gros Nounours 2D\"}}");
+    MutexLock(registryLock); // aucun tampon n'est réattribué pendant l'export
+    for (int i = 0; i < bufferCount; ++i) {
+        TraceBuffer *b = &buffers[i];
+        uint_fast64_t written = atomic_load_explicit(&b->written, memory_order_acquire);
+        if (written == 0) continue;
+        fprintf(f, ",\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %d, \"args\": {\"name\": \"%s\"}}", b->tid, b->name);
+        uint_fast64_t first = written > TRACE_EVENTS - TRACE_READ_MARGIN ? written - (TRACE_EVENTS - TRACE_READ_MARGIN) : 0;
+        for (uint_fast64_t n = first; n < written; ++n) {
+            const TraceEvent *e = &b->events[n & (TRACE_EVENTS - 1)];
+            if (e->start + e->duration < cutoff) continue;
+            fprintf(f, ",\n{\"name\": \"%s\", \"ph\": \"X\", \"pid\": 1, \"tid\": %d, \"ts\": %.3f, \"dur\": %.3f}",
+                    e->name, b->tid, (e->start - origin) * 1e6, e->duration * 1e6);
+            count++;
+        }
+    }
+    MutexUnlock(registryLock);
+    fprintf(f, "\n]}\n");
+    fclose(f);
+    fprintf(stderr, "trace : %d événements (%.0f s) -> %s\n", count, windowSeconds, path);
+    return true;
+}
+
+// Les threads de travail doivent être arrêtés : leurs tampons sont libérés
+void TraceShutdown(void) {
+    if (!atomic_exchange(&active, false)) return;
+    for (int i = 0; i < bufferCount; ++i) {
+        free(buffers[i].events);
+        memset(&buffers[i], 0, sizeof(buffers[i]));
+    }
+    bufferCount = 0;
+    local = NULL;
+    MutexDestroy(registryLock);
+    registryLock = NULL;
+}
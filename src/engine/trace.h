@@ -0,0 +1,44 @@
+#ifndef ENGINE_TRACE_H
+#define ENGINE_TRACE_H
+
+#include <stdbool.h>
+
+// Traces d'exécution au format Chrome / Perfetto (chrome://tracing, ui.perfetto.dev).
+// Les macros ne coûtent rien sans GN_TRACE (TRACE=0 dans Makefile.mingw) et un
+// simple test tant que la capture n'est pas lancée (--trace). Chaque thread
+// écrit dans son propre tampon circulaire : pas de verrou sur le chemin chaud.
+// Les noms passés aux macros doivent rester valides (littéraux).
+
+#ifdef GN_TRACE
+#define TRACE_BEGIN(name) TraceBegin(name)
+#define TRACE_END() TraceEnd()
+// Zone fermée automatiquement en sortie de bloc (attribut cleanup de GCC)
+#define TRACE_SCOPE(name) \
+    TraceScope TRACE_JOIN(traceScope, __LINE__) __attribute__((cleanup(TraceScopeEnd))) = TraceScopeBegin(name)
+#define TRACE_JOIN(a, b) TRACE_JOIN2(a, b)
+#define TRACE_JOIN2(a, b) a##b
+#else
+#define TRACE_BEGIN(name) ((void)0)
+#define TRACE_END() ((void)0)
+#define TRACE_SCOPE(name) ((void)0)
+#endif
+
+typedef int TraceScope;
+
+// seconds : durée conservée et écrite (les dernières secondes)
+void TraceStart(float seconds);
+bool TraceActive(void);
+// Écrit les "seconds" dernières secondes de tous les threads ; la capture continue
+bool TraceWrite(const char *path);
+void TraceShutdown(void);
+
+void TraceBegin(const char *name);
+void TraceEnd(void);
+TraceScope TraceScopeBegin(const char *name);
+void TraceScopeEnd(TraceScope *scope);
+
+// Appelés par engine/thread.c au début et à la fin de chaque thread
+void TraceThreadStart(const char *name);
+void TraceThreadExit(void);
+
+#endif // ENGINE_TRACE_H
@@ -0,0 +1,156 @@
+// Interface en un seul lot : boîtes SDF et texte de la police par défaut
+#include "ui_batch.h"
+#include "trace.h"
+#include "rlgl.h"
+#include <math.h>
+#include <stddef.h>
+
+// Un quad de boîte porte en coordonnée de texture sa position locale (px)
+// décalée de (indice + 1) * UI_SLOT_STRIDE ; les glyphes gardent leurs UV
+// dans [0,1] (tranche 0) et échantillonnent simplement la police.
+#define UI_SLOT_STRIDE 8192.0f
+
+static const char *UI_BATCH_FS =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "in vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec4 colDiffuse;\n"
+    "uniform vec4 boxGeom[32];\n"    // centre (repère du quad, px), demi-taille
+    "uniform vec4 boxStyle[32];\n"   // rayon, bordure, étendue de l'effet, décalage Y de l'effet
+    "uniform vec4 boxBorder[32];\n"
+    "uniform vec4 boxEffect[32];\n"
+    "out vec4 finalColor;\n"
+    "float roundBox(vec2 p, vec2 halfSize, float r) {\n"
+    "    vec2 q = abs(p) - halfSize + r;\n"
+    "    return length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - r;\n"
+    "}\n"
+    "vec4 over(vec4 dst, vec4 src) {\n"
+    "    return vec4(src.rgb * src.a + dst.rgb * (1.0 - src.a), src.a + dst.a * (1.0 - src.a));\n"
+    "}\n"
+    "void main() {\n"
+    "    float slot = floor(fragTexCoord.x / 8192.0);\n"
+    "    if (slot < 1.0) {\n"
+    "        finalColor = texture(texture0, fragTexCoord) * colDiffuse * fragColor;\n"
+    "        return;\n"
+    "    }\n"
+    "    int i = int(slot) - 1;\n"
+    "    vec2 p = vec2(fragTexCoord.x - slot * 8192.0, fragTexCoord.y) - boxGeom[i].xy;\n"
+    "    vec4 s = boxStyle[i];\n"
+    "    float d = roundBox(p, boxGeom[i].zw, s.x);\n"
+    "    float aa = max(fwidth(d), 0.0001);\n"   // un pixel écran, y compris en HiDPI
+    "    float inside = clamp(0.5 - d / aa, 0.0, 1.0);\n"
+    "    float band = s.y > 0.0 ? inside - clamp(0.5 - (d + s.y) / aa, 0.0, 1.0) : 0.0;\n"
+    "    float e = 0.0;\n"
+    "    if (s.z > 0.0) {\n"
+    "        float de = roundBox(p - vec2(0.0, s.w), boxGeom[i].zw, s.x);\n"
+    "        e = (1.0 - smoothstep(0.0, s.z, de)) * (1.0 - inside);\n"
+    "    }\n"
+    "    vec4 c = vec4(boxEffect[i].rgb, boxEffect[i].a * e);\n"
+    "    c = over(c, vec4(fragColor.rgb, fragColor.a * inside));\n"
+    "    c = over(c, vec4(boxBorder[i].rgb, boxBorder[i].a * band));\n"
+    "    if (c.a <= 0.0) discard;\n"
+    "    finalColor = vec4(c.rgb / c.a, c.a) * colDiffuse;\n"
+    "}\n";
+
+static Shader shader;
+static bool useShader;   // faux si le shader n'a pas compilé : formes raylib classiques
+static int locGeom, locStyle, locBorder, locEffect;
+static float boxGeom[UI_BATCH_MAX_BOXES * 4];
+static float boxStyle[UI_BATCH_MAX_BOXES * 4];
+static float boxBorder[UI_BATCH_MAX_BOXES * 4];
+static float boxEffect[UI_BATCH_MAX_BOXES * 4];
+static int boxCount;
+
+void UiBatchInit(void) {
+    TRACE_SCOPE("asset.shader");
+    shader = LoadShaderFromMemory(NULL, UI_BATCH_FS);
+    useShader = shader.id != 0 && shader.id != rlGetShaderIdDefault();
+    if (!useShader) return;
+    locGeom = GetShaderLocation(shader, "boxGeom");
+    locStyle = GetShaderLocation(shader, "boxStyle");
+    locBorder = GetShaderLocation(shader, "boxBorder");
+    locEffect = GetShaderLocation(shader, "boxEffect");
+}
+
+void UiBatchShutdown(void) {
+    if (useShader) UnloadShader(shader);
+    useShader = false;
+}
+
+void UiBatchBegin(void) {
+    boxCount = 0;
+    if (useShader) BeginShaderMode(shader);
+}
+
+void UiBatchEnd(void) {
+    if (useShader) EndShaderMode(); // vide le lot : boîtes et texte partent ensemble
+}
+
+static void storeColor(float *dst, Color c) {
+    dst[0] = c.r / 255.0f;
+    dst[1] = c.g / 255.0f;
+    dst[2] = c.b / 255.0f;
+    dst[3] = c.a / 255.0f;
+}
+
+// Mode dégradé : mêmes formes, tessellées par raylib
+static void drawBoxFallback(Rectangle rect, const UiBox *box) {
+    float half = fminf(rect.width, rect.height) * 0.5f;
+    float roundness = half > 0.0f ? fminf(box->radius / half, 1.0f) : 0.0f;
+    if (box->effectSize > 0.0f && box->effectOffsetY != 0.0f) {
+        Rectangle shadow = { rect.x, rect.y + box->effectOffsetY, rect.width, rect.height };
+        DrawRectangleRounded(shadow, roundness, 6, box->effect);
+    }
+    DrawRectangleRounded(rect, roundness, 6, box->fill);
+    if (box->borderWidth > 0.0f) DrawRectangleRoundedLinesEx(rect, roundness, 6, box->borderWidth, box->border);
+}
+
+void UiBatchBox(Rectangle rect, const UiBox *box) {
+    if (rect.width <= 0.0f || rect.height <= 0.0f) return;
+    if (!useShader) {
+        drawBoxFallback(rect, box);
+        return;
+    }
+    if (boxCount == UI_BATCH_MAX_BOXES) {
+        rlDrawRenderBatchActive(); // tableau d'uniformes plein : on vide et on repart
+        boxCount = 0;
+    }
+
+    // Le quad couvre la boîte et son ombre / halo
+    float margin = box->effectSize + 1.0f;
+    float x0 = rect.x - margin;
+    float y0 = rect.y - margin + fminf(box->effectOffsetY, 0.0f);
+    float x1 = rect.x + rect.width + margin;
+    float y1 = rect.y + rect.height + margin + fmaxf(box->effectOffsetY, 0.0f);
+
+    int i = boxCount++;
+    boxGeom[i*4 + 0] = rect.x + rect.width * 0.5f - x0;
+    boxGeom[i*4 + 1] = rect.y + rect.height * 0.5f - y0;
+    boxGeom[i*4 + 2] = rect.width * 0.5f;
+    boxGeom[i*4 + 3] = rect.height * 0.5f;
+    boxStyle[i*4 + 0] = fminf(box->radius, fminf(rect.width, rect.height) * 0.5f);
+    boxStyle[i*4 + 1] = box->borderWidth;
+    boxStyle[i*4 + 2] = box->effectSize;
+    boxStyle[i*4 + 3] = box->effectOffsetY;
+    storeColor(&boxBorder[i*4], box->border);
+    storeColor(&boxEffect[i*4], box->effect);
+    // Envoyés à chaque boîte : le lot peut être vidé à tout moment (lot plein, texte)
+    SetShaderValueV(shader, locGeom, boxGeom, SHADER_UNIFORM_VEC4, boxCount);
+    SetShaderValueV(shader, locStyle, boxStyle, SHADER_UNIFORM_VEC4, boxCount);
+    SetShaderValueV(shader, locBorder, boxBorder, SHADER_UNIFORM_VEC4, boxCount);
+    SetShaderValueV(shader, locEffect, boxEffect, SHADER_UNIFORM_VEC4, boxCount);
+
+    // Même texture que le texte : pas de changement d'état dans le lot
+    float base = (float)(i + 1) * UI_SLOT_STRIDE;
+    rlCheckRenderBatchLimit(4);
+    rlSetTexture(GetFontDefault().texture.id);
+    rlBegin(RL_QUADS);
+    rlColor4ub(box->fill.r, box->fill.g, box->fill.b, box->fill.a);
+    rlTexCoord2f(base, 0.0f);              rlVertex2f(x0, y0);
+    rlTexCoord2f(base, y1 - y0);           rlVertex2f(x0, y1);
+    rlTexCoord2f(base + x1 - x0, y1 - y0); rlVertex2f(x1, y1);
+    rlTexCoord2f(base + x1 - x0, 0.0f);    rlVertex2f(x1, y0);
+    rlEnd();
+    rlSetTexture(0);
+}
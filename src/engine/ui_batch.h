@@ -0,0 +1,31 @@
+#ifndef ENGINE_UI_BATCH_H
+#define ENGINE_UI_BATCH_H
+
+#include "raylib.h"
+
+// Interface en un seul appel de dessin : panneaux arrondis, bordures, ombres
+// et halos sont des quads évalués par distance signée dans un shader, qui
+// échantillonne aussi la police par défaut. Les DrawText (police par défaut)
+// placés entre UiBatchBegin et UiBatchEnd restent donc dans le même lot.
+// Les formes sont calculées par pixel : nettes quelle que soit la résolution.
+
+#define UI_BATCH_MAX_BOXES 32 // par lot ; au-delà le lot est vidé et repart
+
+typedef struct {
+    float radius;          // rayon des coins (px)
+    Color fill;
+    float borderWidth;     // px, 0 : pas de bordure (tracée vers l'intérieur)
+    Color border;
+    float effectSize;      // étendue de l'ombre / du halo (px), 0 : aucun
+    float effectOffsetY;   // décalage vers le bas : ombre portée ; 0 : halo
+    Color effect;
+} UiBox;
+
+void UiBatchInit(void);     // après InitWindow
+void UiBatchShutdown(void);
+
+void UiBatchBegin(void);
+void UiBatchBox(Rectangle rect, const UiBox *box);
+void UiBatchEnd(void);
+
+#endif // ENGINE_UI_BATCH_H
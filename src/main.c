@@ -2,11 +2,26 @@
 #include "raylib.h"
 #include <math.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include "minigames/minigame.h"
+#include "engine/audio.h"
+#include "engine/bench.h"
+#include "engine/config.h"
+#include "engine/hotreload.h"
+#include "engine/input.h"
+#include "engine/jobs.h"
+#include "engine/music.h"
+#include "engine/particles.h"
+#include "engine/pipeline.h"
+#include "engine/soak.h"
+#include "engine/texture.h"
+#include "engine/trace.h"
+#include "engine/ui_batch.h"
 #include "minigames/pousse_pousse/pousse_pousse.h"
 #include "minigames/traffic/traffic.h"
 #include "minigames/gateau/gateau.h"
+#include "bench_scenarios.h"
 
 typedef enum {
     STATE_TITLE = 0,
@@ -64,6 +79,8 @@ typedef struct {
     bool hasMenuBackground;
     bool hasMenuBear;
     bool showDebugOverlay;
+    bool lateLatch;             // entrées relevées juste avant le dessin (F3)
+    bool pipelined;             // simulation du mini-jeu pendant le dessin ([video] pipeline)
     int draggingPortal;
     bool draggingBear;
     Vector2 dragOffset;
@@ -90,9 +107,21 @@ static const RectRatios DEFAULT_PORTAL_LAYOUTS[ZONE_COUNT] = {
     { 0.565f, 0.25f, 0.11f, 0.30f }
 };
 
+// Musiques (une par mini-jeu + hub), en fondu enchaîné lors des changements d'état
+static const char *HUB_MUSIC = "assets/music/hub.ogg";
+static const char *ZONE_MUSIC[ZONE_COUNT] = {
+    "assets/music/pousse_pousse.ogg",  // Jardin
+    "assets/music/gateau.ogg",         // Chambre
+    "assets/music/traffic.ogg",        // Grenier
+    "assets/music/pousse_pousse.ogg"   // Cuisine (mini-jeu par défaut)
+};
+static const float MUSIC_FADE = 1.2f;
+
 static const BearLayout DEFAULT_BEAR_LAYOUT = { 0.021f, 0.113f, 0.85f };
 static const char *PORTAL_KEYS[ZONE_COUNT] = { "jardin", "chambre", "grenier", "cuisine" };
 static const char *LAYOUT_FILE = "config/menu_layout.ini";
+static const char *tracePath = "trace.json"; // --trace-out
+static float lateLatchMargin = 0.003f;         // [input] late_latch_margin_ms
 
 static float clampf(float v, float lo, float hi) {
     return v < lo ? lo : (v > hi ? hi : v);
@@ -118,14 +147,17 @@ static void drawGround(void) {
     DrawRectangle(0, 460, GetScreenWidth(), 20, (Color){ 90, 60, 40, 255 });
 }
 
-static Texture2D loadTextureIfAvailable(const char *path) {
-    Texture2D tex = {0};
-    Image img = LoadImage(path);
-    if (img.data) {
-        tex = LoadTextureFromImage(img);
-        UnloadImage(img);
-    }
-    return tex;
+// Images du démarrage : décodées en parallèle par des jobs (pendant l'ouverture
+// de la fenêtre), envoyées au GPU ensuite par le thread principal
+typedef struct {
+    const char *path;
+    Image image;
+} StartupImage;
+
+// Variante .dds compressée si elle est à jour (engine/texture.h)
+static void decodeImageJob(void *arg) {
+    StartupImage *s = arg;
+    s->image = TextureDecode(s->path);
 }
 
 static void initDefaultLayout(Game *g) {
@@ -177,6 +209,22 @@ static void loadMenuLayout(Game *g) {
     clampBearToScreen(g);
 }
 
+// Rechargement à chaud : le fond et le nounours gardent leur texture (même
+// identifiant si la taille ne change pas), le layout est réappliqué tel quel
+static void menuTexturesReloaded(void *arg) {
+    Game *g = arg;
+    g->hasMenuBackground = g->menuBackground.id != 0;
+    g->hasMenuBear = g->menuBear.id != 0;
+    if (g->hasMenuBear) clampBearToScreen(g); // proportions du nouveau nounours
+}
+
+static void menuLayoutChanged(void *arg) {
+    Game *g = arg;
+    g->draggingPortal = -1;
+    g->draggingBear = false;
+    loadMenuLayout(g);
+}
+
 static void saveMenuLayout(const Game *g) {
     FILE *f = fopen(LAYOUT_FILE, "w");
     if (!f) return;
@@ -214,10 +262,11 @@ static void drawMinigameStatusTable(const Game *g) {
     const float tableWidth = 460.0f;
     const float tableHeight = rowHeight * (ZONE_COUNT + 1);
 
-    DrawRectangleRounded((Rectangle){ tableX - 10, tableY - 20, tableWidth + 20, tableHeight + 30 }, 0.08f, 6, (Color){ 0, 0, 0, 160 });
+    UiBatchBox((Rectangle){ tableX - 10, tableY - 20, tableWidth + 20, tableHeight + 30 }, &(UiBox){ .radius = 10.0f, .fill = { 0, 0, 0, 160 }, .effectSize = 8.0f, .effectOffsetY = 4.0f, .effect = { 0, 0, 0, 90 } });
     DrawText("Etat des mini-jeux", (int)tableX, (int)tableY - 10, 26, RAYWHITE);
 
-    DrawLine(tableX, tableY + 8, tableX + tableWidth, tableY + 8, LIGHTGRAY);
+    // Filet en boîte SDF plutôt qu'en DrawLine : une ligne couperait le lot
+    UiBatchBox((Rectangle){ tableX, tableY + 7.5f, tableWidth, 1.0f }, &(UiBox){ .fill = LIGHTGRAY });
     DrawText("Pièce", (int)tableX, (int)tableY + 18, 22, LIGHTGRAY);
     DrawText("Statut", (int)(tableX + tableWidth - 150), (int)tableY + 18, 22, LIGHTGRAY);
 
@@ -240,7 +289,7 @@ static void drawCoinCounter(const Game *g) {
         (float)textWidth + padding * 2,
         50
     };
-    DrawRectangleRounded(box, 0.12f, 6, (Color){ 0, 0, 0, 160 });
+    UiBatchBox(box, &(UiBox){ .radius = 6.0f, .fill = { 0, 0, 0, 160 }, .effectSize = 6.0f, .effectOffsetY = 3.0f, .effect = { 0, 0, 0, 90 } });
     DrawText(label, (int)(box.x + padding), (int)(box.y + 12), fontSize, GOLD);
 }
 
@@ -285,13 +334,17 @@ static void clampBearToScreen(Game *g) {
 }
 
 static void drawPortalHighlights(const Game *g) {
-    Vector2 mouse = GetMousePosition();
+    Vector2 mouse = InputMousePosition();
     for (int i = 0; i < ZONE_COUNT; ++i) {
         Rectangle rect = computePortalRect(g, i);
         bool hover = CheckCollisionPointRec(mouse, rect);
         if (hover) {
-            DrawRectangleRounded(rect, 0.12f, 6, (Color){ 255, 255, 255, 35 });
-            DrawRectangleRoundedLines(rect, 0.12f, 6, (Color){ 255, 215, 0, 200 });
+            UiBatchBox(rect, &(UiBox){
+                .radius = 0.06f * fminf(rect.width, rect.height),
+                .fill = { 255, 255, 255, 35 },
+                .borderWidth = 2.0f, .border = { 255, 215, 0, 200 },
+                .effectSize = 14.0f, .effect = { 255, 215, 0, 90 }
+            });
             DrawText(HUB_PORTALS[i].label, (int)(rect.x + rect.width * 0.2f), (int)(rect.y - 32), 28, RAYWHITE);
         }
     }
@@ -304,8 +357,8 @@ static void handleDebugDragging(Game *g) {
         return;
     }
 
-    Vector2 mouse = GetMousePosition();
-    if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
+    Vector2 mouse = InputMousePosition();
+    if (InputMousePressed(MOUSE_LEFT_BUTTON)) {
         g->draggingPortal = -1;
         g->draggingBear = false;
         for (int i = 0; i < ZONE_COUNT; ++i) {
@@ -325,7 +378,7 @@ static void handleDebugDragging(Game *g) {
         }
     }
 
-    if (IsMouseButtonDown(MOUSE_LEFT_BUTTON)) {
+    if (InputMouseDown(MOUSE_LEFT_BUTTON)) {
         float sw = (float)GetScreenWidth();
         float sh = (float)GetScreenHeight();
         if (g->draggingPortal >= 0) {
@@ -340,7 +393,7 @@ static void handleDebugDragging(Game *g) {
         }
     }
 
-    if (IsMouseButtonReleased(MOUSE_LEFT_BUTTON)) {
+    if (InputMouseReleased(MOUSE_LEFT_BUTTON)) {
         g->draggingPortal = -1;
         g->draggingBear = false;
     }
@@ -348,7 +401,7 @@ static void handleDebugDragging(Game *g) {
 
 static void drawDebugOverlay(const Game *g) {
     if (!g->showDebugOverlay) return;
-    Vector2 mouse = GetMousePosition();
+    Vector2 mouse = InputMousePosition();
     const int panelWidth = 400;
     const int panelHeight = 40 + ZONE_COUNT * 24;
     DrawRectangle(30, 90, panelWidth, panelHeight, (Color){ 0, 0, 0, 160 });
@@ -364,6 +417,73 @@ static void drawDebugOverlay(const Game *g) {
     }
 }
 
+// Latence entrée -> image présentée (F2), dans tous les états
+static void drawLatencyOverlay(const Game *g) {
+    if (!g->showDebugOverlay) return;
+    float p50, p90, p99;
+    int samples = InputLatencyPercentiles(&p50, &p90, &p99);
+    const int x = GetScreenWidth() - 330;
+    DrawRectangle(x, 90, 300, 84, (Color){ 0, 0, 0, 160 });
+    DrawRectangleLines(x, 90, 300, 84, (Color){ 255, 255, 255, 80 });
+    DrawText(TextFormat("Latence entrée (%d images)", samples), x + 10, 100, 18, RAYWHITE);
+    DrawText(TextFormat("p50 %.1f  p90 %.1f  p99 %.1f ms", p50, p90, p99), x + 10, 124, 18, LIGHTGRAY);
+    DrawText(TextFormat("F3: late latch %s", g->lateLatch ? "actif" : "inactif"), x + 10, 148, 18, g->lateLatch ? GREEN : GRAY);
+}
+
+// Sans late latch, raylib cadence à 60 images/s ; avec, c'est la synchro
+// verticale et l'attente de lateLatchWait qui rythment la boucle
+static void setLateLatch(Game *g, bool on) {
+    g->lateLatch = on;
+    SetTargetFPS(on ? 0 : 60);
+}
+
+// Après la présentation, dort jusqu'à peu avant la prochaine synchro verticale :
+// la durée de l'image (mise à jour + dessin, moyenne glissante) plus une marge
+static void lateLatchWait(float workSeconds) {
+    int hz = GetMonitorRefreshRate(GetCurrentMonitor());
+    double interval = hz > 0 ? 1.0 / hz : 1.0 / 60.0;
+    double wait = interval - workSeconds * 1.25 - lateLatchMargin;
+    if (wait > 0.0) WaitTime(wait);
+}
+
+// Étape de simulation d'un mini-jeu : mise à jour puis publication de l'état à
+// dessiner. Sur le thread de simulation quand le pipeline est actif.
+static const MinigameAPI *steppedMinigame;
+
+static void minigameStep(float dt) {
+    TRACE_BEGIN("minigame.update");
+    if (steppedMinigame->update) steppedMinigame->update(dt);
+    TRACE_END();
+    if (steppedMinigame->publish) steppedMinigame->publish();
+}
+
+static void minigamePublish(float dt) {
+    (void)dt;
+    steppedMinigame->publish();
+}
+
+// Le late latch relit les entrées pendant le dessin : incompatible avec une
+// simulation qui les lit au même moment (et qui ajoute une image de latence)
+static bool pipelineMinigame(const Game *g) {
+    return g->pipelined && !g->lateLatch && g->state == STATE_MINIJEU && g->currentMinigame.publish;
+}
+
+// Fin d'un mini-jeu et récupération des pièces (thread principal, simulation terminée)
+static void finishMinigameIfDone(Game *g) {
+    if (g->state != STATE_MINIJEU || !g->currentMinigame.isCompleted) return;
+    int coins = 0;
+    if (g->currentMinigame.isCompleted(&coins)) {
+        g->collectibles += coins;
+        if (g->activeZone >= 0 && g->activeZone < ZONE_COUNT) g->progress[g->activeZone].completed = true;
+        TRACE_BEGIN("minigame.unload");
+        if (g->currentMinigame.unload) g->currentMinigame.unload();
+        TRACE_END();
+        g->state = STATE_HUB;
+        g->activeZone = ZONE_NONE;
+        MusicPlay(HUB_MUSIC, MUSIC_FADE);
+    }
+}
+
 static GameState zoneToState(ZoneId zone) {
     switch (zone) {
         case ZONE_JARDIN: return STATE_ZONE_JARDIN;
@@ -374,24 +494,310 @@ static GameState zoneToState(ZoneId zone) {
     }
 }
 
+static void updateGame(Game *g, float dt) {
+    clampBearToScreen(g);
+
+    if (InputKeyPressed(KEY_F11)) ToggleFullscreen();
+    if (InputKeyPressed(KEY_F2)) g->showDebugOverlay = !g->showDebugOverlay;
+    if (InputKeyPressed(KEY_F3) && !InputIsScripted()) setLateLatch(g, !g->lateLatch);
+    if (InputKeyPressed(KEY_F9)) TraceWrite(tracePath); // dernières secondes de trace (--trace)
+
+    if (g->state == STATE_TITLE) {
+        if (InputKeyPressed(KEY_ENTER)) { g->state = STATE_HUB; resetPlayer(&g->player); MusicPlay(HUB_MUSIC, MUSIC_FADE); }
+    } else if (g->state == STATE_PAUSE) {
+        if (InputKeyPressed(KEY_ESCAPE)) g->state = STATE_HUB;
+    } else {
+        if (InputKeyPressed(KEY_ESCAPE)) g->state = STATE_PAUSE;
+    }
+
+    switch (g->state) {
+        case STATE_HUB: {
+            handleDebugDragging(g);
+            if (!g->showDebugOverlay) {
+                Vector2 mouse = InputMousePosition();
+                for (int i = 0; i < ZONE_COUNT; ++i) {
+                    Rectangle rect = computePortalRect(g, i);
+                    if (CheckCollisionPointRec(mouse, rect)) {
+                        if (InputMousePressed(MOUSE_LEFT_BUTTON)) {
+                            g->state = zoneToState(HUB_PORTALS[i].zone);
+                            g->activeZone = HUB_PORTALS[i].zone;
+                            // Le flux du mini-jeu est ouvert pendant que la zone s'affiche
+                            MusicPrefetch(ZONE_MUSIC[g->activeZone]);
+                        }
+                    }
+                }
+            }
+        } break;
+        case STATE_ZONE_JARDIN:
+        case STATE_ZONE_CHAMBRE:
+        case STATE_ZONE_GRENIER:
+        case STATE_ZONE_CUISINE:
+            if (InputKeyPressed(KEY_BACKSPACE)) { g->state = STATE_HUB; g->activeZone = ZONE_NONE; }
+            if (InputKeyPressed(KEY_ENTER)) {
+                // Choix mini‑jeu par zone
+                if (g->state == STATE_ZONE_JARDIN) g->currentMinigame = GetMinigamePoussePousse();
+                else if (g->state == STATE_ZONE_CHAMBRE) g->currentMinigame = GetMinigameGateau();
+                else if (g->state == STATE_ZONE_GRENIER) g->currentMinigame = GetMinigameTraffic();
+                else g->currentMinigame = GetMinigamePoussePousse(); // défaut
+                TRACE_BEGIN("minigame.init");
+                if (g->currentMinigame.init) g->currentMinigame.init();
+                TRACE_END();
+                // premier instantané : le mini-jeu est dessiné dès cette image
+                PipelineReset();
+                steppedMinigame = &g->currentMinigame;
+                if (g->currentMinigame.publish) PipelineRun(minigamePublish, 0.0f);
+                if (g->activeZone >= 0 && g->activeZone < ZONE_COUNT) MusicPlay(ZONE_MUSIC[g->activeZone], MUSIC_FADE);
+                g->state = STATE_MINIJEU;
+            }
+            break;
+        case STATE_MINIJEU:
+            if (InputKeyPressed(KEY_BACKSPACE)) {
+                TRACE_BEGIN("minigame.unload");
+                if (g->currentMinigame.unload) g->currentMinigame.unload();
+                TRACE_END();
+                g->state = STATE_HUB;
+                g->activeZone = ZONE_NONE;
+                MusicPlay(HUB_MUSIC, MUSIC_FADE);
+                break; // mini-jeu déchargé : plus de mise à jour
+            }
+            if (pipelineMinigame(g)) break; // étape lancée par la boucle principale, pendant le dessin
+            steppedMinigame = &g->currentMinigame;
+            PipelineRun(minigameStep, dt);
+            finishMinigameIfDone(g);
+            break;
+        default: break;
+    }
+}
+
+static void drawGame(const Game *g) {
+    ClearBackground((Color){ 30, 34, 46, 255 });
+    switch (g->state) {
+        case STATE_TITLE:
+            drawCentered("Gros Nounours 2D", 140, 64, RAYWHITE);
+            drawCentered("Entrée: Jouer", 240, 26, LIGHTGRAY);
+            drawCentered("Flèches: Gauche/Droite — Espace: Saut — E/Entrée: Interagir", 300, 20, GRAY);
+            break;
+        case STATE_PAUSE:
+            drawCentered("Pause", 180, 48, RAYWHITE);
+            drawCentered("Échap: Reprendre", 240, 24, LIGHTGRAY);
+            break;
+        case STATE_HUB: {
+            drawMenuBackground(g);
+            drawBearCloseup(g);
+            // Toute l'interface du hub (panneaux et texte) en un seul appel de dessin
+            UiBatchBegin();
+            DrawText("Clique sur une porte | F11: Plein écran | F2: Debug (drag & drop)", 40, 40, 24, WHITE);
+            drawPortalHighlights(g);
+            drawMinigameStatusTable(g);
+            drawCoinCounter(g);
+            UiBatchEnd();
+            drawDebugOverlay(g);
+        } break;
+        case STATE_ZONE_JARDIN:
+            drawCentered("Jardin — Entrée: Mini‑jeu | Retour: Backspace", 160, 26, RAYWHITE);
+            break;
+        case STATE_ZONE_CHAMBRE:
+            drawCentered("Chambre — Entrée: Mini‑jeu | Retour: Backspace", 160, 26, RAYWHITE);
+            break;
+        case STATE_ZONE_GRENIER:
+            drawCentered("Grenier — Entrée: Mini‑jeu | Retour: Backspace", 160, 26, RAYWHITE);
+            break;
+        case STATE_ZONE_CUISINE:
+            drawCentered("Cuisine — Entrée: Mini‑jeu | Retour: Backspace", 160, 26, RAYWHITE);
+            break;
+        case STATE_MINIJEU:
+            TRACE_BEGIN("minigame.draw");
+            if (g->currentMinigame.draw) g->currentMinigame.draw();
+            TRACE_END();
+            break;
+        default: break;
+    }
+    drawLatencyOverlay(g);
+}
+
+// Une image de la boucle principale (aussi jouée par le test d'endurance)
+static void runFrame(Game *g) {
+    static float workEma; // durée mise à jour + dessin, pour caler l'attente du late latch
+    TRACE_BEGIN("frame");
+    if (g->lateLatch) {
+        TRACE_BEGIN("latch.wait");
+        lateLatchWait(workEma);
+        InputLatchNow();
+        TRACE_END();
+    }
+    InputBeginFrame();
+    HotReloadPoll(); // assets modifiés sur disque, appliqués hors de toute simulation
+    double workStart = GetTime();
+    float dt = GetFrameTime();
+    TRACE_BEGIN("update");
+    updateGame(g, dt);
+    TRACE_END();
+    // Pipeline : le mini-jeu simule cette image pendant le dessin de la précédente
+    bool pipelined = pipelineMinigame(g);
+    if (pipelined) {
+        steppedMinigame = &g->currentMinigame;
+        PipelineKick(minigameStep, dt);
+    }
+    // la souris est relue juste avant le dessin : curseur et objet saisi à jour
+    if (g->lateLatch) InputLatchNow();
+    TRACE_BEGIN("draw");
+    BeginDrawing();
+    drawGame(g);
+    TRACE_END();
+    if (pipelined) {
+        TRACE_BEGIN("sim.wait");
+        PipelineWait();
+        TRACE_END();
+    }
+    workEma += ((float)(GetTime() - workStart) - workEma) * 0.1f;
+    TRACE_BEGIN("present"); // échange des tampons, attente vsync, événements
+    EndDrawing();
+    InputFramePresented();
+    TRACE_END();
+    // après la présentation : le lot de dessin ne référence plus les textures du mini-jeu
+    if (pipelined) finishMinigameIfDone(g);
+    TRACE_END();
+}
+
+// Banc d'essai du hub : la souris balaie les portes (sans clic), F2 bascule
+// régulièrement le calque de debug
+static Game *benchGame;
+
+static void benchHubSetup(void) {
+    benchGame->state = STATE_HUB;
+    benchGame->showDebugOverlay = false;
+}
+
+static void benchHubScript(int frame) {
+    float t = (float)(frame % 240) / 240.0f;
+    InputScriptMouse((Vector2){ t * GetScreenWidth(), GetScreenHeight() * 0.4f }, 0);
+    InputScriptKey(KEY_F2, frame % 120 == 0);
+}
+
+static void benchHubUpdate(float dt) { updateGame(benchGame, dt); }
+static void benchHubDraw(void) { drawGame(benchGame); }
+
+// Test d'endurance : visites scriptées des mini-jeux, relevé au hub avant chacune
+#define SOAK_HUB_FRAMES 120     // fondu de la musique terminé avant le relevé
+#define SOAK_STUCK_FRAMES 600   // au-delà, le script est bloqué
+
+typedef enum { SOAK_IN_HUB, SOAK_IN_ZONE, SOAK_IN_MINIGAME } SoakPhase;
+
+static const struct {
+    ZoneId zone;
+    const char *name;
+    void (*script)(int frame);
+} SOAK_VISITS[] = {
+    { ZONE_JARDIN,  "pousse",  BenchScriptPousse },
+    { ZONE_CHAMBRE, "gateau",  BenchScriptGateau },
+    { ZONE_GRENIER, "traffic", BenchScriptTraffic }
+};
+#define SOAK_VISIT_COUNT (int)(sizeof(SOAK_VISITS) / sizeof(SOAK_VISITS[0]))
+
+static int runSoak(Game *g, const SoakOptions *opt) {
+    SoakPhase phase = SOAK_IN_HUB;
+    int visit = 0, frame = 0;
+    g->state = STATE_HUB;
+    g->activeZone = ZONE_NONE;
+    MusicPlay(HUB_MUSIC, MUSIC_FADE);
+    InputSetScripted(true);
+    SoakBegin(opt);
+    while (!WindowShouldClose()) {
+        int v = visit % SOAK_VISIT_COUNT;
+        InputScriptBeginFrame();
+        if (phase == SOAK_IN_HUB) {
+            if (frame == SOAK_HUB_FRAMES) {
+                if (SoakFinished()) break;
+                SoakMark(SOAK_VISITS[v].name);
+            }
+            Rectangle door = computePortalRect(g, SOAK_VISITS[v].zone);
+            Vector2 center = { door.x + door.width * 0.5f, door.y + door.height * 0.5f };
+            InputScriptMouse(center, frame == SOAK_HUB_FRAMES ? 1 : 0);
+        } else if (phase == SOAK_IN_ZONE) {
+            InputScriptKey(KEY_ENTER, frame == 10);
+        } else if (frame < opt->visitFrames) {
+            SOAK_VISITS[v].script(frame);
+        } else {
+            InputScriptKey(KEY_BACKSPACE, frame == opt->visitFrames);
+        }
+
+        runFrame(g);
+
+        frame++;
+        // une partie terminée avant la fin du script ramène aussi au hub
+        SoakPhase next = g->state == STATE_HUB ? SOAK_IN_HUB : (g->state == STATE_MINIJEU ? SOAK_IN_MINIGAME : SOAK_IN_ZONE);
+        if (next != phase) {
+            if (next == SOAK_IN_HUB) visit++;
+            phase = next;
+            frame = 0;
+            InputSetScripted(true); // touches relâchées entre deux étapes
+        } else if (phase != SOAK_IN_MINIGAME && frame > SOAK_HUB_FRAMES + SOAK_STUCK_FRAMES) {
+            SoakFail(TextFormat("bloqué (état %d, visite de %s)", g->state, SOAK_VISITS[v].name));
+            break;
+        }
+    }
+    InputSetScripted(false);
+    return SoakEnd();
+}
+
 int main(int argc, char **argv) {
     Game g = {0};
-    for (int i = 1; i < argc; ++i) if (strcmp(argv[i], "--log") == 0) g.loggingEnabled = true;
+    bool hotReload = false; // --hot-reload : surveillance des assets (développement)
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--log") == 0) g.loggingEnabled = true;
+        else if (strcmp(argv[i], "--hot-reload") == 0) hotReload = true;
+    }
+    BenchOptions bench;
+    BenchParseArgs(&bench, argc, argv);
+    SoakOptions soak;
+    SoakParseArgs(&soak, argc, argv);
+    // --trace [--trace-seconds S] [--trace-out F] : F9 ou la sortie écrit les S dernières secondes
+    bool trace = false;
+    float traceSeconds = 10.0f;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--trace") == 0) trace = true;
+        else if (strcmp(argv[i], "--trace-seconds") == 0 && i + 1 < argc) traceSeconds = (float)atof(argv[++i]);
+        else if (strcmp(argv[i], "--trace-out") == 0 && i + 1 < argc) tracePath = argv[++i];
+    }
+    if (trace) TraceStart(traceSeconds); // avant tout chargement et tout thread
+    JobsInit(0);
+    StartupImage startup[] = {
+        { "assets/icon.png", {0} },          // icône de fenêtre (placer votre image sous assets/icon.png)
+        { "assets/imagefond.png", {0} },
+        { "assets/nounoursmenu.png", {0} }
+    };
+    JobCounter decoded;
+    atomic_init(&decoded.pending, 0);
+    for (int i = 0; i < 3; ++i) JobsRun(decodeImageJob, &startup[i], &decoded);
 
-    SetConfigFlags(FLAG_VSYNC_HINT | FLAG_WINDOW_HIGHDPI | FLAG_WINDOW_RESIZABLE);
+    // --bench : pas de synchro verticale ni de limite d'images
+    SetConfigFlags((bench.enabled ? 0 : FLAG_VSYNC_HINT) | FLAG_WINDOW_HIGHDPI | FLAG_WINDOW_RESIZABLE);
     InitWindow(1920, 1080, "Gros Nounours 2D");
-    // Icône de fenêtre (placer votre image sous assets/icon.png)
-    {
-        Image icon = LoadImage("assets/icon.png");
-        if (icon.data) { SetWindowIcon(icon); UnloadImage(icon); }
-    }
-    g.menuBackground = loadTextureIfAvailable("assets/imagefond.png");
+    JobsWait(&decoded);
+    if (startup[0].image.data) { SetWindowIcon(startup[0].image); UnloadImage(startup[0].image); }
+    g.menuBackground = TextureUpload(&startup[1].image, startup[1].path);
     g.hasMenuBackground = g.menuBackground.id != 0;
-    g.menuBear = loadTextureIfAvailable("assets/nounoursmenu.png");
+    g.menuBear = TextureUpload(&startup[2].image, startup[2].path);
     g.hasMenuBear = g.menuBear.id != 0;
     loadMenuLayout(&g);
-
-    SetTargetFPS(60);
+    if (!bench.enabled && !soak.enabled && (hotReload || ConfigReadBool("dev", "hot_reload", false))) {
+        // Itération sur les assets sans relancer le jeu : --hot-reload ou [dev] hot_reload=True
+        HotReloadInit();
+        HotReloadWatchTexture("assets/imagefond.png", &g.menuBackground, menuTexturesReloaded, &g);
+        HotReloadWatchTexture("assets/nounoursmenu.png", &g.menuBear, menuTexturesReloaded, &g);
+        HotReloadWatchFile(LAYOUT_FILE, menuLayoutChanged, &g);
+    }
+    ParticlesInit();
+    UiBatchInit();
+    PipelineInit();
+    // Audio : un seul device pour toute la session (volumes lus dans config/default.ini)
+    AudioEngineInit();
+    MusicInit();
+
+    SetTargetFPS(bench.enabled ? 0 : 60);
+    lateLatchMargin = ConfigReadFloat("input", "late_latch_margin_ms", 3.0f) / 1000.0f;
+    if (!bench.enabled && !soak.enabled) setLateLatch(&g, ConfigReadBool("input", "late_latch", false));
+    g.pipelined = ConfigReadBool("video", "pipeline", true);
     g.state = STATE_TITLE;
     g.activeZone = ZONE_NONE;
     g.showDebugOverlay = false;
@@ -399,119 +805,34 @@ int main(int argc, char **argv) {
     g.draggingBear = false;
     resetPlayer(&g.player);
 
-    while (!WindowShouldClose()) {
-        float dt = GetFrameTime();
-        clampBearToScreen(&g);
-
-        if (IsKeyPressed(KEY_F11)) ToggleFullscreen();
-        if (IsKeyPressed(KEY_F2)) g.showDebugOverlay = !g.showDebugOverlay;
-
-        if (g.state == STATE_TITLE) {
-            if (IsKeyPressed(KEY_ENTER)) { g.state = STATE_HUB; resetPlayer(&g.player); }
-        } else if (g.state == STATE_PAUSE) {
-            if (IsKeyPressed(KEY_ESCAPE)) g.state = STATE_HUB;
-        } else {
-            if (IsKeyPressed(KEY_ESCAPE)) g.state = STATE_PAUSE;
-        }
-
-        switch (g.state) {
-            case STATE_HUB: {
-                handleDebugDragging(&g);
-                if (!g.showDebugOverlay) {
-                    Vector2 mouse = GetMousePosition();
-                    for (int i = 0; i < ZONE_COUNT; ++i) {
-                        Rectangle rect = computePortalRect(&g, i);
-                        if (CheckCollisionPointRec(mouse, rect)) {
-                            if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-                                g.state = zoneToState(HUB_PORTALS[i].zone);
-                                g.activeZone = HUB_PORTALS[i].zone;
-                            }
-                        }
-                    }
-                }
-            } break;
-            case STATE_ZONE_JARDIN:
-            case STATE_ZONE_CHAMBRE:
-            case STATE_ZONE_GRENIER:
-            case STATE_ZONE_CUISINE:
-                if (IsKeyPressed(KEY_BACKSPACE)) { g.state = STATE_HUB; g.activeZone = ZONE_NONE; }
-                if (IsKeyPressed(KEY_ENTER)) {
-                    // Choix mini‑jeu par zone
-                    if (g.state == STATE_ZONE_JARDIN) g.currentMinigame = GetMinigamePoussePousse();
-                    else if (g.state == STATE_ZONE_CHAMBRE) g.currentMinigame = GetMinigameGateau();
-                    else if (g.state == STATE_ZONE_GRENIER) g.currentMinigame = GetMinigameTraffic();
-                    else g.currentMinigame = GetMinigamePoussePousse(); // défaut
-                    if (g.currentMinigame.init) g.currentMinigame.init();
-                    g.state = STATE_MINIJEU;
-                }
-                break;
-            case STATE_MINIJEU:
-                if (IsKeyPressed(KEY_BACKSPACE)) {
-                    if (g.currentMinigame.unload) g.currentMinigame.unload();
-                    g.state = STATE_HUB;
-                    g.activeZone = ZONE_NONE;
-                }
-                if (g.currentMinigame.update) g.currentMinigame.update(dt);
-                // Gestion de la fin des mini-jeux et récupération des pièces
-                if (g.currentMinigame.isCompleted) {
-                    int coins = 0;
-                    if (g.currentMinigame.isCompleted(&coins)) {
-                        g.collectibles += coins;
-                        if (g.activeZone >= 0 && g.activeZone < ZONE_COUNT) g.progress[g.activeZone].completed = true;
-                        if (g.currentMinigame.unload) g.currentMinigame.unload();
-                        g.state = STATE_HUB;
-                        g.activeZone = ZONE_NONE;
-                    }
-                }
-                break;
-            default: break;
-        }
-
-        BeginDrawing();
-        ClearBackground((Color){ 30, 34, 46, 255 });
-        switch (g.state) {
-            case STATE_TITLE:
-                drawCentered("Gros Nounours 2D", 140, 64, RAYWHITE);
-                drawCentered("Entrée: Jouer", 240, 26, LIGHTGRAY);
-                drawCentered("Flèches: Gauche/Droite — Espace: Saut — E/Entrée: Interagir", 300, 20, GRAY);
-                break;
-            case STATE_PAUSE:
-                drawCentered("Pause", 180, 48, RAYWHITE);
-                drawCentered("Échap: Reprendre", 240, 24, LIGHTGRAY);
-                break;
-            case STATE_HUB: {
-                drawMenuBackground(&g);
-                drawBearCloseup(&g);
-                DrawText("Clique sur une porte | F11: Plein écran | F2: Debug (drag & drop)", 40, 40, 24, WHITE);
-                drawPortalHighlights(&g);
-                drawMinigameStatusTable(&g);
-                drawCoinCounter(&g);
-                drawDebugOverlay(&g);
-            } break;
-            case STATE_ZONE_JARDIN:
-                drawCentered("Jardin — Entrée: Mini‑jeu | Retour: Backspace", 160, 26, RAYWHITE);
-                break;
-            case STATE_ZONE_CHAMBRE:
-                drawCentered("Chambre — Entrée: Mini‑jeu | Retour: Backspace", 160, 26, RAYWHITE);
-                break;
-            case STATE_ZONE_GRENIER:
-                drawCentered("Grenier — Entrée: Mini‑jeu | Retour: Backspace", 160, 26, RAYWHITE);
-                break;
-            case STATE_ZONE_CUISINE:
-                drawCentered("Cuisine — Entrée: Mini‑jeu | Retour: Backspace", 160, 26, RAYWHITE);
-                break;
-            case STATE_MINIJEU:
-                if (g.currentMinigame.draw) g.currentMinigame.draw();
-                break;
-            default: break;
-        }
-        EndDrawing();
+    int exitCode = 0;
+    if (bench.enabled) {
+        benchGame = &g;
+        BenchRegister(&(BenchScenario){ "hub", benchHubSetup, benchHubScript, benchHubUpdate, benchHubDraw, NULL, 0 });
+        BenchRegisterMinigames();
+        exitCode = BenchRun(&bench);
+    } else if (soak.enabled) {
+        exitCode = runSoak(&g, &soak);
+    } else {
+        while (!WindowShouldClose()) runFrame(&g);
+        saveMenuLayout(&g);
     }
-    saveMenuLayout(&g);
+    TraceWrite(tracePath);
+    HotReloadShutdown();
+    // les threads des mini-jeux (solveur, pâte) s'arrêtent avant la fin des traces
+    if (g.state == STATE_MINIJEU && g.currentMinigame.unload) g.currentMinigame.unload();
+    GateauShutdown();
     if (g.hasMenuBackground) UnloadTexture(g.menuBackground);
     if (g.hasMenuBear) UnloadTexture(g.menuBear);
+    PipelineShutdown();
+    JobsShutdown();
+    ParticlesShutdown();
+    UiBatchShutdown();
+    MusicShutdown();
+    AudioEngineShutdown();
+    TraceShutdown();
     CloseWindow();
-    return 0;
+    return exitCode;
 }
 
 
@@ -0,0 +1,435 @@
+// Pâte à particules : grille uniforme triée par cellule + relaxation de double
+// densité en version Jacobi (chaque particule ne lit que ses voisines, ce qui
+// permet de traiter les voisines 4 par 4 en SSE).
+#include "batter.h"
+#include "engine/jobs.h"
+#include "engine/trace.h"
+#include <math.h>
+#include <string.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define BATTER_SIMD 1
+#else
+#define BATTER_SIMD 0
+#endif
+
+#define KERNEL_RADIUS 7.0f      // rayon d'interaction (px), aussi taille des cellules
+#define REST_DENSITY 4.0f
+#define STIFFNESS 0.15f         // déplacement (px) par unité de surdensité
+#define STIFFNESS_NEAR 0.3f     // anti-agglomération
+#define MAX_DISPLACEMENT 2.0f   // par sous-pas, pour la stabilité
+#define GRAVITY 300.0f
+#define DAMPING 0.95f           // pâte visqueuse
+#define STIR_RADIUS 20.0f
+#define STIR_STRENGTH 0.35f
+#define MIX_RATE 4.0f           // vitesse de mélange des couleurs quand la pâte bouge
+#define MIX_MIN_SPEED 30.0f     // en dessous (tassement), pas de mélange
+#define SUBSTEPS 2
+#define BORDER 3.0f
+#define DOT_SIZE 6
+#define GRID_MAX_CELLS 4096
+
+typedef struct {
+    float dt;
+    Vector2 stirPos;
+    Vector2 stirVel;
+    bool stirActive;
+} StepInput;
+
+// Particules en SoA, en double exemplaire pour le tri par cellule
+static float posX[2][BATTER_MAX], posY[2][BATTER_MAX];
+static float velX[2][BATTER_MAX], velY[2][BATTER_MAX];
+static float colR[2][BATTER_MAX], colG[2][BATTER_MAX], colB[2][BATTER_MAX];
+static short owners[2][BATTER_MAX];
+static int cur;
+static int count;
+
+// Tampons de travail d'un sous-pas
+static int cellOf[BATTER_MAX];
+static int cellStart[GRID_MAX_CELLS + 1];
+static int cellCursor[GRID_MAX_CELLS];
+static float pressure[BATTER_MAX], pressureNear[BATTER_MAX];
+static float dispX[BATTER_MAX], dispY[BATTER_MAX];
+static float mixR[BATTER_MAX], mixG[BATTER_MAX], mixB[BATTER_MAX];
+static int gridW, gridH;
+static float areaW, areaH;
+
+// État publié pour le dessin (écrit par le thread principal uniquement)
+static Vector2 renderPos[BATTER_MAX];
+static Color renderColor[BATTER_MAX];
+static int renderCount;
+static Texture2D dot;
+
+// Entrées : préparées par le thread principal, copiées au lancement du pas
+static StepInput pending;
+static StepInput job;
+
+// Pas de simulation lancé en job (optionnel) ; stepJobs non nul pendant le pas
+static bool threaded;
+static JobCounter stepJobs;
+
+static int cellIndex(float x, float y) {
+    int cx = (int)(x / KERNEL_RADIUS);
+    int cy = (int)(y / KERNEL_RADIUS);
+    if (cx < 0) cx = 0; else if (cx >= gridW) cx = gridW - 1;
+    if (cy < 0) cy = 0; else if (cy >= gridH) cy = gridH - 1;
+    return cy * gridW + cx;
+}
+
+// Tri par comptage : les particules d'une même ligne de cellules deviennent contiguës
+static void sortByCell(void) {
+    int cells = gridW * gridH;
+    memset(cellStart, 0, sizeof(int) * (cells + 1));
+    for (int i = 0; i < count; ++i) {
+        cellOf[i] = cellIndex(posX[cur][i], posY[cur][i]);
+        cellStart[cellOf[i] + 1]++;
+    }
+    for (int c = 0; c < cells; ++c) {
+        cellStart[c + 1] += cellStart[c];
+        cellCursor[c] = cellStart[c];
+    }
+    int dst = 1 - cur;
+    for (int i = 0; i < count; ++i) {
+        int k = cellCursor[cellOf[i]]++;
+        posX[dst][k] = posX[cur][i]; posY[dst][k] = posY[cur][i];
+        velX[dst][k] = velX[cur][i]; velY[dst][k] = velY[cur][i];
+        colR[dst][k] = colR[cur][i]; colG[dst][k] = colG[cur][i]; colB[dst][k] = colB[cur][i];
+        owners[dst][k] = owners[cur][i];
+    }
+    cur = dst;
+}
+
+// Voisinage 3x3 : une plage contiguë [start, end) par ligne de cellules
+static int neighbourRanges(float x, float y, int *starts, int *ends) {
+    int cx = (int)(x / KERNEL_RADIUS);
+    int cy = (int)(y / KERNEL_RADIUS);
+    if (cx < 0) cx = 0; else if (cx >= gridW) cx = gridW - 1;
+    if (cy < 0) cy = 0; else if (cy >= gridH) cy = gridH - 1;
+    int x0 = cx > 0 ? cx - 1 : 0;
+    int x1 = cx < gridW - 1 ? cx + 1 : gridW - 1;
+    int n = 0;
+    for (int row = cy - 1; row <= cy + 1; ++row) {
+        if (row < 0 || row >= gridH) continue;
+        starts[n] = cellStart[row * gridW + x0];
+        ends[n] = cellStart[row * gridW + x1 + 1];
+        n++;
+    }
+    return n;
+}
+
+#if BATTER_SIMD
+static float horizontalSum(__m128 v) {
+    __m128 shuf = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+    __m128 sums = _mm_add_ps(v, shuf);
+    shuf = _mm_movehl_ps(shuf, sums);
+    return _mm_cvtss_f32(_mm_add_ss(sums, shuf));
+}
+#endif
+
+// Densité et densité proche de la particule (xi, yi) sur la plage [s, e)
+static void accumulateDensity(float xi, float yi, const float *x, const float *y, int s, int e, float *rho, float *rhoNear) {
+    const float invH = 1.0f / KERNEL_RADIUS;
+    int j = s;
+    float d = 0.0f, dn = 0.0f;
+#if BATTER_SIMD
+    __m128 vxi = _mm_set1_ps(xi), vyi = _mm_set1_ps(yi);
+    __m128 vInvH = _mm_set1_ps(invH), one = _mm_set1_ps(1.0f), zero = _mm_setzero_ps();
+    __m128 acc = zero, accNear = zero;
+    for (; j + 4 <= e; j += 4) {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(x + j), vxi);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(y + j), vyi);
+        __m128 r2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        __m128 w = _mm_max_ps(_mm_sub_ps(one, _mm_mul_ps(_mm_sqrt_ps(r2), vInvH)), zero);
+        __m128 w2 = _mm_mul_ps(w, w);
+        acc = _mm_add_ps(acc, w2);
+        accNear = _mm_add_ps(accNear, _mm_mul_ps(w2, w));
+    }
+    d = horizontalSum(acc);
+    dn = horizontalSum(accNear);
+#endif
+    for (; j < e; ++j) {
+        float dx = x[j] - xi, dy = y[j] - yi;
+        float w = 1.0f - sqrtf(dx*dx + dy*dy) * invH;
+        if (w <= 0.0f) continue;
+        d += w * w;
+        dn += w * w * w;
+    }
+    *rho += d;
+    *rhoNear += dn;
+}
+
+typedef struct {
+    float dx, dy;       // déplacement de relaxation
+    float r, g, b;      // somme pondérée des écarts de couleur
+    float weight;
+} Relaxation;
+
+// Déplacement (symétrisé) et mélange de couleur de la particule i sur la plage [s, e)
+static void accumulateRelaxation(int i, int s, int e, Relaxation *out) {
+    const float *x = posX[cur], *y = posY[cur];
+    const float *cr = colR[cur], *cg = colG[cur], *cb = colB[cur];
+    const float invH = 1.0f / KERNEL_RADIUS;
+    const float xi = x[i], yi = y[i], pi = pressure[i], pni = pressureNear[i];
+    const float ri = cr[i], gi = cg[i], bi = cb[i];
+    int j = s;
+    float ax = 0.0f, ay = 0.0f, ar = 0.0f, ag = 0.0f, ab = 0.0f, aw = 0.0f;
+#if BATTER_SIMD
+    __m128 vxi = _mm_set1_ps(xi), vyi = _mm_set1_ps(yi);
+    __m128 vpi = _mm_set1_ps(pi), vpni = _mm_set1_ps(pni);
+    __m128 vri = _mm_set1_ps(ri), vgi = _mm_set1_ps(gi), vbi = _mm_set1_ps(bi);
+    __m128 vInvH = _mm_set1_ps(invH), one = _mm_set1_ps(1.0f), zero = _mm_setzero_ps();
+    __m128 half = _mm_set1_ps(0.5f), eps = _mm_set1_ps(1e-6f);
+    __m128 sx = zero, sy = zero, sr = zero, sg = zero, sb = zero, sw = zero;
+    for (; j + 4 <= e; j += 4) {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(x + j), vxi);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(y + j), vyi);
+        __m128 r2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        __m128 r = _mm_sqrt_ps(_mm_max_ps(r2, eps));
+        __m128 w = _mm_max_ps(_mm_sub_ps(one, _mm_mul_ps(r, vInvH)), zero);
+        w = _mm_and_ps(w, _mm_cmpgt_ps(r2, eps)); // la particule elle-même ne compte pas
+        __m128 p = _mm_add_ps(vpi, _mm_loadu_ps(pressure + j));
+        __m128 pn = _mm_add_ps(vpni, _mm_loadu_ps(pressureNear + j));
+        __m128 mag = _mm_mul_ps(w, _mm_add_ps(p, _mm_mul_ps(pn, w)));
+        __m128 coef = _mm_div_ps(_mm_mul_ps(mag, half), r);
+        sx = _mm_sub_ps(sx, _mm_mul_ps(coef, dx));
+        sy = _mm_sub_ps(sy, _mm_mul_ps(coef, dy));
+        sr = _mm_add_ps(sr, _mm_mul_ps(w, _mm_sub_ps(_mm_loadu_ps(cr + j), vri)));
+        sg = _mm_add_ps(sg, _mm_mul_ps(w, _mm_sub_ps(_mm_loadu_ps(cg + j), vgi)));
+        sb = _mm_add_ps(sb, _mm_mul_ps(w, _mm_sub_ps(_mm_loadu_ps(cb + j), vbi)));
+        sw = _mm_add_ps(sw, w);
+    }
+    ax = horizontalSum(sx); ay = horizontalSum(sy);
+    ar = horizontalSum(sr); ag = horizontalSum(sg); ab = horizontalSum(sb);
+    aw = horizontalSum(sw);
+#endif
+    for (; j < e; ++j) {
+        float dx = x[j] - xi, dy = y[j] - yi;
+        float r2 = dx*dx + dy*dy;
+        if (r2 <= 1e-6f) continue;
+        float r = sqrtf(r2);
+        float w = 1.0f - r * invH;
+        if (w <= 0.0f) continue;
+        float mag = w * ((pi + pressure[j]) + (pni + pressureNear[j]) * w);
+        float coef = mag * 0.5f / r;
+        ax -= coef * dx;
+        ay -= coef * dy;
+        ar += w * (cr[j] - ri);
+        ag += w * (cg[j] - gi);
+        ab += w * (cb[j] - bi);
+        aw += w;
+    }
+    out->dx += ax; out->dy += ay;
+    out->r += ar; out->g += ag; out->b += ab;
+    out->weight += aw;
+}
+
+#define BATTER_GRAIN 256        // particules par tranche de JobsParallelFor
+
+// 3) densités -> pressions, particules [begin, end)
+static void densityRange(int begin, int end, void *arg) {
+    (void)arg;
+    const float *x = posX[cur], *y = posY[cur];
+    int starts[3], ends[3];
+    for (int i = begin; i < end; ++i) {
+        float rho = 0.0f, rhoNear = 0.0f;
+        int n = neighbourRanges(x[i], y[i], starts, ends);
+        for (int k = 0; k < n; ++k) accumulateDensity(x[i], y[i], x, y, starts[k], ends[k], &rho, &rhoNear);
+        pressure[i] = STIFFNESS * (rho - REST_DENSITY);
+        pressureNear[i] = STIFFNESS_NEAR * rhoNear;
+    }
+}
+
+// 4) déplacements de relaxation et mélange (lecture seule de l'état courant)
+static void relaxationRange(int begin, int end, void *arg) {
+    const float dt = *(const float *)arg;
+    const float *x = posX[cur], *y = posY[cur];
+    int starts[3], ends[3];
+    for (int i = begin; i < end; ++i) {
+        Relaxation rel = { 0 };
+        int n = neighbourRanges(x[i], y[i], starts, ends);
+        for (int k = 0; k < n; ++k) accumulateRelaxation(i, starts[k], ends[k], &rel);
+        float len2 = rel.dx * rel.dx + rel.dy * rel.dy;
+        if (len2 > MAX_DISPLACEMENT * MAX_DISPLACEMENT) {
+            float s = MAX_DISPLACEMENT / sqrtf(len2);
+            rel.dx *= s;
+            rel.dy *= s;
+        }
+        dispX[i] = rel.dx;
+        dispY[i] = rel.dy;
+        // la pâte ne se mélange que lorsqu'elle bouge
+        float speed = sqrtf(velX[cur][i] * velX[cur][i] + velY[cur][i] * velY[cur][i]);
+        float agitation = fminf(fmaxf(speed - MIX_MIN_SPEED, 0.0f) / 120.0f, 1.0f);
+        float mix = rel.weight > 0.0f ? MIX_RATE * dt * agitation / rel.weight : 0.0f;
+        mixR[i] = rel.r * mix;
+        mixG[i] = rel.g * mix;
+        mixB[i] = rel.b * mix;
+    }
+}
+
+static void substep(float dt, const StepInput *in) {
+    // 1) forces externes (gravité, cuillère) et prédiction des positions
+    float stirR2 = STIR_RADIUS * STIR_RADIUS;
+    for (int i = 0; i < count; ++i) {
+        float vx = velX[cur][i], vy = velY[cur][i] + GRAVITY * dt;
+        if (in->stirActive) {
+            float dx = posX[cur][i] - in->stirPos.x, dy = posY[cur][i] - in->stirPos.y;
+            float d2 = dx*dx + dy*dy;
+            if (d2 < stirR2) {
+                float f = STIR_STRENGTH * (1.0f - sqrtf(d2) / STIR_RADIUS);
+                vx += (in->stirVel.x - vx) * f;
+                vy += (in->stirVel.y - vy) * f;
+            }
+        }
+        velX[cur][i] = vx * DAMPING;
+        velY[cur][i] = vy * DAMPING;
+        posX[cur][i] += velX[cur][i] * dt;
+        posY[cur][i] += velY[cur][i] * dt;
+    }
+
+    // 2) grille de voisinage
+    sortByCell();
+
+    // 3) et 4) : chaque particule ne lit que l'état courant (Jacobi), donc
+    // découpables en tranches indépendantes
+    JobsParallelFor(count, BATTER_GRAIN, densityRange, NULL);
+    JobsParallelFor(count, BATTER_GRAIN, relaxationRange, &dt);
+
+    // 5) application, bords du bol, vitesses (corrections de position / dt)
+    for (int i = 0; i < count; ++i) {
+        float ox = posX[cur][i], oy = posY[cur][i];
+        float nx = ox + dispX[i], ny = oy + dispY[i];
+        if (nx < BORDER) nx = BORDER; else if (nx > areaW - BORDER) nx = areaW - BORDER;
+        if (ny < BORDER) ny = BORDER; else if (ny > areaH - BORDER) ny = areaH - BORDER;
+        velX[cur][i] += (nx - ox) / dt;
+        velY[cur][i] += (ny - oy) / dt;
+        posX[cur][i] = nx;
+        posY[cur][i] = ny;
+        colR[cur][i] += mixR[i];
+        colG[cur][i] += mixG[i];
+        colB[cur][i] += mixB[i];
+    }
+}
+
+static void simulate(const StepInput *in) {
+    TRACE_SCOPE("batter.simulate");
+    if (count == 0 || in->dt <= 0.0f) return;
+    float dt = (in->dt > 1.0f / 30.0f ? 1.0f / 30.0f : in->dt) / SUBSTEPS;
+    for (int s = 0; s < SUBSTEPS; ++s) substep(dt, in);
+}
+
+static void stepJob(void *arg) {
+    simulate(arg);
+}
+
+// Attend la fin du pas en cours : les tableaux de simulation redeviennent accessibles
+static void waitIdle(void) {
+    JobsWait(&stepJobs);
+}
+
+static void publish(void) {
+    for (int i = 0; i < count; ++i) {
+        renderPos[i] = (Vector2){ posX[cur][i], posY[cur][i] };
+        renderColor[i] = (Color){ (unsigned char)colR[cur][i], (unsigned char)colG[cur][i], (unsigned char)colB[cur][i], 255 };
+    }
+    renderCount = count;
+}
+
+void BatterInit(float width, float height, bool useJobs) {
+    areaW = width;
+    areaH = height;
+    gridW = (int)(width / KERNEL_RADIUS) + 1;
+    gridH = (int)(height / KERNEL_RADIUS) + 1;
+    if (gridW * gridH > GRID_MAX_CELLS) gridH = GRID_MAX_CELLS / gridW;
+    count = 0;
+    renderCount = 0;
+    cur = 0;
+    pending = (StepInput){ 0 };
+
+    Image img = GenImageColor(DOT_SIZE, DOT_SIZE, BLANK);
+    ImageDrawCircle(&img, DOT_SIZE / 2, DOT_SIZE / 2, DOT_SIZE / 2, WHITE);
+    dot = LoadTextureFromImage(img);
+    UnloadImage(img);
+
+    threaded = useJobs && JobsWorkerCount() > 0;
+}
+
+void BatterShutdown(void) {
+    waitIdle();
+    UnloadTexture(dot);
+    count = 0;
+    renderCount = 0;
+}
+
+void BatterClear(void) {
+    waitIdle();
+    count = 0;
+    renderCount = 0;
+}
+
+int BatterAdd(int owner, Color color, int n, Vector2 at) {
+    waitIdle();
+    if (n > BATTER_MAX - count) n = BATTER_MAX - count;
+    // versées en petit disque, sans vitesse initiale
+    float radius = sqrtf((float)n) * 1.6f;
+    for (int k = 0; k < n; ++k) {
+        float a = (float)GetRandomValue(0, 6283) / 1000.0f;
+        float r = radius * sqrtf((float)GetRandomValue(0, 1000) / 1000.0f);
+        int i = count++;
+        posX[cur][i] = fminf(fmaxf(at.x + cosf(a) * r, BORDER), areaW - BORDER);
+        posY[cur][i] = fminf(fmaxf(at.y + sinf(a) * r, BORDER), areaH - BORDER);
+        velX[cur][i] = 0.0f;
+        velY[cur][i] = 0.0f;
+        colR[cur][i] = color.r;
+        colG[cur][i] = color.g;
+        colB[cur][i] = color.b;
+        owners[cur][i] = (short)owner;
+    }
+    publish();
+    return n;
+}
+
+void BatterRemoveOwner(int owner) {
+    waitIdle();
+    int kept = 0;
+    for (int i = 0; i < count; ++i) {
+        if (owners[cur][i] == owner) continue;
+        posX[cur][kept] = posX[cur][i]; posY[cur][kept] = posY[cur][i];
+        velX[cur][kept] = velX[cur][i]; velY[cur][kept] = velY[cur][i];
+        colR[cur][kept] = colR[cur][i]; colG[cur][kept] = colG[cur][i]; colB[cur][kept] = colB[cur][i];
+        owners[cur][kept] = owners[cur][i];
+        kept++;
+    }
+    count = kept;
+    publish();
+}
+
+void BatterSetStir(Vector2 pos, Vector2 velocity, bool active) {
+    pending.stirPos = pos;
+    pending.stirVel = velocity;
+    pending.stirActive = active;
+}
+
+void BatterStep(float dt) {
+    waitIdle();
+    job = pending;
+    job.dt = dt;
+    if (!threaded) {
+        simulate(&job);
+        publish();
+        return;
+    }
+    // on publie le pas précédent ; le suivant tourne pendant le dessin de cette frame
+    publish();
+    JobsRun(stepJob, &job, &stepJobs);
+}
+
+void BatterDraw(Vector2 origin) {
+    const float r = DOT_SIZE * 0.5f;
+    for (int i = 0; i < renderCount; ++i) {
+        DrawTextureV(dot, (Vector2){ origin.x + renderPos[i].x - r, origin.y + renderPos[i].y - r }, renderColor[i]);
+    }
+}
+
+int BatterCount(void) {
+    return renderCount;
+}
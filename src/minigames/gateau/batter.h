@@ -0,0 +1,33 @@
+#ifndef MINIGAME_GATEAU_BATTER_H
+#define MINIGAME_GATEAU_BATTER_H
+
+#include "raylib.h"
+#include <stdbool.h>
+
+// Pâte du gâteau : fluide à particules 2D (relaxation de double densité, façon
+// SPH simplifié) simulé dans le bol et mélangé à la souris. Recherche des voisins
+// par grille uniforme, boucles internes en SSE (repli scalaire), et pas de
+// simulation optionnellement lancé en job (engine/jobs.h) pendant le dessin.
+// Coordonnées locales au bol : (0,0) = coin haut-gauche.
+
+#define BATTER_MAX 4096
+#define BATTER_PER_INGREDIENT 96
+
+void BatterInit(float width, float height, bool useJobs);
+void BatterShutdown(void);
+void BatterClear(void);
+
+// Verse count particules de la couleur donnée autour de at ; owner permet de les retirer
+int BatterAdd(int owner, Color color, int count, Vector2 at);
+void BatterRemoveOwner(int owner);
+
+// Cuillère : position et vitesse (px/s) de la souris dans le bol
+void BatterSetStir(Vector2 pos, Vector2 velocity, bool active);
+
+// Publie l'état du pas précédent pour le dessin et lance le pas suivant
+void BatterStep(float dt);
+// Dessine le dernier état publié (jamais modifié par le job de simulation)
+void BatterDraw(Vector2 origin);
+int BatterCount(void);
+
+#endif // MINIGAME_GATEAU_BATTER_H
@@ -4,6 +4,13 @@
 
 #include "gateau.h"     // api du minigame (déjà présent dans le projet)
 #include "raylib.h"     // raylib pour fenêtre, textures, sons, entrées
+#include "engine/audio.h" // effets sonores (moteur audio global)
+#include "pick_index.h" // sélection ordonnée en profondeur (glisser-déposer)
+#include "item_atlas.h" // atlas procédural des objets (cache disque)
+#include "recipe.h"     // recettes (assets/gateau/recipes.ini) et calcul du score
+#include "batter.h"     // pâte à particules mélangée dans le bol
+#include "engine/config.h" // options ([gateau] dans config/default.ini)
+#include "engine/input.h" // clavier / souris (réels ou rejoués)
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
@@ -11,6 +18,7 @@
 #define ING_COUNT 20    // nombre d'ingrédients dans le frigo
 #define DECOR_COUNT 10  // nombre d'objets de décoration
 #define MAX_CAKE 20     // nombre max d'ingrédients dans le bol
+#define MAX_STAMPS 512  // historique des tampons (ingrédients + décors posés)
 
 // État du mini-jeu
 typedef enum {
@@ -24,7 +32,8 @@ typedef enum {
 // Représentation d'un ingrédient (ou décor)
 typedef struct {
     int id;                 // id simple: 1..ING_COUNT pour ingrédients, 1..DECOR_COUNT pour décors
-    Texture2D tex;          // texture (placeholder pour l'instant)
+    Texture2D tex;          // texture (l'atlas partagé des objets)
+    Rectangle src;          // zone de l'objet dans la texture
     Rectangle rect;         // rectangle d'affichage / interaction
     bool in_bol;            // vrai si déjà mis dans le bol (pour ingrédients)
     bool is_dragging;       // vrai si en cours de drag
@@ -32,22 +41,43 @@ typedef struct {
     float offset_y;
 } Item;
 
-// Sons (optionnel : chargez vos fichiers .wav/.ogg dans les chemins indiqués)
-static Sound s_open = {0};
-static Sound s_pick = {0};
-static Sound s_drop = {0};
-static Sound s_decor = {0};
-
 // Éléments du jeu
 static Item ingredients[ING_COUNT];   // tableau d'ingrédients
 static Item decors[DECOR_COUNT];      // tableau de décors
-static Item cake_items[MAX_CAKE];     // ingrédients déposés dans le bol (copie)
 static int cake_count = 0;            // nombre d'ingrédients dans le bol
 
+// Toile du gâteau : le bol et tout ce qui y est posé sont "cuits" dans une texture.
+// Chaque dépôt ajoute un tampon ; seuls les éléments en cours de drag restent dessinés en direct.
+typedef struct {
+    Texture2D tex;      // texture tamponnée (l'atlas des objets)
+    Rectangle src;      // zone dans la texture
+    Vector2 pos;        // position dans la toile
+    int ingredient;     // index de l'ingrédient (sa pâte porte cet index), -1 pour un décor
+    int decor;          // index du décor, -1 pour un ingrédient
+} Stamp;
+
+static RenderTexture2D cake_canvas;
+static Stamp stamps[MAX_STAMPS];
+static int stamp_count = 0;
+static int baked_count = 0;           // tampons déjà dessinés dans la toile
+static bool canvas_rebuild = true;    // vrai : repartir du fond (init, annulation)
+
+// Atlas des objets : généré une fois (ou relu depuis le cache disque), puis
+// conservé d'une session du mini-jeu à l'autre ; libéré par GateauShutdown
+static ItemAtlas item_atlas;
+
+// Index de sélection partagé par update et draw : tag < ING_COUNT -> ingrédient,
+// sinon décor (tag - ING_COUNT). L'ordre de la pile est l'ordre d'affichage.
+static PickIndex picks;
+static int dragging = -1;             // élément de picks en cours de drag (-1 : aucun)
+static Vector2 last_mouse;            // pour la vitesse de la cuillère
+
 // Etats et variables
 static GameState state = STATE_FRIDGE_CLOSED; // état courant
 static float fridge_open = 0.0f;    // animation ouverture 0.0..1.0
-static int score = 0;               // score du joueur
+static int score = 0;               // score du joueur (meilleure recette reconnue)
+static RecipeBook recipes;          // recettes chargées au lancement du mini-jeu
+static RecipeEval recipe_eval;      // état du gâteau pour chaque recette
 static Rectangle fridge_rect;       // zone du frigo
 static Rectangle bowl_rect;         // zone du bol (cible)
 static Rectangle score_rect;        // panneau score
@@ -55,50 +85,64 @@ static Font font_default;           // police par défaut (optionnel)
 
 // fonctions internes
 static void init_textures_and_items(void);
-static void unload_textures_and_sounds(void);
 static bool point_in_rect(Vector2 p, Rectangle r);
 static bool rects_overlap(Rectangle a, Rectangle b);
-static bool is_good_ingredient_combination(int id); // règle simple pour "bon gâteau"
+static Item *item_from_pick(int pick);
+static void set_state(GameState s);
+static void drop_item(int pick);
+static Rectangle ingredient_home(int i);
+static Rectangle decor_home(int i);
+static Color ingredient_color(int i);
+static bool push_stamp(const Item *it, Vector2 pos, int ingredient, int decor);
+static void undo_stamp(void);
+static void bake_canvas(void);
 
 // API minigame
 static void mg_init(void) {
-    // initialisation audio et police
-    InitAudioDevice();                    // initialise l'audio (safe si pas de son)
+    // police (l'audio est géré par le moteur global, démarré une fois dans main)
     font_default = GetFontDefault();      // police par défaut
 
-    // charger sons si vous avez des fichiers :
-    // s_open = LoadSound("assets/sfx/fridge_open.wav");
-    // s_pick = LoadSound("assets/sfx/pick.wav");
-    // s_drop = LoadSound("assets/sfx/drop.wav");
-    // s_decor = LoadSound("assets/sfx/decor.wav");
-    // Pour l'instant on laisse les Sound vides ; PlaySound fera rien si id invalide.
+    // sons : placez vos fichiers dans assets/sfx/ (fridge_open, pick, drop, decor .wav)
+    // ils sont préchargés au démarrage du jeu ; un son absent ne joue simplement rien.
 
     // définir rectangles d'interface (positions exprimées pour une fenêtre 800x450)
     fridge_rect = (Rectangle){ 20, 40, 200, 360 };  // frigo à gauche
     bowl_rect   = (Rectangle){ 300, 200, 200, 120 }; // bol au centre
     score_rect  = (Rectangle){ 540, 30, 220, 100 }; // panneau score à droite
 
-    // initialiser items (textures de substitution et positions)
+    // initialiser items (textures de substitution et positions) et l'index de sélection
+    dragging = -1;
     init_textures_and_items();
 
+    // pâte : simulée sur un thread pendant le dessin si l'option est active
+    BatterInit(bowl_rect.width, bowl_rect.height, ConfigReadBool("gateau", "batter_thread", true));
+    last_mouse = InputMousePosition();
+
+    // toile du gâteau (taille du bol), remplie au premier dessin
+    cake_canvas = LoadRenderTexture((int)bowl_rect.width, (int)bowl_rect.height);
+    stamp_count = 0;
+    baked_count = 0;
+    canvas_rebuild = true;
+
     // état initial
-    state = STATE_FRIDGE_CLOSED;
+    set_state(STATE_FRIDGE_CLOSED);
     fridge_open = 0.0f;
+    // recettes relues à chaque partie : un nouveau fichier ne demande pas de recompiler
+    RecipeBookLoad(&recipes, RECIPE_FILE);
+    RecipeEvalReset(&recipe_eval, &recipes);
     score = 0;
     cake_count = 0;
 }
 
 static void mg_update(float dt) {
-    // dt non utilisé de façon critique ici, mais on le garde pour animation
-    (void)dt;
-
-    Vector2 mouse = GetMousePosition(); // position souris
+    // dt sert à l'animation du frigo, à la vitesse de la cuillère et au pas de la pâte
+    Vector2 mouse = InputMousePosition(); // position souris
 
     // gestion ouverture du frigo : si fermé et clic sur frigo -> ouvrir
     if (state == STATE_FRIDGE_CLOSED) {
-        if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && point_in_rect(mouse, fridge_rect)) {
-            state = STATE_FRIDGE_OPENING;
-            // PlaySound(s_open); // jouer sons si chargés
+        if (InputMousePressed(MOUSE_LEFT_BUTTON) && point_in_rect(mouse, fridge_rect)) {
+            set_state(STATE_FRIDGE_OPENING);
+            AudioPlaySfx(SFX_FRIDGE_OPEN);
         }
     }
 
@@ -107,105 +151,69 @@ static void mg_update(float dt) {
         fridge_open += 4.0f * dt; // vitesse d'ouverture
         if (fridge_open >= 1.0f) {
             fridge_open = 1.0f;
-            state = STATE_MIXING; // on passe à la phase de mélange
+            set_state(STATE_MIXING); // on passe à la phase de mélange
         }
     }
 
     // mise à jour des items (drag & drop)
-    // ingrédients dans le frigo (uniquement accessibles si frigo ouvert)
-    for (int i = 0; i < ING_COUNT; ++i) {
-        Item *it = &ingredients[i];
-
-        // si frigo fermé, ne pas autoriser drag
-        if (state != STATE_MIXING && state != STATE_DECORATING) {
-            it->is_dragging = false;
-            continue;
-        }
-
-        // début du drag : clic sur item
-        if (!it->is_dragging) {
-            if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && point_in_rect(mouse, it->rect) && !it->in_bol) {
+    // un clic ne saisit que l'élément sélectionnable le plus haut sous la souris ;
+    // les éléments non sélectionnables (frigo fermé, déjà dans le bol...) sont désactivés dans picks
+    if (dragging < 0) {
+        if (InputMousePressed(MOUSE_LEFT_BUTTON)) {
+            int hit = PickIndexTop(&picks, mouse);
+            if (hit >= 0) {
+                Item *it = item_from_pick(hit);
+                dragging = hit;
                 it->is_dragging = true;
                 it->offset_x = mouse.x - it->rect.x;
                 it->offset_y = mouse.y - it->rect.y;
-                // PlaySound(s_pick);
+                PickIndexBringToFront(&picks, hit); // l'élément saisi passe au premier plan
+                AudioPlaySfx(SFX_PICK);
             }
+        }
+    } else {
+        Item *it = item_from_pick(dragging);
+        // on suit la souris tant que bouton maintenu
+        if (InputMouseDown(MOUSE_LEFT_BUTTON)) {
+            it->rect.x = mouse.x - it->offset_x;
+            it->rect.y = mouse.y - it->offset_y;
+            PickIndexMove(&picks, dragging, it->rect);
         } else {
-            // on suit la souris tant que bouton maintenu
-            if (IsMouseButtonDown(MOUSE_LEFT_BUTTON)) {
-                it->rect.x = mouse.x - it->offset_x;
-                it->rect.y = mouse.y - it->offset_y;
-            } else {
-                // relâché : vérifier où on a lâché
-                it->is_dragging = false;
-                // si on lâche dans le bol, on ajoute au cake
-                if (rects_overlap(it->rect, bowl_rect)) {
-                    if (!it->in_bol && cake_count < MAX_CAKE) {
-                        // marquer comme dans le bol et ajouter au cake_items
-                        it->in_bol = true;
-                        cake_items[cake_count++] = *it;
-                        // mise à jour du score simple :
-                        if (is_good_ingredient_combination(it->id)) {
-                            score += 20; // bon ingrédient -> +20
-                        } else {
-                            score -= 10; // mauvais ingrédient -> -10
-                        }
-                        // PlaySound(s_drop);
-                    }
-                } else {
-                    // si pas dans bol, on peut remettre l'ingrédient dans sa place d'origine
-                    // pour simplicité, on réinitialise la position d'affichage (à gauche)
-                    // la position d'origine est stockée via id -> calculez la grille
-                    int col = i % 5;
-                    int row = i / 5;
-                    float slot_w = (fridge_rect.width - 20) / 5.0f;
-                    float slot_h = 60;
-                    it->rect.x = fridge_rect.x + 10 + col * slot_w;
-                    it->rect.y = fridge_rect.y + 10 + row * (slot_h + 6);
-                }
-            }
+            // relâché : vérifier où on a lâché
+            it->is_dragging = false;
+            drop_item(dragging);
+            dragging = -1;
         }
     }
 
-    // décorations : phase DECORATING (après mélange)
-    for (int i = 0; i < DECOR_COUNT; ++i) {
-        Item *d = &decors[i];
-
-        if (state != STATE_DECORATING) {
-            d->is_dragging = false;
-            continue;
-        }
-
-        if (!d->is_dragging) {
-            if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && point_in_rect(mouse, d->rect)) {
-                d->is_dragging = true;
-                d->offset_x = mouse.x - d->rect.x;
-                d->offset_y = mouse.y - d->rect.y;
-                // PlaySound(s_pick);
-            }
-        } else {
-            if (IsMouseButtonDown(MOUSE_LEFT_BUTTON)) {
-                d->rect.x = mouse.x - d->offset_x;
-                d->rect.y = mouse.y - d->offset_y;
-            } else {
-                // relâché : on laisse la décoration où elle est (libre placement)
-                d->is_dragging = false;
-                // PlaySound(s_decor);
-            }
-        }
+    // Mélange : bouton maintenu dans le bol (hors drag) pendant la phase de mélange
+    Vector2 local = { mouse.x - bowl_rect.x, mouse.y - bowl_rect.y };
+    Vector2 stir_vel = { 0, 0 };
+    if (dt > 0.0f) stir_vel = (Vector2){ (mouse.x - last_mouse.x) / dt, (mouse.y - last_mouse.y) / dt };
+    bool stirring = state == STATE_MIXING && dragging < 0 && InputMouseDown(MOUSE_LEFT_BUTTON) && point_in_rect(mouse, bowl_rect);
+    BatterSetStir(local, stir_vel, stirring);
+    last_mouse = mouse;
+
+    // Annuler le dernier tampon (ingrédient ou décor) : Ctrl+Z
+    if ((state == STATE_MIXING || state == STATE_DECORATING) && dragging < 0) {
+        bool ctrl = InputKeyDown(KEY_LEFT_CONTROL) || InputKeyDown(KEY_RIGHT_CONTROL);
+        if (ctrl && InputKeyPressed(KEY_Z)) undo_stamp();
     }
 
     // Transition : lorsque on a mis des ingrédients, l'utilisateur peut appuyer sur Enter pour passer à décorer
     if (state == STATE_MIXING) {
-        if (IsKeyPressed(KEY_ENTER)) {
-            state = STATE_DECORATING;
+        if (InputKeyPressed(KEY_ENTER)) {
+            set_state(STATE_DECORATING);
         }
     }
 
+    // la pâte n'évolue que pendant le mélange ; ensuite elle est cuite dans la toile
+    if (state == STATE_MIXING) BatterStep(dt);
+
     // Fin : dans la phase décoration, l'utilisateur appuie sur BACKSPACE pour quitter le mini-jeu
     if (state == STATE_DECORATING || state == STATE_DONE) {
-        if (IsKeyPressed(KEY_BACKSPACE)) {
-            state = STATE_DONE;
+        if (InputKeyPressed(KEY_BACKSPACE)) {
+            set_state(STATE_DONE);
         }
     }
 }
@@ -213,6 +221,9 @@ static void mg_update(float dt) {
 static void mg_draw(void) {
     // dessin simple, clair et commenté
 
+    // 0) Mise à jour de la toile : seuls les nouveaux tampons sont dessinés
+    bake_canvas();
+
     // 1) Fond et panneaux
     ClearBackground(RAYWHITE); // fond blanc pâle
 
@@ -227,65 +238,70 @@ static void mg_draw(void) {
     DrawRectangleRec(door, DARKGRAY);
     DrawText("FRIGO", (int)(fridge_rect.x + 10), (int)(fridge_rect.y + 6), 20, WHITE);
 
-    // si frigo ouvert, afficher ingrédients (grille)
-    if (fridge_open >= 0.999f) {
-        for (int i = 0; i < ING_COUNT; ++i) {
-            Item *it = &ingredients[i];
-            // dessiner texture (ou rectangle de couleur)
-            DrawTextureRec(it->tex, (Rectangle){0,0,(float)it->tex.width,(float)it->tex.height}, (Vector2){it->rect.x, it->rect.y}, WHITE);
-            // affichage du numéro d'ingrédient pour repère
-            char label[8];
-            sprintf(label, "%d", it->id);
-            DrawText(label, (int)(it->rect.x + 6), (int)(it->rect.y + 6), 12, BLACK);
-            // si l'ingrédient est déjà dans le bol, on marque avec un petit X
-            if (it->in_bol) {
-                DrawText("OK", (int)(it->rect.x + it->rect.width - 24), (int)(it->rect.y + 6), 12, GREEN);
-            }
-        }
-    } else {
-        // si fermé, afficher un message simple
+    // si frigo fermé, afficher un message simple (les ingrédients sont dessinés plus bas)
+    if (fridge_open < 0.999f) {
         DrawText("Cliquez sur le frigo pour ouvrir", (int)(fridge_rect.x + 10), (int)(fridge_rect.y + fridge_rect.height - 30), 12, BLACK);
     }
 
-    // 3) Bol (centre)
-    DrawRectangleRec(bowl_rect, BEIGE);
-    DrawText("Bol", (int)(bowl_rect.x + 8), (int)(bowl_rect.y + 6), 18, BROWN);
-
-    // dessiner ingrédients déposés dans le bol (petites pastilles)
-    for (int i = 0; i < cake_count; ++i) {
-        // positionner en grille dans le bol
-        float cell_w = 36;
-        float cell_h = 36;
-        int cols = (int)(bowl_rect.width / (cell_w + 6));
-        int r = i / cols;
-        int c = i % cols;
-        float x = bowl_rect.x + 10 + c * (cell_w + 6);
-        float y = bowl_rect.y + 36 + r * (cell_h + 6);
-        DrawTextureRec(cake_items[i].tex, (Rectangle){0,0,(float)cake_items[i].tex.width,(float)cake_items[i].tex.height}, (Vector2){x,y}, WHITE);
-    }
+    // 3) Bol (centre) : fond, ingrédients et décors déjà posés viennent de la toile
+    // (hauteur négative : les render textures sont stockées à l'envers)
+    DrawTextureRec(cake_canvas.texture, (Rectangle){ 0, 0, bowl_rect.width, -bowl_rect.height }, (Vector2){ bowl_rect.x, bowl_rect.y }, WHITE);
+    // pendant le mélange, la pâte est dessinée en direct par-dessus
+    if (state < STATE_DECORATING) BatterDraw((Vector2){ bowl_rect.x, bowl_rect.y });
 
     // bouton pour terminer mélange (indication)
     DrawText("Appuyez sur ENTRER pour décorer", (int)(bowl_rect.x + 6), (int)(bowl_rect.y + bowl_rect.height - 22), 12, DARKGRAY);
 
-    // 4) Décorations (en haut centre) : toujours affichées, actives seulement en DECORATING
+    // 4) Ingrédients et décorations, dans l'ordre de la pile de picks (du fond vers le dessus) :
+    // l'élément saisi est ainsi toujours dessiné au premier plan, y compris au-dessus du bol.
+    // Décors (en haut centre) : toujours affichés, actifs seulement en DECORATING
     DrawText("Décors (glisser sur le gâteau)", 300, 10, 14, DARKGRAY);
-    for (int i = 0; i < DECOR_COUNT; ++i) {
-        Item *d = &decors[i];
-        DrawTextureRec(d->tex, (Rectangle){0,0,(float)d->tex.width,(float)d->tex.height}, (Vector2){d->rect.x, d->rect.y}, WHITE);
+    for (int k = 0; k < PickIndexCount(&picks); ++k) {
+        int pick = PickIndexAtDepth(&picks, k);
+        bool is_ingredient = picks.tag[pick] < ING_COUNT;
+        if (is_ingredient && fridge_open < 0.999f) continue; // ingrédients visibles frigo ouvert
+        Item *it = item_from_pick(pick);
+        Rectangle r = it->rect;
+        // l'élément saisi suit la souris relevée juste avant le dessin (late latch),
+        // plus fraîche que celle de la mise à jour
+        if (it->is_dragging) {
+            Vector2 mouse = InputMousePosition();
+            r.x = mouse.x - it->offset_x;
+            r.y = mouse.y - it->offset_y;
+        }
+        // dessiner texture (ou rectangle de couleur)
+        DrawTextureRec(it->tex, it->src, (Vector2){r.x, r.y}, WHITE);
+        if (is_ingredient) {
+            // affichage du numéro d'ingrédient pour repère
+            char label[8];
+            sprintf(label, "%d", it->id);
+            DrawText(label, (int)(r.x + 6), (int)(r.y + 6), 12, BLACK);
+            // si l'ingrédient est déjà dans le bol, on marque avec un petit X
+            if (it->in_bol) {
+                DrawText("OK", (int)(r.x + r.width - 24), (int)(r.y + 6), 12, GREEN);
+            }
+        }
     }
 
     // 5) Panneau score (droite)
     DrawRectangleRec(score_rect, LIGHTGRAY);
     DrawText("SCORE", (int)score_rect.x + 10, (int)score_rect.y + 6, 20, BLACK);
-    char buf[64];
+    char buf[96];
     sprintf(buf, "Points : %d", score);
     DrawText(buf, (int)score_rect.x + 10, (int)score_rect.y + 36, 16, DARKBLUE);
     sprintf(buf, "Ingrédients : %d", cake_count);
     DrawText(buf, (int)score_rect.x + 10, (int)score_rect.y + 60, 14, DARKBLUE);
+    // recette dont le gâteau se rapproche le plus
+    if (cake_count > 0) {
+        snprintf(buf, sizeof(buf), "Recette : %s", RecipeEvalName(&recipe_eval, &recipes));
+        DrawText(buf, (int)score_rect.x + 10, (int)score_rect.y + 80, 12, DARKGREEN);
+    }
 
     // 6) Indications d'aide
     DrawText("Backspace : retour au menu", 540, 140, 12, DARKGRAY);
     DrawText("EN : passer au décor", 540, 160, 12, DARKGRAY);
+    DrawText("Ctrl+Z : annuler le dernier dépôt", 540, 180, 12, DARKGRAY);
+    DrawText("Clic maintenu dans le bol : mélanger", 540, 200, 12, DARKGRAY);
 
     // si le frigo est en cours d'ouverture on peut dessiner une transition (optionnel)
     if (state == STATE_FRIDGE_OPENING) {
@@ -295,89 +311,211 @@ static void mg_draw(void) {
 }
 
 static void mg_unload(void) {
-    unload_textures_and_sounds();
-    CloseAudioDevice();
+    // l'atlas des objets reste chargé pour la prochaine partie
+    BatterShutdown();
+    UnloadRenderTexture(cake_canvas);
 }
 
 /* ----- fonctions utilitaires ----- */
 
-// crée des textures de substitution (Images colorées) et initialise positions
+// élément de jeu correspondant à une entrée de picks
+static Item *item_from_pick(int pick) {
+    int tag = picks.tag[pick];
+    return tag < ING_COUNT ? &ingredients[tag] : &decors[tag - ING_COUNT];
+}
+
+// change d'état et met à jour une fois les éléments sélectionnables
+// (plutôt que de tester l'état pour chaque élément à chaque frame)
+static void set_state(GameState s) {
+    state = s;
+    bool ing_active = (state == STATE_MIXING); // la pâte est cuite une fois au décor
+    bool decor_active = (state == STATE_DECORATING);
+    for (int k = 0; k < PickIndexCount(&picks); ++k) {
+        int tag = picks.tag[k];
+        bool active = tag < ING_COUNT ? (ing_active && !ingredients[tag].in_bol) : decor_active;
+        PickIndexSetEnabled(&picks, k, active);
+    }
+    // un drag en cours sur un élément devenu inactif est abandonné sur place
+    if (dragging >= 0 && !picks.enabled[dragging]) {
+        item_from_pick(dragging)->is_dragging = false;
+        dragging = -1;
+    }
+    // au passage au décor, la pâte figée est cuite dans la toile
+    if (state == STATE_DECORATING) canvas_rebuild = true;
+}
+
+// dépose l'élément relâché
+static void drop_item(int pick) {
+    int tag = picks.tag[pick];
+    if (tag >= ING_COUNT) {
+        // décor : posé sur le gâteau, il est tamponné dans la toile et le modèle
+        // retourne dans la palette (on peut en poser autant qu'on veut)
+        int d = tag - ING_COUNT;
+        Item *it = &decors[d];
+        if (rects_overlap(it->rect, bowl_rect)) {
+            Vector2 pos = { it->rect.x - bowl_rect.x, it->rect.y - bowl_rect.y };
+            if (push_stamp(it, pos, -1, d)) {
+                RecipeEvalDecor(&recipe_eval, &recipes, it->id);
+                score = RecipeEvalScore(&recipe_eval);
+                AudioPlaySfx(SFX_DECOR);
+            }
+        }
+        it->rect = decor_home(d);
+        PickIndexMove(&picks, pick, it->rect);
+        return;
+    }
+
+    int i = tag;
+    Item *it = &ingredients[i];
+    // si on lâche dans le bol, on ajoute au cake
+    if (rects_overlap(it->rect, bowl_rect)) {
+        if (!it->in_bol && cake_count < MAX_CAKE) {
+            // l'ingrédient est versé dans la pâte là où il a été lâché
+            Vector2 pos = { it->rect.x + it->rect.width * 0.5f - bowl_rect.x, it->rect.y + it->rect.height * 0.5f - bowl_rect.y };
+            if (push_stamp(it, pos, i, -1)) {
+                // marquer comme dans le bol
+                BatterAdd(i, ingredient_color(i), BATTER_PER_INGREDIENT, pos);
+                it->in_bol = true;
+                PickIndexSetEnabled(&picks, pick, false);
+                cake_count++;
+                // mise à jour incrémentale du score de chaque recette
+                RecipeEvalIngredient(&recipe_eval, &recipes, it->id);
+                score = RecipeEvalScore(&recipe_eval);
+                AudioPlaySfx(SFX_DROP);
+            }
+        }
+    }
+    // l'ingrédient retourne à sa place dans le frigo (marqué OK s'il est dans le bol)
+    it->rect = ingredient_home(i);
+    PickIndexMove(&picks, pick, it->rect);
+}
+
+// place d'origine d'un ingrédient : grille de 5 colonnes dans le frigo
+static Rectangle ingredient_home(int i) {
+    int col = i % 5;
+    int row = i / 5;
+    float slot_w = (fridge_rect.width - 20) / 5.0f;
+    float slot_h = 60;
+    Rectangle r = ingredients[i].rect;
+    r.x = fridge_rect.x + 10 + col * slot_w + 6; // petit offset
+    r.y = fridge_rect.y + 10 + row * (slot_h + 6) + 6;
+    return r;
+}
+
+// place d'un décor dans la palette, en ligne en haut
+static Rectangle decor_home(int i) {
+    Rectangle r = decors[i].rect;
+    r.x = 300 + i * (r.width + 8);
+    r.y = 40;
+    return r;
+}
+
+// couleur de la pâte d'un ingrédient (celle de sa case dans l'atlas)
+static Color ingredient_color(int i) {
+    if (i == 0) return (Color){ 92, 54, 34, 255 }; // chocolat
+    return ColorFromHSV((i * 18) % 360, 0.6f, 0.9f);
+}
+
+// ajoute un tampon à l'historique ; il sera dessiné dans la toile au prochain mg_draw
+static bool push_stamp(const Item *it, Vector2 pos, int ingredient, int decor) {
+    if (stamp_count >= MAX_STAMPS) return false;
+    stamps[stamp_count++] = (Stamp){ it->tex, it->src, pos, ingredient, decor };
+    return true;
+}
+
+// retire le dernier tampon ; un ingrédient retiré redevient disponible dans le frigo
+// (pendant le décor, seuls les décors s'annulent : la pâte est déjà cuite)
+static void undo_stamp(void) {
+    if (stamp_count == 0) return;
+    if (state == STATE_DECORATING && stamps[stamp_count - 1].ingredient >= 0) return;
+    Stamp *st = &stamps[--stamp_count];
+    if (st->ingredient >= 0) {
+        BatterRemoveOwner(st->ingredient);
+        ingredients[st->ingredient].in_bol = false;
+        cake_count--;
+        set_state(state); // réactive l'ingrédient dans picks
+    }
+    // les contraintes d'ordre ne se défont pas : on rejoue les dépôts restants (rare)
+    RecipeEvalReset(&recipe_eval, &recipes);
+    for (int i = 0; i < stamp_count; ++i) {
+        if (stamps[i].ingredient >= 0) RecipeEvalIngredient(&recipe_eval, &recipes, ingredients[stamps[i].ingredient].id);
+        else RecipeEvalDecor(&recipe_eval, &recipes, decors[stamps[i].decor].id);
+    }
+    score = RecipeEvalScore(&recipe_eval);
+    canvas_rebuild = true;
+}
+
+// dessine dans la toile les tampons pas encore cuits (tout, après une annulation)
+static void bake_canvas(void) {
+    if (!canvas_rebuild && baked_count == stamp_count) return;
+    BeginTextureMode(cake_canvas);
+    if (canvas_rebuild) {
+        // fond du bol : la toile est opaque, le mélange alpha des tampons reste donc exact
+        ClearBackground(BEIGE);
+        DrawText("Bol", 8, 6, 18, BROWN);
+        // pâte cuite : figée au passage au décor
+        if (state >= STATE_DECORATING) BatterDraw((Vector2){ 0, 0 });
+        baked_count = 0;
+        canvas_rebuild = false;
+    }
+    for (int i = baked_count; i < stamp_count; ++i) {
+        if (stamps[i].ingredient >= 0) continue; // les ingrédients sont dans la pâte
+        DrawTextureRec(stamps[i].tex, stamps[i].src, stamps[i].pos, WHITE);
+    }
+    EndTextureMode();
+    baked_count = stamp_count;
+}
+
+// initialise objets, positions et index de sélection ; les graphismes viennent de l'atlas
 static void init_textures_and_items(void) {
-    // générer 20 textures colorées simples pour ingrédients
+    PickIndexInit(&picks);
+
+    if (!item_atlas.ready) {
+        ItemCellDesc cells[ING_COUNT + DECOR_COUNT];
+        // 20 cases colorées simples pour les ingrédients (couleur selon l'id) avec
+        // un cercle blanc au centre pour variation visuelle
+        for (int i = 0; i < ING_COUNT; ++i) {
+            cells[i] = (ItemCellDesc){ 48, 48, ColorFromHSV((i * 18) % 360, 0.6f, 0.9f), 24, 24, 14, Fade(WHITE, 0.7f), NULL };
+        }
+        // Remplacer l'ingrédient 1 par l'image chocolat si disponible
+        // Chemin attendu: assets/gateau/chocolat.png
+        cells[0].imagePath = "assets/gateau/chocolat.png";
+        // décors : petit motif dans le coin
+        for (int i = 0; i < DECOR_COUNT; ++i) {
+            cells[ING_COUNT + i] = (ItemCellDesc){ 36, 36, ColorFromHSV((i * 36) % 360, 0.7f, 0.95f), 8, 8, 6, Fade(WHITE, 0.9f), NULL };
+        }
+        ItemAtlasLoad(&item_atlas, cells, ING_COUNT + DECOR_COUNT, "gateau_items");
+    }
+
     for (int i = 0; i < ING_COUNT; ++i) {
-        int w = 48;
-        int h = 48;
-        // couleur différente selon l'id (simple variation)
-        Color c = ColorFromHSV((i * 18) % 360, 0.6f, 0.9f);
-        Image img = GenImageColor(w, h, c);        // image unie
-        // dessiner un cercle blanc au centre pour variation visuelle
-        ImageDrawCircle(&img, w/2, h/2, 14, Fade(WHITE, 0.7f));
-        Texture2D tex = LoadTextureFromImage(img);
-        UnloadImage(img);
-        ingredients[i].tex = tex;
+        Rectangle src = item_atlas.cells[i];
+        ingredients[i].tex = item_atlas.texture;
+        ingredients[i].src = src;
         ingredients[i].id = i + 1;
         ingredients[i].in_bol = false;
         ingredients[i].is_dragging = false;
         // placer en grille dans le frigo (5 colonnes)
-        int col = i % 5;
-        int row = i / 5;
-        float slot_w = (fridge_rect.width - 20) / 5.0f;
-        float slot_h = 60;
-        ingredients[i].rect.width = (float)w;
-        ingredients[i].rect.height = (float)h;
-        ingredients[i].rect.x = fridge_rect.x + 10 + col * slot_w;
-        ingredients[i].rect.y = fridge_rect.y + 10 + row * (slot_h + 6);
-        ingredients[i].rect.x += 6; // petit offset
-        ingredients[i].rect.y += 6;
+        ingredients[i].rect.width = src.width;
+        ingredients[i].rect.height = src.height;
+        ingredients[i].rect = ingredient_home(i);
     }
 
-    // Remplacer l'ingrédient 1 par l'image chocolat si disponible
-    // Chemin attendu: assets/gateau/chocolat.png
-    {
-        Image img = LoadImage("assets/gateau/chocolat.png");
-        if (img.data) {
-            // Libérer la texture générée pour l'ingrédient 1
-            UnloadTexture(ingredients[0].tex);
-            ingredients[0].tex = LoadTextureFromImage(img);
-            UnloadImage(img);
-        }
-    }
-
-    // générer textures pour décors
     for (int i = 0; i < DECOR_COUNT; ++i) {
-        int w = 36;
-        int h = 36;
-        Color c = ColorFromHSV((i * 36) % 360, 0.7f, 0.95f);
-        Image img = GenImageColor(w, h, c);
-        // ajout d'un petit motif
-        ImageDrawCircle(&img, 8, 8, 6, Fade(WHITE, 0.9f));
-        Texture2D tex = LoadTextureFromImage(img);
-        UnloadImage(img);
-        decors[i].tex = tex;
+        Rectangle src = item_atlas.cells[ING_COUNT + i];
+        decors[i].tex = item_atlas.texture;
+        decors[i].src = src;
         decors[i].id = i + 1;
         decors[i].in_bol = false;
         decors[i].is_dragging = false;
         // position initiale en haut, organisé en ligne
-        decors[i].rect.width = (float)w;
-        decors[i].rect.height = (float)h;
-        decors[i].rect.x = 300 + i * (w + 8);
-        decors[i].rect.y = 40;
+        decors[i].rect.width = src.width;
+        decors[i].rect.height = src.height;
+        decors[i].rect = decor_home(i);
     }
-}
 
-// libération des textures et sons
-static void unload_textures_and_sounds(void) {
-    for (int i = 0; i < ING_COUNT; ++i) {
-        UnloadTexture(ingredients[i].tex);
-    }
-    for (int i = 0; i < DECOR_COUNT; ++i) {
-        UnloadTexture(decors[i].tex);
-    }
-    // si vous avez chargé des sons, déchargez-les :
-    // UnloadSound(s_open);
-    // UnloadSound(s_pick);
-    // UnloadSound(s_drop);
-    // UnloadSound(s_decor);
+    // enregistrement dans l'index : ingrédients puis décors (par-dessus)
+    for (int i = 0; i < ING_COUNT; ++i) PickIndexAdd(&picks, ingredients[i].rect, i);
+    for (int i = 0; i < DECOR_COUNT; ++i) PickIndexAdd(&picks, decors[i].rect, ING_COUNT + i);
 }
 
 // utilitaire : point dans rectangle
@@ -390,21 +528,14 @@ static bool rects_overlap(Rectangle a, Rectangle b) {
     return (a.x < b.x + b.width && a.x + a.width > b.x && a.y < b.y + b.height && a.y + a.height > b.y);
 }
 
-// règle simple : retourne vrai si l'ingrédient est "bon"
-// ici on définit une petite liste d'ids "bons" pour simuler la combinaison
-static bool is_good_ingredient_combination(int id) {
-    // ingrédients "bons" (exemple) : {2,5,7,11,13}
-    const int good[] = {2,5,7,11,13};
-    for (size_t i = 0; i < sizeof(good)/sizeof(good[0]); ++i) {
-        if (good[i] == id) return true;
-    }
-    return false;
-}
-
 // fonction d'export pour l'API du projet
 MinigameAPI GetMinigameGateau(void) {
     MinigameAPI api = { mg_init, mg_update, mg_draw, mg_unload };
     return api;
 }
 
+void GateauShutdown(void) {
+    ItemAtlasUnload(&item_atlas);
+}
+
 
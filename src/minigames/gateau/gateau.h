@@ -4,6 +4,8 @@
 #include "minigame.h"
 
 MinigameAPI GetMinigameGateau(void);
+// Ressources gardées d'une partie à l'autre (atlas des objets), à la fermeture du jeu
+void GateauShutdown(void);
 
 #endif // MINIGAME_GATEAU_H
 
@@ -0,0 +1,121 @@
+// Atlas procédural des objets du gâteau, avec cache disque
+#include "item_atlas.h"
+#include "engine/trace.h"
+#include <stdio.h>
+#include <string.h>
+
+#define ATLAS_VERSION 1       // à incrémenter si l'algorithme de génération change
+#define ATLAS_MAX_WIDTH 512
+#define ATLAS_PADDING 2       // marge entre cases (évite les débordements au filtrage)
+
+static unsigned long long hashBytes(unsigned long long h, const void *data, size_t size) {
+    const unsigned char *p = (const unsigned char *)data;
+    for (size_t i = 0; i < size; ++i) {
+        h ^= p[i];
+        h *= 1099511628211ULL; // FNV-1a 64 bits
+    }
+    return h;
+}
+
+static unsigned long long hashInt(unsigned long long h, long v) {
+    return hashBytes(h, &v, sizeof(v));
+}
+
+// Hash de tout ce qui influence les pixels de l'atlas
+static unsigned long long hashCells(const ItemCellDesc *cells, int count) {
+    unsigned long long h = 14695981039346656037ULL;
+    h = hashInt(h, ATLAS_VERSION);
+    h = hashInt(h, count);
+    for (int i = 0; i < count; ++i) {
+        const ItemCellDesc *c = &cells[i];
+        h = hashInt(h, c->w);
+        h = hashInt(h, c->h);
+        h = hashBytes(h, &c->base, sizeof(c->base));
+        h = hashInt(h, c->circleX);
+        h = hashInt(h, c->circleY);
+        h = hashInt(h, (long)(c->radius * 1000.0f));
+        h = hashBytes(h, &c->circle, sizeof(c->circle));
+        if (c->imagePath && FileExists(c->imagePath)) {
+            // image remplaçante : son chemin et sa date de modification
+            h = hashBytes(h, c->imagePath, strlen(c->imagePath));
+            h = hashInt(h, GetFileModTime(c->imagePath));
+        }
+    }
+    return h;
+}
+
+// Rangement en étagères : calculé à l'identique que l'atlas vienne du cache ou non
+static void layoutCells(ItemAtlas *atlas, const ItemCellDesc *cells, int count, int *width, int *height) {
+    int x = 0, y = 0, shelf = 0, maxW = 0;
+    for (int i = 0; i < count; ++i) {
+        if (x > 0 && x + cells[i].w > ATLAS_MAX_WIDTH) {
+            x = 0;
+            y += shelf + ATLAS_PADDING;
+            shelf = 0;
+        }
+        atlas->cells[i] = (Rectangle){ (float)x, (float)y, (float)cells[i].w, (float)cells[i].h };
+        x += cells[i].w + ATLAS_PADDING;
+        if (cells[i].h > shelf) shelf = cells[i].h;
+        if (x > maxW) maxW = x;
+    }
+    *width = maxW;
+    *height = y + shelf;
+}
+
+static Image generateAtlas(const ItemAtlas *atlas, const ItemCellDesc *cells, int count, int width, int height) {
+    Image img = GenImageColor(width, height, BLANK);
+    for (int i = 0; i < count; ++i) {
+        const ItemCellDesc *c = &cells[i];
+        Rectangle dst = atlas->cells[i];
+        if (c->imagePath && FileExists(c->imagePath)) {
+            Image src = LoadImage(c->imagePath);
+            if (src.data) {
+                ImageDraw(&img, src, (Rectangle){ 0, 0, (float)src.width, (float)src.height }, dst, WHITE);
+                UnloadImage(src);
+                continue;
+            }
+        }
+        // case unie + disque, comme les anciennes textures de substitution
+        Image cell = GenImageColor(c->w, c->h, c->base);
+        ImageDrawCircle(&cell, c->circleX, c->circleY, (int)c->radius, c->circle);
+        ImageDraw(&img, cell, (Rectangle){ 0, 0, (float)c->w, (float)c->h }, dst, WHITE);
+        UnloadImage(cell);
+    }
+    return img;
+}
+
+bool ItemAtlasLoad(ItemAtlas *atlas, const ItemCellDesc *cells, int count, const char *cacheName) {
+    TRACE_SCOPE("asset.item_atlas");
+    if (count > ITEM_ATLAS_MAX) count = ITEM_ATLAS_MAX;
+    int width, height;
+    layoutCells(atlas, cells, count, &width, &height);
+    atlas->count = count;
+
+    char path[256];
+    snprintf(path, sizeof(path), "%s/%s_%016llx.png", ITEM_ATLAS_CACHE_DIR, cacheName, hashCells(cells, count));
+
+    Image img = { 0 };
+    if (FileExists(path)) {
+        img = LoadImage(path);
+        if (img.data && (img.width != width || img.height != height)) {
+            UnloadImage(img); // cache incohérent : on régénère
+            img = (Image){ 0 };
+        }
+    }
+    if (!img.data) {
+        img = generateAtlas(atlas, cells, count, width, height);
+        if (!DirectoryExists(ITEM_ATLAS_CACHE_DIR)) MakeDirectory(ITEM_ATLAS_CACHE_DIR);
+        ExportImage(img, path); // en cas d'échec, l'atlas sera simplement régénéré la prochaine fois
+    }
+
+    atlas->texture = LoadTextureFromImage(img);
+    UnloadImage(img);
+    atlas->ready = IsTextureValid(atlas->texture);
+    return atlas->ready;
+}
+
+void ItemAtlasUnload(ItemAtlas *atlas) {
+    if (atlas->ready) UnloadTexture(atlas->texture);
+    atlas->ready = false;
+    atlas->count = 0;
+}
@@ -0,0 +1,35 @@
+#ifndef MINIGAME_GATEAU_ITEM_ATLAS_H
+#define MINIGAME_GATEAU_ITEM_ATLAS_H
+
+#include "raylib.h"
+
+// Atlas des graphismes procéduraux des objets (ingrédients, décors).
+// Généré une seule fois, mis en cache sur disque sous un nom dérivé d'un hash
+// des paramètres de génération, puis envoyé au GPU en une seule texture.
+
+#define ITEM_ATLAS_MAX 64
+#define ITEM_ATLAS_CACHE_DIR "cache"
+
+// Description d'une case : carré uni + disque, ou image remplaçante si elle existe
+typedef struct {
+    int w, h;
+    Color base;              // couleur de fond
+    int circleX, circleY;    // centre du disque (dans la case)
+    float radius;
+    Color circle;
+    const char *imagePath;   // optionnel : image redimensionnée à la case
+} ItemCellDesc;
+
+typedef struct {
+    Texture2D texture;
+    Rectangle cells[ITEM_ATLAS_MAX]; // zone de chaque case dans la texture
+    int count;
+    bool ready;
+} ItemAtlas;
+
+// Charge l'atlas depuis le cache (ou le génère et l'y écrit) : un seul envoi GPU.
+// cacheName préfixe le fichier de cache (ex. "gateau_items").
+bool ItemAtlasLoad(ItemAtlas *atlas, const ItemCellDesc *cells, int count, const char *cacheName);
+void ItemAtlasUnload(ItemAtlas *atlas);
+
+#endif // MINIGAME_GATEAU_ITEM_ATLAS_H
@@ -0,0 +1,133 @@
+// Index de sélection : grille uniforme + pile d'ordre d'affichage
+#include "pick_index.h"
+#include <string.h>
+
+static int clampCell(int v, int hi) {
+    return v < 0 ? 0 : (v > hi ? hi : v);
+}
+
+static bool containsPoint(Rectangle r, Vector2 p) {
+    return p.x >= r.x && p.x <= r.x + r.width && p.y >= r.y && p.y <= r.y + r.height;
+}
+
+static void cellRange(Rectangle r, int *x0, int *y0, int *x1, int *y1) {
+    *x0 = clampCell((int)(r.x / PICK_CELL), PICK_GRID_W - 1);
+    *y0 = clampCell((int)(r.y / PICK_CELL), PICK_GRID_H - 1);
+    *x1 = clampCell((int)((r.x + r.width) / PICK_CELL), PICK_GRID_W - 1);
+    *y1 = clampCell((int)((r.y + r.height) / PICK_CELL), PICK_GRID_H - 1);
+}
+
+static void insertCells(PickIndex *pi, int item) {
+    int x0, y0, x1, y1;
+    cellRange(pi->rect[item], &x0, &y0, &x1, &y1);
+    pi->cellX0[item] = (short)x0; pi->cellY0[item] = (short)y0;
+    pi->cellX1[item] = (short)x1; pi->cellY1[item] = (short)y1;
+
+    pi->large[item] = (x1 - x0 + 1) * (y1 - y0 + 1) > PICK_MAX_CELLS_PER_ITEM;
+    if (pi->large[item]) {
+        pi->largeItems[pi->largeCount++] = (short)item;
+        return;
+    }
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+            short n = pi->freeNode;
+            pi->freeNode = pi->nodes[n].next;
+            pi->nodes[n].item = (short)item;
+            pi->nodes[n].next = pi->cellHead[y][x];
+            pi->cellHead[y][x] = n;
+        }
+    }
+}
+
+static void removeCells(PickIndex *pi, int item) {
+    if (pi->large[item]) {
+        for (int i = 0; i < pi->largeCount; ++i) {
+            if (pi->largeItems[i] == item) { pi->largeItems[i] = pi->largeItems[--pi->largeCount]; break; }
+        }
+        return;
+    }
+    for (int y = pi->cellY0[item]; y <= pi->cellY1[item]; ++y) {
+        for (int x = pi->cellX0[item]; x <= pi->cellX1[item]; ++x) {
+            short *link = &pi->cellHead[y][x];
+            while (*link >= 0) {
+                short n = *link;
+                if (pi->nodes[n].item == item) {
+                    *link = pi->nodes[n].next;
+                    pi->nodes[n].next = pi->freeNode;
+                    pi->freeNode = n;
+                    break;
+                }
+                link = &pi->nodes[n].next;
+            }
+        }
+    }
+}
+
+void PickIndexInit(PickIndex *pi) {
+    pi->count = 0;
+    pi->largeCount = 0;
+    memset(pi->cellHead, 0xFF, sizeof(pi->cellHead)); // -1 : cellule vide
+    for (int i = 0; i < PICK_MAX_NODES; ++i) pi->nodes[i].next = (short)(i + 1 < PICK_MAX_NODES ? i + 1 : -1);
+    pi->freeNode = 0;
+}
+
+int PickIndexAdd(PickIndex *pi, Rectangle rect, int tag) {
+    if (pi->count >= PICK_MAX_ITEMS) return -1;
+    int item = pi->count++;
+    pi->rect[item] = rect;
+    pi->tag[item] = tag;
+    pi->enabled[item] = true;
+    pi->depth[item] = item;
+    pi->order[item] = item;
+    insertCells(pi, item);
+    return item;
+}
+
+void PickIndexMove(PickIndex *pi, int item, Rectangle rect) {
+    if (item < 0 || item >= pi->count) return;
+    pi->rect[item] = rect;
+    // Même couverture de cellules : rien à réindexer
+    int x0, y0, x1, y1;
+    cellRange(rect, &x0, &y0, &x1, &y1);
+    if (x0 == pi->cellX0[item] && y0 == pi->cellY0[item] && x1 == pi->cellX1[item] && y1 == pi->cellY1[item]) return;
+    removeCells(pi, item);
+    insertCells(pi, item);
+}
+
+void PickIndexSetEnabled(PickIndex *pi, int item, bool enabled) {
+    if (item >= 0 && item < pi->count) pi->enabled[item] = enabled;
+}
+
+void PickIndexBringToFront(PickIndex *pi, int item) {
+    if (item < 0 || item >= pi->count) return;
+    for (int d = pi->depth[item]; d < pi->count - 1; ++d) {
+        pi->order[d] = pi->order[d + 1];
+        pi->depth[pi->order[d]] = d;
+    }
+    pi->order[pi->count - 1] = item;
+    pi->depth[item] = pi->count - 1;
+}
+
+int PickIndexTop(const PickIndex *pi, Vector2 p) {
+    int best = -1;
+    int bestDepth = -1;
+    int cx = (int)(p.x / PICK_CELL);
+    int cy = (int)(p.y / PICK_CELL);
+    if (p.x >= 0 && p.y >= 0 && cx < PICK_GRID_W && cy < PICK_GRID_H) {
+        for (short n = pi->cellHead[cy][cx]; n >= 0; n = pi->nodes[n].next) {
+            int item = pi->nodes[n].item;
+            if (pi->enabled[item] && pi->depth[item] > bestDepth && containsPoint(pi->rect[item], p)) {
+                best = item;
+                bestDepth = pi->depth[item];
+            }
+        }
+    }
+    for (int i = 0; i < pi->largeCount; ++i) {
+        int item = pi->largeItems[i];
+        if (pi->enabled[item] && pi->depth[item] > bestDepth && containsPoint(pi->rect[item], p)) {
+            best = item;
+            bestDepth = pi->depth[item];
+        }
+    }
+    return best;
+}
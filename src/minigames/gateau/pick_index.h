@@ -0,0 +1,54 @@
+#ifndef MINIGAME_GATEAU_PICK_INDEX_H
+#define MINIGAME_GATEAU_PICK_INDEX_H
+
+#include "raylib.h"
+
+// Index de sélection ordonné en profondeur pour le glisser-déposer.
+// Une grille uniforme répartit les éléments par cellule ; une pile d'ordre
+// d'affichage (partagée par update et draw) donne l'élément du dessus.
+
+#define PICK_MAX_ITEMS 512
+#define PICK_CELL 64                // taille d'une cellule (px)
+#define PICK_GRID_W 32              // 2048 px
+#define PICK_GRID_H 18              // 1152 px
+#define PICK_MAX_CELLS_PER_ITEM 9   // au-delà : liste des grands éléments
+#define PICK_MAX_NODES (PICK_MAX_ITEMS * PICK_MAX_CELLS_PER_ITEM)
+
+typedef struct {
+    short item;
+    short next;
+} PickNode;
+
+typedef struct {
+    Rectangle rect[PICK_MAX_ITEMS];
+    int tag[PICK_MAX_ITEMS];         // identifiant côté jeu
+    bool enabled[PICK_MAX_ITEMS];    // sélectionnable
+    short cellX0[PICK_MAX_ITEMS], cellY0[PICK_MAX_ITEMS];
+    short cellX1[PICK_MAX_ITEMS], cellY1[PICK_MAX_ITEMS];
+    bool large[PICK_MAX_ITEMS];
+    int depth[PICK_MAX_ITEMS];       // position dans order[]
+    int order[PICK_MAX_ITEMS];       // ordre d'affichage : order[0] au fond
+    int count;
+
+    short cellHead[PICK_GRID_H][PICK_GRID_W];
+    PickNode nodes[PICK_MAX_NODES];
+    short freeNode;
+    short largeItems[PICK_MAX_ITEMS];
+    int largeCount;
+} PickIndex;
+
+void PickIndexInit(PickIndex *pi);
+// Ajoute un élément au sommet de la pile, retourne son identifiant (-1 si plein)
+int PickIndexAdd(PickIndex *pi, Rectangle rect, int tag);
+void PickIndexMove(PickIndex *pi, int item, Rectangle rect);
+void PickIndexSetEnabled(PickIndex *pi, int item, bool enabled);
+void PickIndexBringToFront(PickIndex *pi, int item);
+
+// Élément sélectionnable le plus haut sous p (-1 si aucun) : une cellule visitée
+int PickIndexTop(const PickIndex *pi, Vector2 p);
+
+// Parcours dans l'ordre d'affichage (du fond vers le dessus)
+static inline int PickIndexCount(const PickIndex *pi) { return pi->count; }
+static inline int PickIndexAtDepth(const PickIndex *pi, int depth) { return pi->order[depth]; }
+
+#endif // MINIGAME_GATEAU_PICK_INDEX_H
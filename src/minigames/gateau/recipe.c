@@ -0,0 +1,172 @@
+// Recettes : lecture du fichier de données et évaluation incrémentale
+#include "recipe.h"
+#include "engine/trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void trimLine(char *s) {
+    size_t n = strlen(s);
+    while (n > 0 && (s[n-1] == '\n' || s[n-1] == '\r' || s[n-1] == ' ' || s[n-1] == '\t')) s[--n] = '\0';
+}
+
+static unsigned int idBit(int id) {
+    return (id >= 1 && id <= RECIPE_MAX_ID) ? 1u << (id - 1) : 0u;
+}
+
+static void initRecipe(Recipe *r, const char *name) {
+    memset(r, 0, sizeof(*r));
+    snprintf(r->name, sizeof(r->name), "%s", name);
+    memset(r->chainPos, -1, sizeof(r->chainPos));
+    r->pointsGood = 20;
+    r->pointsBad = -10;
+    r->pointsForbidden = -30;
+    r->pointsComplete = 50;
+    r->pointsOrder = 15;
+    r->pointsOrderBroken = -15;
+}
+
+// "2,5,7" -> masque de bits
+static unsigned int parseSet(const char *list) {
+    char buf[256];
+    snprintf(buf, sizeof(buf), "%s", list);
+    unsigned int mask = 0;
+    for (char *tok = strtok(buf, ", "); tok; tok = strtok(NULL, ", ")) mask |= idBit(atoi(tok));
+    return mask;
+}
+
+// "1>2>5" : 1 avant 2, 2 avant 5
+static void parseOrder(Recipe *r, const char *spec) {
+    if (r->chainCount >= RECIPE_MAX_CHAINS) return;
+    int c = r->chainCount;
+    char buf[256];
+    snprintf(buf, sizeof(buf), "%s", spec);
+    int len = 0;
+    for (char *tok = strtok(buf, "> "); tok && len < RECIPE_CHAIN_LEN; tok = strtok(NULL, "> ")) {
+        int id = atoi(tok);
+        if (!idBit(id) || r->chainPos[c][id] >= 0) continue;
+        r->chainPos[c][id] = (signed char)len++;
+    }
+    if (len < 2) {
+        memset(r->chainPos[c], -1, sizeof(r->chainPos[c]));
+        return;
+    }
+    r->chainLen[c] = (unsigned char)len;
+    r->chainCount++;
+}
+
+// Recette intégrée, équivalente à l'ancienne règle fixe
+static void defaultRecipe(Recipe *r) {
+    initRecipe(r, "Gateau du jour");
+    r->good = parseSet("2,5,7,11,13");
+}
+
+int RecipeBookLoad(RecipeBook *book, const char *path) {
+    TRACE_SCOPE("asset.recipes");
+    memset(book, 0, sizeof(*book));
+    FILE *f = fopen(path, "r");
+    if (f) {
+        Recipe *r = NULL;
+        char line[256];
+        while (fgets(line, sizeof(line), f)) {
+            trimLine(line);
+            if (line[0] == '#' || line[0] == '\0') continue;
+            char name[RECIPE_NAME_LEN];
+            char value[200];
+            int a, b;
+            if (sscanf(line, "[recipe %47[^]]]", name) == 1) {
+                r = NULL;
+                if (book->count >= RECIPE_MAX) continue;
+                r = &book->recipes[book->count++];
+                initRecipe(r, name);
+            } else if (!r) {
+                continue;
+            } else if (sscanf(line, "require=%199[^\n]", value) == 1) {
+                r->required |= parseSet(value);
+            } else if (sscanf(line, "allow=%199[^\n]", value) == 1) {
+                r->good |= parseSet(value);
+            } else if (sscanf(line, "forbid=%199[^\n]", value) == 1) {
+                r->forbidden |= parseSet(value);
+            } else if (sscanf(line, "order=%199[^\n]", value) == 1) {
+                parseOrder(r, value);
+            } else if (sscanf(line, "decor=%d:%d", &a, &b) == 2) {
+                if (idBit(a)) r->decorBonus[a] = b;
+            } else if (strncmp(line, "points=", 7) == 0) {
+                // valeurs absentes en fin de liste : on garde celles par défaut
+                sscanf(line + 7, "%d,%d,%d,%d,%d,%d", &r->pointsGood, &r->pointsBad, &r->pointsForbidden,
+                       &r->pointsComplete, &r->pointsOrder, &r->pointsOrderBroken);
+            }
+        }
+        fclose(f);
+    }
+    for (int i = 0; i < book->count; ++i) {
+        Recipe *r = &book->recipes[i];
+        r->good |= r->required;
+        r->good &= ~r->forbidden;
+    }
+    if (book->count == 0) {
+        defaultRecipe(&book->recipes[0]);
+        book->count = 1;
+    }
+    return book->count;
+}
+
+void RecipeEvalReset(RecipeEval *ev, const RecipeBook *book) {
+    (void)book;
+    memset(ev, 0, sizeof(*ev));
+}
+
+static void updateBest(RecipeEval *ev, const RecipeBook *book) {
+    int best = 0;
+    for (int i = 1; i < book->count; ++i) {
+        if (ev->score[i] > ev->score[best]) best = i;
+    }
+    ev->best = best;
+}
+
+int RecipeEvalIngredient(RecipeEval *ev, const RecipeBook *book, int id) {
+    unsigned int bit = idBit(id);
+    if (!bit || (ev->ingredients & bit)) return 0;
+    int before = RecipeEvalScore(ev);
+    ev->ingredients |= bit;
+
+    for (int i = 0; i < book->count; ++i) {
+        const Recipe *r = &book->recipes[i];
+        int delta;
+        if (r->forbidden & bit) delta = r->pointsForbidden;
+        else if (r->good & bit) delta = r->pointsGood;
+        else delta = r->pointsBad;
+
+        // recette complète : tous les requis présents (une seule fois)
+        if (!ev->complete[i] && r->required && (ev->ingredients & r->required) == r->required) {
+            ev->complete[i] = true;
+            delta += r->pointsComplete;
+        }
+
+        // contraintes d'ordre : chaque chaîne attend son prochain ingrédient
+        for (int c = 0; c < r->chainCount; ++c) {
+            int pos = r->chainPos[c][id];
+            signed char *state = &ev->chainState[i][c];
+            if (pos < 0 || *state < 0) continue;
+            if (pos == *state) {
+                if (++*state == r->chainLen[c]) delta += r->pointsOrder;
+            } else {
+                *state = -1; // un ingrédient plus loin dans la chaîne est arrivé trop tôt
+                delta += r->pointsOrderBroken;
+            }
+        }
+        ev->score[i] += delta;
+    }
+    updateBest(ev, book);
+    return RecipeEvalScore(ev) - before;
+}
+
+int RecipeEvalDecor(RecipeEval *ev, const RecipeBook *book, int id) {
+    unsigned int bit = idBit(id);
+    if (!bit || (ev->decors & bit)) return 0; // bonus une fois par sorte de décor
+    int before = RecipeEvalScore(ev);
+    ev->decors |= bit;
+    for (int i = 0; i < book->count; ++i) ev->score[i] += book->recipes[i].decorBonus[id];
+    updateBest(ev, book);
+    return RecipeEvalScore(ev) - before;
+}
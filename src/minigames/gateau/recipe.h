@@ -0,0 +1,61 @@
+#ifndef MINIGAME_GATEAU_RECIPE_H
+#define MINIGAME_GATEAU_RECIPE_H
+
+#include <stdbool.h>
+
+// Moteur de recettes du gâteau, décrit dans un fichier de données
+// (assets/gateau/recipes.ini, relu à chaque lancement du mini-jeu).
+// Chaque recette est compilée en masques de bits (ingrédients requis / interdits)
+// et en petites machines à états (contraintes d'ordre) : un dépôt met à jour
+// le score de toutes les recettes en temps constant.
+
+#define RECIPE_FILE "assets/gateau/recipes.ini"
+#define RECIPE_MAX 8
+#define RECIPE_MAX_ID 32          // ids d'ingrédients / décors : 1..32 (un bit chacun)
+#define RECIPE_MAX_CHAINS 4       // contraintes d'ordre par recette
+#define RECIPE_CHAIN_LEN 8
+#define RECIPE_NAME_LEN 48
+
+typedef struct {
+    char name[RECIPE_NAME_LEN];
+    unsigned int required;                   // bit (id - 1)
+    unsigned int forbidden;
+    unsigned int good;                       // requis + autorisés
+    // chainPos[c][id] : rang de l'ingrédient dans la chaîne c (-1 : absent)
+    signed char chainPos[RECIPE_MAX_CHAINS][RECIPE_MAX_ID + 1];
+    unsigned char chainLen[RECIPE_MAX_CHAINS];
+    int chainCount;
+    int decorBonus[RECIPE_MAX_ID + 1];       // points du premier décor de chaque id
+    int pointsGood, pointsBad, pointsForbidden;
+    int pointsComplete, pointsOrder, pointsOrderBroken;
+} Recipe;
+
+typedef struct {
+    Recipe recipes[RECIPE_MAX];
+    int count;
+} RecipeBook;
+
+// État courant d'un gâteau, pour toutes les recettes à la fois
+typedef struct {
+    unsigned int ingredients;                            // ingrédients déposés
+    unsigned int decors;                                 // ids de décors déjà posés
+    int score[RECIPE_MAX];
+    signed char chainState[RECIPE_MAX][RECIPE_MAX_CHAINS]; // prochain rang attendu, -1 : ordre rompu
+    bool complete[RECIPE_MAX];
+    int best;                                            // recette la mieux notée
+} RecipeEval;
+
+// Charge les recettes ; sans fichier valide, une recette par défaut est utilisée
+int RecipeBookLoad(RecipeBook *book, const char *path);
+
+void RecipeEvalReset(RecipeEval *ev, const RecipeBook *book);
+// Dépôt d'un ingrédient / d'un décor : retourne la variation du meilleur score
+int RecipeEvalIngredient(RecipeEval *ev, const RecipeBook *book, int id);
+int RecipeEvalDecor(RecipeEval *ev, const RecipeBook *book, int id);
+
+static inline int RecipeEvalScore(const RecipeEval *ev) { return ev->score[ev->best]; }
+static inline const char *RecipeEvalName(const RecipeEval *ev, const RecipeBook *book) {
+    return book->recipes[ev->best].name;
+}
+
+#endif // MINIGAME_GATEAU_RECIPE_H
@@ -9,6 +9,10 @@ typedef struct MinigameAPI {
     void (*draw)(void);
     void (*unload)(void);
     bool (*isCompleted)(int *coinsOut);
+    // Optionnel : copie l'état à dessiner dans l'instantané arrière du pipeline
+    // (engine/pipeline.h). Un mini-jeu qui le fournit dessine uniquement depuis
+    // ses instantanés ; update peut alors tourner sur le thread de simulation.
+    void (*publish)(void);
 } MinigameAPI;
 
 #endif // MINIGAME_H
@@ -0,0 +1,98 @@
+// Cache de la couche statique du plateau (textures de rendu par blocs)
+#include "board_cache.h"
+#include "engine/trace.h"
+#include <math.h>
+
+typedef struct {
+    RenderTexture2D target;
+    int cx, cy;              // bloc représenté
+    int cell;                // taille de case au moment du rendu
+    unsigned int lastUse;
+    bool valid;
+} Chunk;
+
+static Chunk chunks[BOARD_CACHE_MAX];
+static unsigned int frame;
+
+void BoardCacheInvalidate(void) {
+    for (int i = 0; i < BOARD_CACHE_MAX; ++i) chunks[i].valid = false;
+}
+
+void BoardCacheUnload(void) {
+    for (int i = 0; i < BOARD_CACHE_MAX; ++i) {
+        if (IsRenderTextureValid(chunks[i].target)) UnloadRenderTexture(chunks[i].target);
+        chunks[i] = (Chunk){ 0 };
+    }
+}
+
+static void renderChunk(Chunk *c, const LevelGrid *grid, int cell) {
+    TRACE_SCOPE("board.chunk");
+    BeginTextureMode(c->target);
+    ClearBackground(BLANK);   // dehors : transparent
+    int x0 = c->cx * BOARD_CHUNK, y0 = c->cy * BOARD_CHUNK;
+    for (int y = y0; y < y0 + BOARD_CHUNK && y < grid->height; ++y) {
+        for (int x = x0; x < x0 + BOARD_CHUNK && x < grid->width; ++x) {
+            bool wall = LevelGridGet(grid, PLANE_WALL, x, y);
+            if (!wall && !LevelGridGet(grid, PLANE_FLOOR, x, y)) continue;
+            bool target = LevelGridGet(grid, PLANE_TARGET, x, y);
+            Color base = wall?(Color){70,70,90,255}:(target? (Color){90,140,90,255}: (Color){40,40,50,255});
+            DrawRectangle((x - x0)*cell, (y - y0)*cell, cell-2, cell-2, base);
+        }
+    }
+    EndTextureMode();
+    c->cell = cell;
+    c->valid = true;
+}
+
+// Bloc (cx, cy) : déjà en cache, sinon une entrée libre ou la moins récemment vue
+static Chunk *acquireChunk(const LevelGrid *grid, int cx, int cy, int cell) {
+    Chunk *slot = NULL;
+    for (int i = 0; i < BOARD_CACHE_MAX; ++i) {
+        Chunk *c = &chunks[i];
+        if (c->valid && c->cx == cx && c->cy == cy && c->cell == cell) {
+            c->lastUse = frame;
+            return c;
+        }
+        if (!slot || (!c->valid && slot->valid) || (c->valid == slot->valid && c->lastUse < slot->lastUse)) slot = c;
+    }
+    int size = BOARD_CHUNK * cell;
+    if (IsRenderTextureValid(slot->target) && slot->target.texture.width != size) UnloadRenderTexture(slot->target);
+    if (!IsRenderTextureValid(slot->target)) slot->target = LoadRenderTexture(size, size);
+    if (!IsRenderTextureValid(slot->target)) return NULL;
+    slot->cx = cx;
+    slot->cy = cy;
+    slot->lastUse = frame;
+    renderChunk(slot, grid, cell);
+    return slot;
+}
+
+void BoardCacheDraw(const LevelGrid *grid, Vector2 camera, Rectangle view, int cell) {
+    frame++;
+    int span = BOARD_CHUNK * cell;
+    int cx0 = (int)floorf(camera.x / span), cy0 = (int)floorf(camera.y / span);
+    int cx1 = (int)floorf((camera.x + view.width - 1) / span), cy1 = (int)floorf((camera.y + view.height - 1) / span);
+    int maxX = (grid->width - 1) / BOARD_CHUNK, maxY = (grid->height - 1) / BOARD_CHUNK;
+    if (cx0 < 0) cx0 = 0;
+    if (cy0 < 0) cy0 = 0;
+    if (cx1 > maxX) cx1 = maxX;
+    if (cy1 > maxY) cy1 = maxY;
+
+    // rendu des blocs manquants avant le découpage : les textures de rendu ont leur propre zone
+    Chunk *visible[BOARD_CACHE_MAX];
+    int count = 0;
+    for (int cy = cy0; cy <= cy1; ++cy) {
+        for (int cx = cx0; cx <= cx1 && count < BOARD_CACHE_MAX; ++cx) {
+            Chunk *c = acquireChunk(grid, cx, cy, cell);
+            if (c) visible[count++] = c;
+        }
+    }
+
+    BeginScissorMode((int)view.x, (int)view.y, (int)view.width, (int)view.height);
+    for (int i = 0; i < count; ++i) {
+        Chunk *c = visible[i];
+        Vector2 pos = { roundf(view.x + c->cx*span - camera.x), roundf(view.y + c->cy*span - camera.y) };
+        // hauteur négative : les textures de rendu sont stockées à l'envers
+        DrawTextureRec(c->target.texture, (Rectangle){ 0, 0, (float)span, (float)-span }, pos, WHITE);
+    }
+    EndScissorMode();
+}
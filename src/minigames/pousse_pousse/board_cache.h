@@ -0,0 +1,25 @@
+#ifndef MINIGAME_POUSSE_POUSSE_BOARD_CACHE_H
+#define MINIGAME_POUSSE_POUSSE_BOARD_CACHE_H
+
+#include "raylib.h"
+#include "level_pack.h"
+
+// Couche statique du plateau (murs, sol, cibles) précalculée dans des textures
+// de rendu par blocs de BOARD_CHUNK x BOARD_CHUNK cases. Un bloc n'est dessiné
+// qu'à sa première apparition à l'écran ; le cache n'est invalidé qu'au
+// chargement d'un niveau (ou, pour les très grands niveaux, par éviction du
+// bloc le moins récemment vu).
+
+#define BOARD_CHUNK 16
+// Une vue de 1720 x 840 px à 48 px par case montre au plus 4 x 3 blocs de
+// 768 px ; 4 de marge pour les blocs qu'on vient de quitter (~38 Mo de VRAM)
+#define BOARD_CACHE_MAX 16
+
+void BoardCacheInvalidate(void);
+void BoardCacheUnload(void);
+
+// Dessine la partie du plateau visible dans view ; camera : coin haut-gauche de
+// la vue en pixels du niveau, cell : taille d'une case en pixels
+void BoardCacheDraw(const LevelGrid *grid, Vector2 camera, Rectangle view, int cell);
+
+#endif // MINIGAME_POUSSE_POUSSE_BOARD_CACHE_H
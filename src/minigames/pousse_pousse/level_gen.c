@@ -0,0 +1,452 @@
+// Génération parallèle de niveaux par tirages à reculons
+#include "level_gen.h"
+#include "sokoban_solver.h"
+#include "engine/jobs.h"
+#include "engine/thread.h"
+#include "engine/trace.h"
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define GEN_MAX_STREAMS 32
+#define GEN_BATCH 8              // candidats par job avant de rendre la main
+#define GEN_MAX_MISSES 5000      // candidats refusés d'affilée avant d'abandonner (paramètres inatteignables)
+#define GEN_CELLS (LEVEL_GEN_MAX_SIZE * LEVEL_GEN_MAX_SIZE)
+
+typedef struct { uint64_t s; } Rng;
+
+// Flux de candidats : un job qui se relance après chaque lot, pour laisser
+// passer les autres jobs (pâte, solveur) entre deux lots. Sans thread de
+// travail, les flux avancent par LevelGenStep sur le thread appelant.
+typedef struct {
+    LevelGenJob *job;
+    Rng rng;                 // graine propre au flux
+} Stream;
+
+struct LevelGenJob {
+    LevelGenParams params;
+    Stream streams[GEN_MAX_STREAMS];
+    int streamCount;
+    int nextStream;               // LevelGenStep : flux suivant (tour à tour)
+    JobCounter running;           // lots lancés et pas encore terminés
+    Mutex *lock;
+    GeneratedLevel *levels;       // protégé par lock
+    uint64_t *hashes;             // empreintes des niveaux acceptés (doublons)
+    atomic_int accepted;
+    atomic_int misses;            // candidats refusés depuis le dernier accepté
+    atomic_bool cancel;
+};
+
+static uint64_t rngNext(Rng *r) {
+    uint64_t z = (r->s += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Entier dans [lo, hi]
+static int rngRange(Rng *r, int lo, int hi) {
+    if (hi <= lo) return lo;
+    return lo + (int)(rngNext(r) % (uint64_t)(hi - lo + 1));
+}
+
+// Candidat en cours de construction (un par thread)
+typedef struct {
+    int w, h;
+    unsigned char wall[GEN_CELLS];
+    unsigned char target[GEN_CELLS];
+    unsigned char box[GEN_CELLS];
+    int player;
+    int queue[GEN_CELLS];
+    unsigned char reach[GEN_CELLS];
+    unsigned short dist[GEN_CELLS];   // distance (en pas) à la cible la plus proche
+} Candidate;
+
+static int floodReach(Candidate *c, int start, bool boxesBlock) {
+    memset(c->reach, 0, (size_t)(c->w * c->h));
+    int head = 0, tail = 0;
+    int delta[4] = { 1, -1, c->w, -c->w };
+    c->queue[tail++] = start;
+    c->reach[start] = 1;
+    while (head < tail) {
+        int cell = c->queue[head++];
+        for (int d = 0; d < 4; ++d) {
+            int n = cell + delta[d];
+            if (c->wall[n] || c->reach[n] || (boxesBlock && c->box[n])) continue;
+            c->reach[n] = 1;
+            c->queue[tail++] = n;
+        }
+    }
+    return tail;
+}
+
+// Salle : bordure de murs, blocs intérieurs aléatoires, une seule zone connexe
+static bool buildRoom(Candidate *c, Rng *rng, const LevelGenParams *p, int boxes) {
+    c->w = rngRange(rng, p->minSize, p->maxSize);
+    c->h = rngRange(rng, p->minSize, p->maxSize);
+    int cells = c->w * c->h;
+    memset(c->target, 0, (size_t)cells);
+    memset(c->box, 0, (size_t)cells);
+    int density = rngRange(rng, 8, 22);   // % de murs intérieurs
+    for (int y = 0; y < c->h; ++y) {
+        for (int x = 0; x < c->w; ++x) {
+            bool edge = x == 0 || y == 0 || x == c->w - 1 || y == c->h - 1;
+            c->wall[y * c->w + x] = edge || rngRange(rng, 0, 99) < density;
+        }
+    }
+    // point de départ au hasard, le reste de l'intérieur non relié est muré
+    int start = -1;
+    for (int tries = 0; tries < 64 && start < 0; ++tries) {
+        int cell = rngRange(rng, c->w + 1, cells - c->w - 2);
+        if (!c->wall[cell]) start = cell;
+    }
+    if (start < 0) return false;
+    int floor = floodReach(c, start, false);
+    if (floor < boxes * 3 + 6) return false;
+    for (int i = 0; i < cells; ++i) if (!c->reach[i]) c->wall[i] = 1;
+    c->player = start;
+    return true;
+}
+
+// Cellule aléatoire parmi celles marquées dans reach (et sans caisse)
+static int pickReachable(Candidate *c, Rng *rng, int count) {
+    int k = rngRange(rng, 0, count - 1);
+    for (int i = 0; i < count; ++i) {
+        int cell = c->queue[(k + i) % count];
+        if (!c->box[cell]) return cell;
+    }
+    return -1;
+}
+
+// Part de l'état résolu et tire les caisses à reculons
+static bool scramble(Candidate *c, Rng *rng, int boxes) {
+    int floor = floodReach(c, c->player, false);
+    for (int b = 0; b < boxes; ++b) {
+        int cell = -1;
+        for (int tries = 0; tries < 32 && cell < 0; ++tries) {
+            int t = c->queue[rngRange(rng, 0, floor - 1)];
+            if (!c->target[t]) cell = t;
+        }
+        if (cell < 0) return false;
+        c->target[cell] = c->box[cell] = 1;
+    }
+    int start = -1;
+    for (int tries = 0; tries < 32 && start < 0; ++tries) {
+        int t = c->queue[rngRange(rng, 0, floor - 1)];
+        if (!c->box[t]) start = t;
+    }
+    if (start < 0) return false;
+    c->player = start;
+
+    int delta[4] = { 1, -1, c->w, -c->w };
+    // distances aux cibles : les tirages qui éloignent une caisse sont privilégiés
+    int cells = c->w * c->h, head = 0, tail = 0;
+    for (int i = 0; i < cells; ++i) {
+        c->dist[i] = c->target[i] ? 0 : 0xFFFF;
+        if (c->target[i]) c->queue[tail++] = i;
+    }
+    while (head < tail) {
+        int cell = c->queue[head++];
+        for (int d = 0; d < 4; ++d) {
+            int n = cell + delta[d];
+            if (c->wall[n] || c->dist[n] != 0xFFFF) continue;
+            c->dist[n] = (unsigned short)(c->dist[cell] + 1);
+            c->queue[tail++] = n;
+        }
+    }
+
+    int lastBox = -1;
+    int steps = boxes * rngRange(rng, 8, 20);
+    int pulls[4 * SOKO_MAX_BOXES][2];
+    for (int s = 0; s < steps; ++s) {
+        int reachable = floodReach(c, c->player, true);
+        // tirage : la caisse en b recule vers le joueur placé en b+d, qui recule en b+2d
+        int n = 0, away = 0, follow = -1;
+        for (int i = 0; i < reachable; ++i) {
+            int p = c->queue[i];
+            for (int d = 0; d < 4; ++d) {
+                int b = p - delta[d], q = p + delta[d];
+                if (!c->box[b] || c->wall[q] || c->box[q] || n >= 4 * SOKO_MAX_BOXES) continue;
+                pulls[n][0] = b;
+                pulls[n][1] = d;
+                // rangement : les tirages qui éloignent la caisse de sa cible en tête
+                if (c->dist[p] > c->dist[b]) {
+                    int t0 = pulls[away][0], t1 = pulls[away][1];
+                    pulls[away][0] = b; pulls[away][1] = d;
+                    pulls[n][0] = t0; pulls[n][1] = t1;
+                    if (b == lastBox) follow = away;
+                    away++;
+                }
+                n++;
+            }
+        }
+        if (n == 0) break;
+        // on insiste sur la même caisse et on l'éloigne : des trajets plus longs que des petits pas épars
+        int pick;
+        int roll = rngRange(rng, 0, 99);
+        if (follow >= 0 && roll < 60) pick = follow;
+        else if (away > 0 && roll < 90) pick = rngRange(rng, 0, away - 1);
+        else pick = rngRange(rng, 0, n - 1);
+        int b = pulls[pick][0], d = pulls[pick][1];
+        c->box[b] = 0;
+        c->box[b + delta[d]] = 1;
+        c->player = b + 2 * delta[d];
+        lastBox = b + delta[d];
+    }
+    int reachable = floodReach(c, c->player, true);
+    int player = pickReachable(c, rng, reachable);
+    if (player >= 0) c->player = player;
+
+    int onTarget = 0;
+    for (int i = 0; i < c->w * c->h; ++i) onTarget += c->box[i] && c->target[i];
+    return onTarget * 2 <= boxes;
+}
+
+static void toSolverLevel(const Candidate *c, unsigned char *cells, SokobanLevel *level) {
+    for (int i = 0; i < c->w * c->h; ++i) {
+        cells[i] = (c->wall[i] ? SOKO_WALL : 0) | (c->target[i] ? SOKO_TARGET : 0) | (c->box[i] ? SOKO_BOX : 0);
+    }
+    level->width = c->w;
+    level->height = c->h;
+    level->cells = cells;
+    level->playerX = c->player % c->w;
+    level->playerY = c->player / c->w;
+}
+
+// Rendu XSB recadré ; les murs sans sol voisin (même en diagonale) deviennent du vide
+static bool toRows(const Candidate *c, GeneratedLevel *g) {
+    int x0 = c->w, y0 = c->h, x1 = -1, y1 = -1;
+    for (int y = 0; y < c->h; ++y) {
+        for (int x = 0; x < c->w; ++x) {
+            if (c->wall[y * c->w + x]) continue;
+            if (x < x0) x0 = x;
+            if (x > x1) x1 = x;
+            if (y < y0) y0 = y;
+            if (y > y1) y1 = y;
+        }
+    }
+    if (x1 < 0) return false;
+    // une rangée de murs autour du sol (toujours dans la salle grâce à la bordure)
+    x0--; y0--; x1++; y1++;
+    g->width = x1 - x0 + 1;
+    g->height = y1 - y0 + 1;
+    g->rows = malloc((size_t)(g->width * g->height));
+    if (!g->rows) return false;
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+            int i = y * c->w + x;
+            char ch = ' ';
+            if (c->wall[i]) {
+                bool useful = false;
+                for (int dy = -1; dy <= 1; ++dy) for (int dx = -1; dx <= 1; ++dx) {
+                    int nx = x + dx, ny = y + dy;
+                    if (nx >= 0 && ny >= 0 && nx < c->w && ny < c->h && !c->wall[ny * c->w + nx]) useful = true;
+                }
+                ch = useful ? '#' : ' ';
+            } else if (i == c->player) {
+                ch = c->target[i] ? '+' : '@';
+            } else if (c->box[i]) {
+                ch = c->target[i] ? '*' : '$';
+            } else if (c->target[i]) {
+                ch = '.';
+            }
+            g->rows[(y - y0) * g->width + (x - x0)] = ch;
+        }
+    }
+    return true;
+}
+
+static uint64_t hashRows(const char *rows, int w, int h) {
+    uint64_t hash = 1469598103934665603ULL;
+    hash = (hash ^ (uint64_t)w) * 1099511628211ULL;
+    hash = (hash ^ (uint64_t)h) * 1099511628211ULL;
+    for (int i = 0; i < w * h; ++i) hash = (hash ^ (unsigned char)rows[i]) * 1099511628211ULL;
+    return hash;
+}
+
+static bool finished(LevelGenJob *job) {
+    return atomic_load(&job->cancel) || atomic_load(&job->accepted) >= job->params.count ||
+           atomic_load(&job->misses) >= GEN_MAX_MISSES;
+}
+
+// Un candidat : construit, mélangé, résolu, gardé s'il est assez long et nouveau
+static bool tryCandidate(Stream *st) {
+    TRACE_SCOPE("levelgen.candidate");
+    LevelGenJob *job = st->job;
+    const LevelGenParams *p = &job->params;
+    // tampons propres au thread qui exécute le candidat (un flux peut changer de thread)
+    static _Thread_local Candidate c;
+    static _Thread_local unsigned char cells[GEN_CELLS];
+    static _Thread_local SokobanSolution solution;
+
+    int boxes = rngRange(&st->rng, p->minBoxes, p->maxBoxes);
+    if (!buildRoom(&c, &st->rng, p, boxes) || !scramble(&c, &st->rng, boxes)) return false;
+    SokobanLevel level;
+    toSolverLevel(&c, cells, &level);
+    if (SokobanSolve(&level, p->maxNodes, &solution, &job->cancel) != SOKO_SOLVED) return false;
+    if (solution.pushCount < p->minPushes) return false;
+
+    GeneratedLevel g;
+    if (!toRows(&c, &g)) return false;
+    g.pushes = solution.pushCount;
+    g.nodesExpanded = solution.nodesExpanded;
+    g.branching = solution.branching;
+    g.difficulty = (float)solution.pushCount * solution.branching;
+    uint64_t hash = hashRows(g.rows, g.width, g.height);
+    MutexLock(job->lock);
+    int n = atomic_load(&job->accepted);
+    bool keep = n < p->count;
+    for (int i = 0; i < n && keep; ++i) keep = job->hashes[i] != hash;
+    if (keep) {
+        job->levels[n] = g;
+        job->hashes[n] = hash;
+        atomic_store(&job->accepted, n + 1);
+    }
+    MutexUnlock(job->lock);
+    if (!keep) free(g.rows);
+    return keep;
+}
+
+static void runCandidate(Stream *st) {
+    if (tryCandidate(st)) atomic_store(&st->job->misses, 0);
+    else atomic_fetch_add(&st->job->misses, 1);
+}
+
+static void streamJob(void *arg) {
+    Stream *st = arg;
+    LevelGenJob *job = st->job;
+    // Sans thread de travail, JobsRun exécute sur place : relancer empilerait
+    // les appels sur le thread appelant, on boucle donc ici jusqu'à la fin
+    do {
+        for (int attempt = 0; attempt < GEN_BATCH && !finished(job); ++attempt) runCandidate(st);
+    } while (JobsWorkerCount() == 0 && !finished(job));
+    // relancé avant la fin de ce lot : le compteur ne repasse pas par zéro
+    if (!finished(job)) JobsRun(streamJob, st, &job->running);
+}
+
+void LevelGenDefaults(LevelGenParams *params) {
+    params->count = 200;
+    params->minSize = 7;
+    params->maxSize = 11;
+    params->minBoxes = 2;
+    params->maxBoxes = 4;
+    params->minPushes = 6;
+    params->maxNodes = 20000;
+    params->seed = 1;
+    params->threads = 0;
+}
+
+LevelGenJob *LevelGenStart(const LevelGenParams *params) {
+    LevelGenJob *job = calloc(1, sizeof(LevelGenJob));
+    if (!job) return NULL;
+    job->params = *params;
+    LevelGenParams *p = &job->params;
+    if (p->maxSize > LEVEL_GEN_MAX_SIZE) p->maxSize = LEVEL_GEN_MAX_SIZE;
+    if (p->minSize < 5) p->minSize = 5;
+    if (p->minSize > p->maxSize) p->minSize = p->maxSize;
+    if (p->minBoxes < 1) p->minBoxes = 1;
+    if (p->maxBoxes > SOKO_MAX_BOXES) p->maxBoxes = SOKO_MAX_BOXES;
+    if (p->maxBoxes < p->minBoxes) p->maxBoxes = p->minBoxes;
+    if (p->count < 0) p->count = 0;
+    job->levels = calloc((size_t)p->count + 1, sizeof(GeneratedLevel));
+    job->hashes = calloc((size_t)p->count + 1, sizeof(uint64_t));
+    job->lock = MutexCreate();
+    if (!job->levels || !job->hashes || !job->lock) {
+        if (job->lock) MutexDestroy(job->lock);
+        free(job->levels); free(job->hashes); free(job);
+        return NULL;
+    }
+
+    int streams = p->threads > 0 ? p->threads : JobsWorkerCount() + 1;
+    if (streams > GEN_MAX_STREAMS) streams = GEN_MAX_STREAMS;
+    // graines par flux dérivées de la graine globale : résultats reproductibles par flux
+    Rng seeder = { (uint64_t)p->seed * 0x2545F4914F6CDD1DULL + 1 };
+    atomic_init(&job->running.pending, 0);
+    job->streamCount = streams;
+    for (int i = 0; i < streams; ++i) job->streams[i] = (Stream){ job, { rngNext(&seeder) } };
+    // sans thread de travail, rien n'est lancé : LevelGenStep ou LevelGenFinish font avancer
+    if (JobsWorkerCount() > 0) {
+        for (int i = 0; i < streams; ++i) JobsRun(streamJob, &job->streams[i], &job->running);
+    }
+    return job;
+}
+
+void LevelGenStep(LevelGenJob *job, double seconds) {
+    if (JobsWorkerCount() > 0) return;
+    // au moins un candidat par appel, même si le budget est déjà dépassé
+    double end = ThreadNowSeconds() + seconds;
+    do {
+        runCandidate(&job->streams[job->nextStream]);
+        job->nextStream = (job->nextStream + 1) % job->streamCount;
+    } while (!finished(job) && ThreadNowSeconds() < end);
+}
+
+int LevelGenProgress(LevelGenJob *job) {
+    return atomic_load(&job->accepted);
+}
+
+bool LevelGenDone(LevelGenJob *job) {
+    return JobsDone(&job->running) && finished(job);
+}
+
+void LevelGenCancel(LevelGenJob *job) {
+    atomic_store(&job->cancel, true);
+}
+
+static int compareDifficulty(const void *a, const void *b) {
+    const GeneratedLevel *la = a, *lb = b;
+    if (la->difficulty != lb->difficulty) return la->difficulty < lb->difficulty ? -1 : 1;
+    return la->pushes - lb->pushes;
+}
+
+int LevelGenFinish(LevelGenJob *job, GeneratedLevel **levels) {
+    if (JobsWorkerCount() == 0 && !finished(job)) streamJob(&job->streams[job->nextStream]);
+    JobsWait(&job->running);
+    int count = atomic_load(&job->accepted);
+    qsort(job->levels, (size_t)count, sizeof(GeneratedLevel), compareDifficulty);
+    *levels = job->levels;
+    MutexDestroy(job->lock);
+    free(job->hashes);
+    free(job);
+    return count;
+}
+
+void LevelGenFree(GeneratedLevel *levels, int count) {
+    if (!levels) return;
+    for (int i = 0; i < count; ++i) free(levels[i].rows);
+    free(levels);
+}
+
+char *LevelGenPackText(const GeneratedLevel *levels, int count) {
+    size_t size = 64;
+    for (int i = 0; i < count; ++i) size += 64 + (size_t)(levels[i].width + 1) * levels[i].height + 1;
+    char *text = malloc(size);
+    if (!text) return NULL;
+    size_t n = (size_t)snprintf(text, size, "; Niveaux générés (%d)\n\n", count);
+    for (int i = 0; i < count && n < size; ++i) {
+        const GeneratedLevel *g = &levels[i];
+        n += (size_t)snprintf(text + n, size - n, "; Généré %d - %d poussées, difficulté %.0f\n", i + 1, g->pushes, g->difficulty);
+        for (int y = 0; y < g->height; ++y) {
+            int len = g->width;
+            while (len > 0 && g->rows[y * g->width + len - 1] == ' ') len--;
+            memcpy(text + n, g->rows + y * g->width, (size_t)len);
+            n += (size_t)len;
+            text[n++] = '\n';
+        }
+        text[n++] = '\n';
+    }
+    text[n] = '\0';
+    return text;
+}
+
+bool LevelGenWritePack(const GeneratedLevel *levels, int count, const char *path) {
+    char *text = LevelGenPackText(levels, count);
+    if (!text) return false;
+    FILE *f = fopen(path, "w");
+    bool ok = f && fputs(text, f) >= 0;
+    if (f) fclose(f);
+    free(text);
+    return ok;
+}
@@ -0,0 +1,59 @@
+#ifndef MINIGAME_POUSSE_POUSSE_LEVEL_GEN_H
+#define MINIGAME_POUSSE_POUSSE_LEVEL_GEN_H
+
+#include <stdbool.h>
+
+// Générateur de niveaux : une salle aléatoire, les caisses posées sur les
+// cibles puis "tirées" à reculons depuis l'état résolu (le niveau est donc
+// toujours jouable), validé et noté par le solveur (longueur de la solution x
+// facteur de branchement). Les candidats sont produits en parallèle par des
+// jobs (engine/jobs.h), un générateur pseudo-aléatoire par flux. Pas de
+// dépendance à raylib : le même code sert en jeu et dans l'outil hors ligne
+// (tools/levelgen.c).
+
+#define LEVEL_GEN_MAX_SIZE 24
+
+typedef struct {
+    int count;               // niveaux à produire
+    int minSize, maxSize;    // côté de la salle, murs compris
+    int minBoxes, maxBoxes;
+    int minPushes;           // solutions plus courtes rejetées
+    int maxNodes;            // budget du solveur par candidat
+    unsigned int seed;
+    int threads;             // flux de candidats en parallèle ; 0 : un par cœur
+} LevelGenParams;
+
+typedef struct {
+    int width, height;
+    char *rows;              // height lignes XSB de width caractères (sans '\n')
+    int pushes;
+    int nodesExpanded;
+    float branching;
+    float difficulty;        // pushes x branching
+} GeneratedLevel;
+
+typedef struct LevelGenJob LevelGenJob;
+
+void LevelGenDefaults(LevelGenParams *params);
+
+// Lance les jobs et retourne aussitôt
+LevelGenJob *LevelGenStart(const LevelGenParams *params);
+// Sans thread de travail (machine à un cœur), rien ne tourne en arrière-plan :
+// chaque appel produit des candidats sur le thread appelant pendant environ
+// seconds. Ne fait rien quand les jobs ont des threads de travail.
+void LevelGenStep(LevelGenJob *job, double seconds);
+int LevelGenProgress(LevelGenJob *job);      // niveaux acceptés jusqu'ici
+bool LevelGenDone(LevelGenJob *job);
+void LevelGenCancel(LevelGenJob *job);
+// Attend la fin (ou termine sur place sans thread de travail), trie par
+// difficulté croissante et libère le travail. Retourne moins que
+// params.count si la génération a été annulée ou a abandonné : trop de
+// candidats refusés d'affilée (paramètres impossibles à satisfaire).
+int LevelGenFinish(LevelGenJob *job, GeneratedLevel **levels);
+void LevelGenFree(GeneratedLevel *levels, int count);
+
+// Paquet XSB (texte alloué, à libérer avec free) ou écriture dans un fichier
+char *LevelGenPackText(const GeneratedLevel *levels, int count);
+bool LevelGenWritePack(const GeneratedLevel *levels, int count, const char *path);
+
+#endif // MINIGAME_POUSSE_POUSSE_LEVEL_GEN_H
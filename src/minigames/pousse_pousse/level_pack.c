@@ -0,0 +1,215 @@
+// Paquets de niveaux XSB : lecture du texte et décodage en plans de bits
+#include "level_pack.h"
+#include "engine/trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static bool isLevelChar(char c) {
+    return c == '#' || c == '@' || c == '+' || c == '$' || c == '*' || c == '.' ||
+           c == ' ' || c == '-' || c == '_' || (c >= '0' && c <= '9');
+}
+
+// Une ligne de niveau : uniquement des symboles XSB et au moins un mur
+static bool isLevelRow(const char *line) {
+    bool wall = false;
+    for (const char *c = line; *c; ++c) {
+        if (!isLevelChar(*c)) return false;
+        if (*c == '#') wall = true;
+    }
+    return wall;
+}
+
+// "3#2-$" -> "###--$"
+static char *expandRow(const char *line) {
+    char buf[LEVEL_MAX_SIZE + 1];
+    int n = 0, run = 0;
+    for (const char *c = line; *c && n < LEVEL_MAX_SIZE; ++c) {
+        if (*c >= '0' && *c <= '9') { run = run * 10 + (*c - '0'); continue; }
+        int count = run > 0 ? run : 1;
+        while (count-- > 0 && n < LEVEL_MAX_SIZE) buf[n++] = *c;
+        run = 0;
+    }
+    while (n > 0 && buf[n-1] == ' ') n--;
+    buf[n] = '\0';
+    char *row = malloc(n + 1);
+    if (row) memcpy(row, buf, n + 1);
+    return row;
+}
+
+static void trimLine(char *s) {
+    size_t n = strlen(s);
+    while (n > 0 && (s[n-1] == '\n' || s[n-1] == '\r' || s[n-1] == '\t')) s[--n] = '\0';
+}
+
+static void copyName(char *dst, const char *src) {
+    while (*src == ' ' || *src == ';') src++;
+    if (strncmp(src, "Title:", 6) == 0) src += 6;
+    while (*src == ' ') src++;
+    snprintf(dst, LEVEL_NAME_LEN, "%s", src);
+}
+
+static bool pushLine(LevelPack *pack, char *row, int *capacity) {
+    if (!row) return false;
+    if (pack->lineCount == *capacity) {
+        int cap = *capacity ? *capacity * 2 : 256;
+        char **lines = realloc(pack->lines, sizeof(char *) * cap);
+        if (!lines) { free(row); return false; }
+        pack->lines = lines;
+        *capacity = cap;
+    }
+    pack->lines[pack->lineCount++] = row;
+    return true;
+}
+
+// Découpe le texte ligne par ligne (fichier ou texte de secours)
+static void parseText(LevelPack *pack, const char *text) {
+    char pending[LEVEL_NAME_LEN] = "";
+    LevelInfo *current = NULL;   // niveau en cours de lecture
+    LevelInfo *last = NULL;      // dernier niveau terminé (pour "Title:" placé après)
+    int capacity = 0;
+    const char *p = text;
+    while (*p) {
+        const char *end = strchr(p, '\n');
+        size_t len = end ? (size_t)(end - p) : strlen(p);
+        char line[1024];
+        if (len >= sizeof(line)) len = sizeof(line) - 1;
+        memcpy(line, p, len);
+        line[len] = '\0';
+        trimLine(line);
+        p = end ? end + 1 : p + strlen(p);
+
+        if (isLevelRow(line)) {
+            if (!current) {
+                if (pack->count >= LEVEL_PACK_MAX) continue;
+                current = &pack->levels[pack->count++];
+                memset(current, 0, sizeof(*current));
+                if (pending[0]) snprintf(current->name, LEVEL_NAME_LEN, "%s", pending);
+                else snprintf(current->name, LEVEL_NAME_LEN, "Niveau %d", pack->count);
+                current->rows = pack->lineCount;
+                pending[0] = '\0';
+            }
+            if (current->height >= LEVEL_MAX_SIZE || !pushLine(pack, expandRow(line), &capacity)) continue;
+            int w = (int)strlen(pack->lines[pack->lineCount - 1]);
+            if (w > current->width) current->width = w;
+            current->height++;
+            continue;
+        }
+        if (current) { last = current; current = NULL; }
+        if (line[0] == '\0') continue;
+        if (strncmp(line, "Title:", 6) == 0 && last) {
+            copyName(last->name, line);
+            last = NULL;
+        } else if (strchr(line, ':') == NULL) {
+            copyName(pending, line);   // texte libre ou "; nom" avant le niveau
+        }
+    }
+}
+
+// Retire les niveaux injouables (sans joueur...) : N/P ne tombe que sur des niveaux valides
+static void dropInvalid(LevelPack *pack) {
+    LevelGrid grid = { 0 };
+    int kept = 0;
+    for (int i = 0; i < pack->count; ++i) {
+        if (LevelGridBuild(&grid, pack, i)) pack->levels[kept++] = pack->levels[i];
+    }
+    LevelGridFree(&grid);
+    pack->count = kept;
+}
+
+int LevelPackLoad(LevelPack *pack, const char *path, const char *fallback) {
+    TRACE_SCOPE("asset.levels");
+    memset(pack, 0, sizeof(*pack));
+    char *text = NULL;
+    FILE *f = path ? fopen(path, "rb") : NULL;
+    if (f) {
+        fseek(f, 0, SEEK_END);
+        long size = ftell(f);
+        fseek(f, 0, SEEK_SET);
+        text = size >= 0 ? malloc((size_t)size + 1) : NULL;
+        if (text) text[fread(text, 1, (size_t)size, f)] = '\0';
+        fclose(f);
+    }
+    if (text) {
+        parseText(pack, text);
+        free(text);
+        dropInvalid(pack);
+    }
+    if (pack->count == 0 && fallback) {
+        parseText(pack, fallback);
+        dropInvalid(pack);
+    }
+    return pack->count;
+}
+
+void LevelPackFree(LevelPack *pack) {
+    for (int i = 0; i < pack->lineCount; ++i) free(pack->lines[i]);
+    free(pack->lines);
+    memset(pack, 0, sizeof(*pack));
+}
+
+bool LevelGridBuild(LevelGrid *grid, const LevelPack *pack, int index) {
+    LevelGridFree(grid);
+    if (index < 0 || index >= pack->count) return false;
+    const LevelInfo *info = &pack->levels[index];
+    grid->width = info->width;
+    grid->height = info->height;
+    grid->stride = (info->width + 63) / 64;
+    grid->planes = calloc((size_t)PLANE_COUNT * grid->height * grid->stride, sizeof(uint64_t));
+    if (!grid->planes) return false;
+
+    bool player = false;
+    for (int y = 0; y < info->height; ++y) {
+        const char *row = pack->lines[info->rows + y];
+        for (int x = 0; row[x]; ++x) {
+            char c = row[x];
+            if (c == '#') LevelGridSet(grid, PLANE_WALL, x, y, true);
+            if (c == '.' || c == '*' || c == '+') LevelGridSet(grid, PLANE_TARGET, x, y, true);
+            if (c == '$' || c == '*') LevelGridSet(grid, PLANE_BOX, x, y, true);
+            if (c == '@' || c == '+') { grid->playerX = x; grid->playerY = y; player = true; }
+        }
+    }
+    if (!player) { LevelGridFree(grid); return false; }
+
+    // Intérieur : parcours depuis le joueur ; le dehors des murs n'est pas dessiné
+    int cells = grid->width * grid->height;
+    int *queue = malloc(sizeof(int) * cells);
+    if (!queue) { LevelGridFree(grid); return false; }
+    int head = 0, tail = 0;
+    queue[tail++] = grid->playerY * grid->width + grid->playerX;
+    LevelGridSet(grid, PLANE_FLOOR, grid->playerX, grid->playerY, true);
+    static const int dx[4] = { 1, -1, 0, 0 }, dy[4] = { 0, 0, 1, -1 };
+    while (head < tail) {
+        int c = queue[head++];
+        int x = c % grid->width, y = c / grid->width;
+        for (int d = 0; d < 4; ++d) {
+            int nx = x + dx[d], ny = y + dy[d];
+            if (nx < 0 || ny < 0 || nx >= grid->width || ny >= grid->height) continue;
+            if (LevelGridGet(grid, PLANE_WALL, nx, ny) || LevelGridGet(grid, PLANE_FLOOR, nx, ny)) continue;
+            LevelGridSet(grid, PLANE_FLOOR, nx, ny, true);
+            queue[tail++] = ny * grid->width + nx;
+        }
+    }
+    free(queue);
+
+    // caisses et cibles hors de l'intérieur : ignorées
+    grid->boxCount = grid->targetCount = 0;
+    for (int y = 0; y < grid->height; ++y) {
+        for (int x = 0; x < grid->width; ++x) {
+            bool inside = LevelGridGet(grid, PLANE_FLOOR, x, y);
+            if (!inside) {
+                LevelGridSet(grid, PLANE_BOX, x, y, false);
+                LevelGridSet(grid, PLANE_TARGET, x, y, false);
+                continue;
+            }
+            grid->boxCount += LevelGridGet(grid, PLANE_BOX, x, y);
+            grid->targetCount += LevelGridGet(grid, PLANE_TARGET, x, y);
+        }
+    }
+    return true;
+}
+
+void LevelGridFree(LevelGrid *grid) {
+    free(grid->planes);
+    memset(grid, 0, sizeof(*grid));
+}
@@ -0,0 +1,67 @@
+#ifndef MINIGAME_POUSSE_POUSSE_LEVEL_PACK_H
+#define MINIGAME_POUSSE_POUSSE_LEVEL_PACK_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Paquets de niveaux au format texte XSB standard :
+//   #  mur        @  joueur         $  caisse          .  cible
+//   *  caisse sur cible             +  joueur sur cible    espace, - ou _  sol
+// Un niveau = un bloc de lignes consécutives ; les autres lignes (titres,
+// commentaires ";", "Title: ...") séparent les niveaux. Les lignes codées en
+// longueur de plage ("3#2-$") sont acceptées.
+
+#define LEVEL_PACK_FILE "assets/pousse_pousse/levels.xsb"
+#define LEVEL_MAX_SIZE 256
+#define LEVEL_PACK_MAX 256
+#define LEVEL_NAME_LEN 48
+
+typedef struct {
+    char name[LEVEL_NAME_LEN];
+    int width, height;
+    int rows;            // première ligne dans LevelPack.lines
+} LevelInfo;
+
+typedef struct {
+    LevelInfo levels[LEVEL_PACK_MAX];
+    int count;
+    char **lines;        // lignes du fichier déjà décodées (sans plages)
+    int lineCount;
+} LevelPack;
+
+// Grille compacte : un plan de bits par attribut (mur, cible, caisse, intérieur),
+// chaque ligne arrondie à un multiple de 64 cases.
+typedef struct {
+    int width, height;
+    int stride;          // mots de 64 bits par ligne
+    uint64_t *planes;    // 4 plans de height * stride mots
+    int playerX, playerY;
+    int boxCount, targetCount;
+} LevelGrid;
+
+typedef enum { PLANE_WALL = 0, PLANE_TARGET, PLANE_BOX, PLANE_FLOOR, PLANE_COUNT } LevelPlane;
+
+// Lit un fichier XSB ; sans fichier (ou sans niveau valide), lit le texte
+// fallback (si non NULL). Les niveaux que LevelGridBuild refuse sont retirés.
+int LevelPackLoad(LevelPack *pack, const char *path, const char *fallback);
+void LevelPackFree(LevelPack *pack);
+
+// Décode le niveau index ; PLANE_FLOOR marque les cases atteignables depuis le joueur
+bool LevelGridBuild(LevelGrid *grid, const LevelPack *pack, int index);
+void LevelGridFree(LevelGrid *grid);
+
+static inline bool LevelGridGet(const LevelGrid *g, LevelPlane plane, int x, int y) {
+    if (x < 0 || y < 0 || x >= g->width || y >= g->height) return plane == PLANE_WALL;
+    const uint64_t *row = g->planes + ((size_t)plane * g->height + y) * g->stride;
+    return (row[x >> 6] >> (x & 63)) & 1u;
+}
+
+static inline void LevelGridSet(LevelGrid *g, LevelPlane plane, int x, int y, bool on) {
+    uint64_t *row = g->planes + ((size_t)plane * g->height + y) * g->stride;
+    uint64_t bit = (uint64_t)1 << (x & 63);
+    if (on) row[x >> 6] |= bit;
+    else row[x >> 6] &= ~bit;
+}
+
+#endif // MINIGAME_POUSSE_POUSSE_LEVEL_PACK_H
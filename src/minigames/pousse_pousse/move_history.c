@@ -0,0 +1,46 @@
+// Historique compact des coups (deux par octet)
+#include "move_history.h"
+#include <stdlib.h>
+#include <string.h>
+
+static int readMove(const MoveHistory *h, int i) {
+    return (h->bytes[i >> 1] >> ((i & 1) * 4)) & 0x0F;
+}
+
+static void writeMove(MoveHistory *h, int i, int move) {
+    int shift = (i & 1) * 4;
+    h->bytes[i >> 1] = (uint8_t)((h->bytes[i >> 1] & ~(0x0F << shift)) | (move << shift));
+}
+
+void MoveHistoryClear(MoveHistory *h) {
+    h->count = 0;
+    h->cursor = 0;
+}
+
+void MoveHistoryFree(MoveHistory *h) {
+    free(h->bytes);
+    memset(h, 0, sizeof(*h));
+}
+
+bool MoveHistoryPush(MoveHistory *h, int dir, bool push) {
+    if (h->cursor == h->capacity) {
+        int cap = h->capacity ? h->capacity * 2 : 1024;
+        uint8_t *bytes = realloc(h->bytes, (size_t)cap / 2);
+        if (!bytes) return false;
+        h->bytes = bytes;
+        h->capacity = cap;
+    }
+    writeMove(h, h->cursor++, (dir & 3) | (push ? MOVE_PUSH : 0));
+    h->count = h->cursor; // la branche annulée est abandonnée
+    return true;
+}
+
+int MoveHistoryUndo(MoveHistory *h) {
+    if (h->cursor == 0) return -1;
+    return readMove(h, --h->cursor);
+}
+
+int MoveHistoryRedo(MoveHistory *h) {
+    if (h->cursor == h->count) return -1;
+    return readMove(h, h->cursor++);
+}
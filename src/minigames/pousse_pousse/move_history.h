@@ -0,0 +1,27 @@
+#ifndef MINIGAME_POUSSE_POUSSE_MOVE_HISTORY_H
+#define MINIGAME_POUSSE_POUSSE_MOVE_HISTORY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Historique annuler / refaire : un coup = 4 bits (direction sur 2 bits + bit
+// de poussée), deux coups par octet. Annuler et refaire sont en O(1) ; un
+// nouveau coup après des annulations efface la partie "à refaire".
+
+#define MOVE_PUSH 4    // bit de poussée, la direction occupe les bits 0-1
+
+typedef struct {
+    uint8_t *bytes;
+    int capacity;      // en coups
+    int count;         // coups enregistrés (annulés compris)
+    int cursor;        // coups joués ; cursor < count : refaire possible
+} MoveHistory;
+
+void MoveHistoryClear(MoveHistory *h);
+void MoveHistoryFree(MoveHistory *h);
+bool MoveHistoryPush(MoveHistory *h, int dir, bool push);
+// Retourne le coup (direction | MOVE_PUSH) ou -1 si rien à annuler / refaire
+int MoveHistoryUndo(MoveHistory *h);
+int MoveHistoryRedo(MoveHistory *h);
+
+#endif // MINIGAME_POUSSE_POUSSE_MOVE_HISTORY_H
@@ -1,104 +1,455 @@
-// Pousse-Pousse 10x10 (Sokoban léger)
+// Pousse-Pousse (Sokoban léger) : paquets de niveaux XSB, caméra défilante
 #include "pousse_pousse.h"
+#include "engine/audio.h"
+#include "engine/input.h"
+#include "engine/jobs.h"
+#include "board_cache.h"
+#include "level_gen.h"
+#include "level_pack.h"
+#include "move_history.h"
+#include "sokoban_solver.h"
+#include <math.h>
+#include <stdlib.h>
 
-typedef enum { T_EMPTY=0, T_WALL, T_BOX, T_TARGET, T_BOX_ON_TARGET } Tile;
+#define CELL 48
+// Zone de jeu à l'écran : seules les cases visibles y sont dessinées
+#define VIEW_X 100
+#define VIEW_Y 120
+#define VIEW_W 1720
+#define VIEW_H 840
 
-static int gridW = 10, gridH = 10;
-static Tile grid[10][10];
+// Niveau intégré, utilisé si le paquet est introuvable
+static const char *FALLBACK_LEVELS =
+    "; Premier pas\n"
+    "##########\n"
+    "#        #\n"
+    "# ##   # #\n"
+    "# @# $ # #\n"
+    "#  #   # #\n"
+    "#    #   #\n"
+    "#    #  .#\n"
+    "#        #\n"
+    "#        #\n"
+    "##########\n";
+
+static LevelPack pack;
+static int levelIndex;
+static LevelGrid grid;
 static int playerX, playerY;
 static bool levelWon;
+static int boxesOff;          // caisses hors cible, tenu à jour à chaque poussée
+static MoveHistory history;
+static Vector2 camera;        // coin haut-gauche de la vue, en pixels du niveau
+
+// Couche dynamique : les caisses et le joueur affichés suivent l'état logique
+// à travers une file de pas animés (les entrées ne sont jamais perdues)
+#define STEP_QUEUE 64
+#define STEP_TIME 0.09f       // durée d'un pas sans file d'attente
+typedef struct {
+    int from, to;             // cases du joueur (indices y*largeur+x)
+    int box;                  // caisse déplacée (-1 : aucune)
+    int boxFrom, boxTo;
+} Step;
+static Step steps[STEP_QUEUE];
+static int stepHead, stepCount;
+static float stepT;           // avancement du pas en tête, 0..1
+static int playerShown;       // case du joueur une fois les pas terminés joués
+static int *boxCell, *boxShown;
+static int boxTotal, boxCap;
+
+// Aide : le solveur tourne en tâche de fond après chaque poussée
+static int solverTicket = -1;
+static SokobanSolution solverResult;
+static bool solverReady;
+static bool quickDeadlock;   // blocage évident détecté tout de suite
+static bool showHint;
+static unsigned char *solverCells;
+static int solverCellsCap;
+
+// Génération en jeu (G) : le paquet courant est remplacé une fois terminé
+#define GENERATED_LEVELS 100
+#define GENERATION_STEP 0.004   // s de génération par image quand aucun thread de travail n'est disponible
+static LevelGenJob *genJob;
+static unsigned int genSeed = 1;
+
+static Vector2 cellVec(int cell) {
+    return (Vector2){ (float)(cell % grid.width), (float)(cell / grid.width) };
+}
+
+static float smoothStep(float t) {
+    return t * t * (3.0f - 2.0f * t);
+}
+
+static Vector2 lerpCells(int from, int to, float t) {
+    Vector2 a = cellVec(from), b = cellVec(to);
+    float k = smoothStep(t);
+    return (Vector2){ a.x + (b.x - a.x) * k, a.y + (b.y - a.y) * k };
+}
+
+// Position affichée du joueur, en cases
+static Vector2 playerDisplay(void) {
+    if (stepCount == 0) return cellVec(playerShown);
+    const Step *s = &steps[stepHead];
+    return lerpCells(s->from, s->to, stepT);
+}
+
+static void settleStep(void) {
+    const Step *s = &steps[stepHead];
+    playerShown = s->to;
+    if (s->box >= 0) boxShown[s->box] = s->boxTo;
+    stepHead = (stepHead + 1) % STEP_QUEUE;
+    stepCount--;
+    stepT = 0.0f;
+}
+
+static void queueStep(int from, int to, int box, int boxFrom, int boxTo) {
+    if (stepCount == STEP_QUEUE) settleStep(); // file pleine : le plus ancien pas est joué d'un coup
+    steps[(stepHead + stepCount) % STEP_QUEUE] = (Step){ from, to, box, boxFrom, boxTo };
+    stepCount++;
+}
+
+// Les pas en attente accélèrent l'animation pour que l'affichage rattrape le jeu
+static void advanceSteps(float dt) {
+    while (stepCount > 0 && dt > 0.0f) {
+        float duration = STEP_TIME / (1.0f + 0.5f * (stepCount - 1));
+        float left = (1.0f - stepT) * duration;
+        if (dt < left) {
+            stepT += dt / duration;
+            return;
+        }
+        dt -= left;
+        settleStep();
+    }
+}
+
+// Caisses : tableau parallèle au plan de bits pour ne dessiner que la couche dynamique
+static void collectBoxes(void) {
+    boxTotal = 0;
+    for (int y=0;y<grid.height;y++) for (int x=0;x<grid.width;x++) {
+        if (!LevelGridGet(&grid, PLANE_BOX, x, y)) continue;
+        if (boxTotal == boxCap) {
+            int cap = boxCap ? boxCap * 2 : 64;
+            int *cells = realloc(boxCell, sizeof(int) * cap);
+            if (!cells) return;
+            boxCell = cells;
+            int *shown = realloc(boxShown, sizeof(int) * cap);
+            if (!shown) return;
+            boxShown = shown;
+            boxCap = cap;
+        }
+        boxCell[boxTotal] = boxShown[boxTotal] = y*grid.width + x;
+        boxTotal++;
+    }
+}
+
+static int findBox(int cell) {
+    for (int i = 0; i < boxTotal; ++i) if (boxCell[i] == cell) return i;
+    return -1;
+}
+
+// Cible de la caméra : joueur centré, bornée au niveau (centré s'il tient dans la vue)
+static Vector2 cameraGoal(void) {
+    float levelW = (float)grid.width * CELL, levelH = (float)grid.height * CELL;
+    Vector2 p = playerDisplay();
+    Vector2 goal = { p.x*CELL + CELL/2.0f - VIEW_W/2.0f, p.y*CELL + CELL/2.0f - VIEW_H/2.0f };
+    if (levelW <= VIEW_W) goal.x = (levelW - VIEW_W) / 2.0f;
+    else goal.x = goal.x < 0 ? 0 : (goal.x > levelW - VIEW_W ? levelW - VIEW_W : goal.x);
+    if (levelH <= VIEW_H) goal.y = (levelH - VIEW_H) / 2.0f;
+    else goal.y = goal.y < 0 ? 0 : (goal.y > levelH - VIEW_H ? levelH - VIEW_H : goal.y);
+    return goal;
+}
 
 static void loadLevel(void) {
-    // Niveau simple 10x10
-    int map[10][10] = {
-        {1,1,1,1,1,1,1,1,1,1},
-        {1,0,0,0,0,0,0,0,0,1},
-        {1,0,1,1,0,0,0,1,0,1},
-        {1,0,0,1,0,3,0,1,0,1},
-        {1,0,0,1,0,0,0,1,0,1},
-        {1,0,0,0,0,1,0,0,0,1},
-        {1,0,0,0,0,1,0,0,4,1},
-        {1,0,0,0,0,0,0,0,0,1},
-        {1,0,0,0,0,0,0,0,0,1},
-        {1,1,1,1,1,1,1,1,1,1},
-    };
-    for (int y=0;y<gridH;y++) for (int x=0;x<gridW;x++) {
-        int v = map[y][x];
-        grid[y][x] = (v==1)?T_WALL:(v==3?T_BOX:(v==4?T_TARGET:T_EMPTY));
+    if (!LevelGridBuild(&grid, &pack, levelIndex)) {
+        // le paquet ne garde que des niveaux valides : échec d'allocation, on retombe sur le niveau intégré
+        LevelPackFree(&pack);
+        LevelPackLoad(&pack, NULL, FALLBACK_LEVELS);
+        levelIndex = 0;
+        LevelGridBuild(&grid, &pack, levelIndex);
+    }
+    playerX = grid.playerX; playerY = grid.playerY;
+    boxesOff = 0;
+    for (int y=0;y<grid.height;y++) for (int x=0;x<grid.width;x++) {
+        if (LevelGridGet(&grid, PLANE_BOX, x, y) && !LevelGridGet(&grid, PLANE_TARGET, x, y)) boxesOff++;
     }
-    playerX = 2; playerY = 2;
     levelWon = false;
+    MoveHistoryClear(&history);
+    collectBoxes();
+    stepHead = stepCount = 0;
+    stepT = 0.0f;
+    playerShown = playerY*grid.width + playerX;
+    BoardCacheInvalidate();
+    camera = cameraGoal();
+}
+
+// Adaptateur : grille du jeu -> description générique du solveur
+static bool buildSolverLevel(SokobanLevel *level) {
+    int size = grid.width * grid.height;
+    if (size > solverCellsCap) {
+        unsigned char *cells = realloc(solverCells, size);
+        if (!cells) return false;
+        solverCells = cells;
+        solverCellsCap = size;
+    }
+    for (int y=0;y<grid.height;y++) for (int x=0;x<grid.width;x++) {
+        unsigned char f = 0;
+        if (!LevelGridGet(&grid, PLANE_FLOOR, x, y)) f = SOKO_WALL;
+        if (LevelGridGet(&grid, PLANE_TARGET, x, y)) f |= SOKO_TARGET;
+        if (LevelGridGet(&grid, PLANE_BOX, x, y)) f |= SOKO_BOX;
+        solverCells[y*grid.width + x] = f;
+    }
+    level->width = grid.width;
+    level->height = grid.height;
+    level->cells = solverCells;
+    level->playerX = playerX;
+    level->playerY = playerY;
+    return true;
+}
+
+static void requestAnalysis(void) {
+    SokobanLevel level;
+    solverReady = false;
+    solverTicket = -1;
+    quickDeadlock = false;
+    if (levelWon || !buildSolverLevel(&level)) return;
+    quickDeadlock = SokobanQuickDeadlock(&level);
+    solverTicket = SokobanSolverRequest(&level);
+}
+
+static void resetLevel(void) {
+    loadLevel();
+    showHint = false;
+    requestAnalysis();
+}
+
+static void changeLevel(int delta) {
+    levelIndex = (levelIndex + delta + pack.count) % pack.count;
+    resetLevel();
+}
+
+static void startGeneration(void) {
+    if (genJob) return;
+    LevelGenParams params;
+    LevelGenDefaults(&params);
+    params.count = GENERATED_LEVELS;
+    params.seed = genSeed++;
+    // génération sur le thread de jeu : un candidat coûte au plus son budget
+    // de solveur, réduit pour ne pas dépasser quelques ms par image
+    if (JobsWorkerCount() == 0) params.maxNodes /= 8;
+    genJob = LevelGenStart(&params);
+}
+
+static void pollGeneration(void) {
+    if (!genJob) return;
+    LevelGenStep(genJob, GENERATION_STEP);
+    if (!LevelGenDone(genJob)) return;
+    GeneratedLevel *levels = NULL;
+    int count = LevelGenFinish(genJob, &levels);
+    genJob = NULL;
+    char *text = count > 0 ? LevelGenPackText(levels, count) : NULL;
+    LevelGenFree(levels, count);
+    if (!text) return;
+    LevelPackFree(&pack);
+    LevelPackLoad(&pack, NULL, text);
+    free(text);
+    levelIndex = 0;
+    resetLevel();
 }
 
 static bool isBlocked(int x, int y) {
-    if (x<0||y<0||x>=gridW||y>=gridH) return true;
-    Tile t = grid[y][x];
-    return t==T_WALL;
+    return LevelGridGet(&grid, PLANE_WALL, x, y);
+}
+
+static bool isBox(int x, int y) {
+    return LevelGridGet(&grid, PLANE_BOX, x, y);
 }
 
 static bool isFree(int x, int y) {
-    if (x<0||y<0||x>=gridW||y>=gridH) return false;
-    Tile t = grid[y][x];
-    return t==T_EMPTY || t==T_TARGET;
+    if (x<0||y<0||x>=grid.width||y>=grid.height) return false;
+    return !isBlocked(x, y) && !isBox(x, y);
+}
+
+// Déplace une caisse et met le joueur en (px, py) ; le pas est ajouté à la file d'animation
+static void movePlayer(int px, int py, bool withBox, int fromX, int fromY, int toX, int toY) {
+    int box = -1;
+    if (withBox) {
+        LevelGridSet(&grid, PLANE_BOX, fromX, fromY, false);
+        LevelGridSet(&grid, PLANE_BOX, toX, toY, true);
+        boxesOff += !LevelGridGet(&grid, PLANE_TARGET, toX, toY) - !LevelGridGet(&grid, PLANE_TARGET, fromX, fromY);
+        box = findBox(fromY*grid.width + fromX);
+        if (box >= 0) boxCell[box] = toY*grid.width + toX;
+    }
+    queueStep(playerY*grid.width + playerX, py*grid.width + px, box, fromY*grid.width + fromX, toY*grid.width + toX);
+    playerX = px; playerY = py;
+}
+
+static void checkWin(void) {
+    bool won = (boxesOff == 0);
+    if (won && !levelWon) AudioPlaySfx(SFX_WIN);
+    levelWon = won;
 }
 
-static void tryMove(int dx, int dy) {
+static void tryMove(SokobanDir dir) {
     if (levelWon) return;
+    int dx = SokobanDirDX(dir), dy = SokobanDirDY(dir);
     int nx = playerX + dx;
     int ny = playerY + dy;
     if (isBlocked(nx, ny)) return;
+    bool pushed = false;
     // Box push
-    if (grid[ny][nx]==T_BOX || grid[ny][nx]==T_BOX_ON_TARGET) {
-        int bx = nx + dx, by = ny + dy;
-        if (!isFree(bx, by)) return; // cannot push
-        // Move box
-        bool intoTarget = (grid[by][bx]==T_TARGET);
-        grid[by][bx] = intoTarget ? T_BOX_ON_TARGET : T_BOX;
-        // Clear old box tile (if was on target, leave target)
-        grid[ny][nx] = (grid[ny][nx]==T_BOX_ON_TARGET) ? T_TARGET : T_EMPTY;
+    if (isBox(nx, ny)) {
+        if (!isFree(nx + dx, ny + dy)) return; // cannot push
+        pushed = true;
     }
+    // coup non enregistrable (mémoire pleine) : refusé, sinon annuler/refaire se désynchronise
+    if (!MoveHistoryPush(&history, dir, pushed)) return;
+    if (pushed) AudioPlaySfx(SFX_PUSH);
     // Move player
-    playerX = nx; playerY = ny;
-    // Win check: any BOX left not on target?
-    bool anyBoxOff = false;
-    for (int y=0;y<gridH;y++) for (int x=0;x<gridW;x++) if (grid[y][x]==T_BOX) anyBoxOff = true;
-    if (!anyBoxOff) levelWon = true;
+    movePlayer(nx, ny, pushed, nx, ny, nx + dx, ny + dy);
+    checkWin();
+    // un simple pas garde le joueur dans la même zone : l'analyse reste valable
+    if (pushed) requestAnalysis();
 }
 
-static void mg_init(void) { loadLevel(); }
+// Annuler : le joueur recule et ramène la caisse poussée
+static void undoMove(void) {
+    int move = MoveHistoryUndo(&history);
+    if (move < 0) return;
+    int dx = SokobanDirDX((SokobanDir)(move & 3)), dy = SokobanDirDY((SokobanDir)(move & 3));
+    movePlayer(playerX - dx, playerY - dy, move & MOVE_PUSH, playerX + dx, playerY + dy, playerX, playerY);
+    checkWin();
+    if (move & MOVE_PUSH) requestAnalysis();
+}
+
+// Refaire : le coup enregistré est forcément encore jouable
+static void redoMove(void) {
+    int move = MoveHistoryRedo(&history);
+    if (move < 0) return;
+    int dx = SokobanDirDX((SokobanDir)(move & 3)), dy = SokobanDirDY((SokobanDir)(move & 3));
+    movePlayer(playerX + dx, playerY + dy, move & MOVE_PUSH, playerX + dx, playerY + dy, playerX + 2*dx, playerY + 2*dy);
+    checkWin();
+    if (move & MOVE_PUSH) requestAnalysis();
+}
+
+static void mg_init(void) {
+    SokobanSolverStart();
+    LevelPackLoad(&pack, LEVEL_PACK_FILE, FALLBACK_LEVELS);
+    levelIndex = 0;
+    resetLevel();
+}
 
 static void mg_update(float dt) {
-    (void)dt;
-    if (IsKeyPressed(KEY_LEFT)) tryMove(-1,0);
-    if (IsKeyPressed(KEY_RIGHT)) tryMove(1,0);
-    if (IsKeyPressed(KEY_UP)) tryMove(0,-1);
-    if (IsKeyPressed(KEY_DOWN)) tryMove(0,1);
-    if (IsKeyPressed(KEY_R)) loadLevel();
+    // répétition clavier acceptée : les pas s'accumulent dans la file d'animation
+    if (InputKeyPressed(KEY_LEFT) || InputKeyPressedRepeat(KEY_LEFT)) tryMove(SOKO_LEFT);
+    if (InputKeyPressed(KEY_RIGHT) || InputKeyPressedRepeat(KEY_RIGHT)) tryMove(SOKO_RIGHT);
+    if (InputKeyPressed(KEY_UP) || InputKeyPressedRepeat(KEY_UP)) tryMove(SOKO_UP);
+    if (InputKeyPressed(KEY_DOWN) || InputKeyPressedRepeat(KEY_DOWN)) tryMove(SOKO_DOWN);
+    bool ctrl = InputKeyDown(KEY_LEFT_CONTROL) || InputKeyDown(KEY_RIGHT_CONTROL);
+    if (ctrl && (InputKeyPressed(KEY_Z) || InputKeyPressedRepeat(KEY_Z))) undoMove();
+    if (ctrl && (InputKeyPressed(KEY_Y) || InputKeyPressedRepeat(KEY_Y))) redoMove();
+    if (InputKeyPressed(KEY_R)) resetLevel();
+    if (InputKeyPressed(KEY_N)) changeLevel(1);
+    if (InputKeyPressed(KEY_P)) changeLevel(-1);
+    if (InputKeyPressed(KEY_H)) showHint = !showHint;
+    if (InputKeyPressed(KEY_G)) startGeneration();
+    pollGeneration();
+    if (!solverReady && solverTicket >= 0) solverReady = SokobanSolverPoll(solverTicket, &solverResult);
+
+    advanceSteps(dt);
+
+    // la caméra rattrape le joueur en douceur
+    Vector2 goal = cameraGoal();
+    float k = 1.0f - expf(-10.0f * dt);
+    camera.x += (goal.x - camera.x) * k;
+    camera.y += (goal.y - camera.y) * k;
 }
 
-static void drawCell(int x, int y, Tile t) {
-    int marginTop = 120;
-    int cell = 48; // 10x10 fits 480px
-    int px = 100 + x*cell;
-    int py = marginTop + y*cell;
-    Color base = (t==T_WALL)?(Color){70,70,90,255}:(t==T_TARGET? (Color){90,140,90,255}: (Color){40,40,50,255});
-    DrawRectangle(px, py, cell-2, cell-2, base);
-    if (t==T_BOX || t==T_BOX_ON_TARGET) DrawRectangle(px+8, py+8, cell-18, cell-18, (Color){200,160,80,255});
+static Vector2 cellToScreen(int x, int y) {
+    return (Vector2){ VIEW_X + x*CELL - camera.x, VIEW_Y + y*CELL - camera.y };
+}
+
+// Couche dynamique : caisses (seulement celles qui recoupent la vue) et joueur
+static void drawDynamicLayer(void) {
+    const Step *s = stepCount > 0 ? &steps[stepHead] : NULL;
+    Color boxColor = (Color){200,160,80,255};
+    for (int i = 0; i < boxTotal; ++i) {
+        Vector2 c = (s && s->box == i) ? lerpCells(s->boxFrom, s->boxTo, stepT) : cellVec(boxShown[i]);
+        float px = VIEW_X + c.x*CELL - camera.x, py = VIEW_Y + c.y*CELL - camera.y;
+        if (px + CELL < VIEW_X || py + CELL < VIEW_Y || px > VIEW_X + VIEW_W || py > VIEW_Y + VIEW_H) continue;
+        DrawRectangle((int)roundf(px)+8, (int)roundf(py)+8, CELL-18, CELL-18, boxColor);
+    }
+    Vector2 p = playerDisplay();
+    DrawCircleV((Vector2){ VIEW_X + p.x*CELL - camera.x + CELL/2.0f, VIEW_Y + p.y*CELL - camera.y + CELL/2.0f }, 14, (Color){240,200,120,255});
+}
+
+static bool hintAvailable(void) {
+    return showHint && solverReady && solverResult.status == SOKO_SOLVED && solverResult.pushCount > 0;
+}
+
+// Indice (H) : flèche sur la prochaine caisse à pousser
+static void drawHintArrow(void) {
+    if (levelWon || quickDeadlock || !hintAvailable()) return;
+    SokobanPush p = solverResult.pushes[0];
+    Vector2 from = cellToScreen(p.boxX, p.boxY);
+    from.x += CELL/2.0f; from.y += CELL/2.0f;
+    Vector2 to = { from.x + SokobanDirDX(p.dir)*CELL*0.8f, from.y + SokobanDirDY(p.dir)*CELL*0.8f };
+    Color hint = (Color){120,200,255,255};
+    DrawLineEx(from, to, 4, hint);
+    DrawCircleV(to, 7, hint);
+}
+
+// Message sous la vue : blocage ou état de l'indice
+static void drawSolverInfo(void) {
+    int textY = VIEW_Y + VIEW_H + 20;
+    if (levelWon) return;
+    bool stuck = quickDeadlock || (solverReady && solverResult.status == SOKO_UNSOLVABLE);
+    if (stuck) {
+        DrawText("Bloqué ! R pour recommencer.", VIEW_X, textY, 28, (Color){230,90,80,255});
+        return;
+    }
+    if (!showHint) return;
+    if (!solverReady) DrawText("Recherche d'un indice...", VIEW_X, textY, 20, LIGHTGRAY);
+    else if (!hintAvailable()) DrawText("Pas d'indice pour cette position.", VIEW_X, textY, 20, LIGHTGRAY);
+    else DrawText(TextFormat("Indice : %d poussée(s) restantes", solverResult.pushCount), VIEW_X, textY, 20, (Color){120,200,255,255});
 }
 
 static void mg_draw(void) {
-    DrawText("Pousse-Pousse 10x10 — Flèches pour bouger, R pour reset, Backspace retour", 20, 20, 18, LIGHTGRAY);
-    for (int y=0;y<gridH;y++) for (int x=0;x<gridW;x++) drawCell(x,y,grid[y][x]);
-    int cell = 48; int px = 100 + playerX*cell; int py = 120 + playerY*cell;
-    DrawCircle(px + cell/2, py + cell/2, 14, (Color){240,200,120,255});
-    if (levelWon) DrawText("Bravo! Niveau réussi.", 100, 640, 28, (Color){255,230,120,255});
+    DrawText("Pousse-Pousse — Flèches pour bouger, R pour reset, Ctrl+Z/Ctrl+Y annuler/refaire, N/P niveau, G générer, H indice, Backspace retour", 20, 20, 18, LIGHTGRAY);
+    DrawText(TextFormat("%d/%d  %s  -  %d coups", levelIndex + 1, pack.count, pack.levels[levelIndex].name, history.cursor), 20, 60, 24, (Color){255,230,120,255});
+
+    // Couche statique en cache (seuls les blocs visibles), puis couche dynamique
+    BoardCacheDraw(&grid, camera, (Rectangle){ VIEW_X, VIEW_Y, VIEW_W, VIEW_H }, CELL);
+    BeginScissorMode(VIEW_X, VIEW_Y, VIEW_W, VIEW_H);
+    drawDynamicLayer();
+    drawHintArrow();
+    EndScissorMode();
+    drawSolverInfo();
+    if (genJob) DrawText(TextFormat("Génération : %d/%d", LevelGenProgress(genJob), GENERATED_LEVELS), VIEW_X + VIEW_W - 300, 60, 24, LIGHTGRAY);
+    if (levelWon) DrawText("Bravo! Niveau réussi. N pour le suivant.", VIEW_X, VIEW_Y + VIEW_H + 20, 28, (Color){255,230,120,255});
 }
 
-static void mg_unload(void) {}
+static void mg_unload(void) {
+    if (genJob) {
+        GeneratedLevel *levels = NULL;
+        LevelGenCancel(genJob);
+        LevelGenFree(levels, LevelGenFinish(genJob, &levels));
+        genJob = NULL;
+    }
+    SokobanSolverStop();
+    LevelGridFree(&grid);
+    LevelPackFree(&pack);
+    MoveHistoryFree(&history);
+    BoardCacheUnload();
+    free(boxCell);
+    free(boxShown);
+    boxCell = boxShown = NULL;
+    boxTotal = boxCap = 0;
+    free(solverCells);
+    solverCells = NULL;
+    solverCellsCap = 0;
+}
 
 MinigameAPI GetMinigamePoussePousse(void) {
     MinigameAPI api = { mg_init, mg_update, mg_draw, mg_unload };
     return api;
 }
-
-
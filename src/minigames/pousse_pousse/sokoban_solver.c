@@ -0,0 +1,607 @@
+// Solveur de Sokoban : A* sur les poussées, état compact (caisses triées sur
+// 16 bits + position normalisée du joueur), table de transposition Zobrist.
+#include "sokoban_solver.h"
+#include "engine/jobs.h"
+#include "engine/thread.h"
+#include "engine/trace.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define INF_DIST 0xFFFF
+#define NO_NODE 0xFFFFFFFFu
+#define CANCEL_CHECK 256
+
+typedef struct {
+    int w, h, cells;
+    int delta[4];                // décalage d'indice par direction (SokobanDir)
+    unsigned char *wall;         // murs, bords et cases hors de portée du joueur
+    unsigned char *target;
+    unsigned short *goalDist;    // poussées min vers une cible (INF_DIST : case morte)
+    uint64_t *zBox, *zPlayer;
+    int boxCount;
+    uint16_t startBoxes[SOKO_MAX_BOXES];
+    int startPlayer;
+} Board;
+
+typedef struct {
+    uint64_t hash;
+    uint32_t parent;
+    uint32_t boxes;        // premier indice dans le pool de caisses
+    uint16_t player;       // plus petite case accessible au joueur
+    uint16_t g;            // poussées depuis le départ
+    uint16_t h;
+    uint16_t pushFrom;     // case de la caisse poussée pour arriver ici
+    uint8_t dir;
+    uint8_t closed;
+} Node;
+
+typedef struct {
+    uint32_t f, g, node;
+} HeapEntry;
+
+typedef struct {
+    const Board *b;
+    Node *nodes;
+    uint16_t *boxPool;
+    uint32_t nodeCount, nodeCap;
+    uint32_t *table;       // adressage ouvert, indices de nœuds
+    uint32_t tableMask;
+    HeapEntry *heap;
+    uint32_t heapCount, heapCap;
+    // tampons indexés par case, remis à zéro par estampille
+    uint32_t *boxAt, boxStamp;
+    uint32_t *reach, reachStamp;
+    uint32_t *reach2, reach2Stamp;
+    unsigned char *frozenMark;
+    int *queue;
+    uint64_t generated;
+} Search;
+
+static uint64_t splitmix64(uint64_t *state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static void freeBoard(Board *b) {
+    free(b->wall); free(b->target); free(b->goalDist);
+    free(b->zBox); free(b->zPlayer);
+    memset(b, 0, sizeof(*b));
+}
+
+// Distances de poussée vers les cibles : parcours inverse en "tirant" les caisses
+static void computeGoalDistances(Board *b, int *queue) {
+    for (int c = 0; c < b->cells; ++c) b->goalDist[c] = INF_DIST;
+    int head = 0, tail = 0;
+    for (int c = 0; c < b->cells; ++c) {
+        if (b->target[c] && !b->wall[c]) { b->goalDist[c] = 0; queue[tail++] = c; }
+    }
+    while (head < tail) {
+        int c = queue[head++];
+        for (int d = 0; d < 4; ++d) {
+            // la caisse vient de c - delta, le joueur se tenait en c - 2*delta
+            int from = c - b->delta[d];
+            int player = from - b->delta[d];
+            if (b->wall[from] || b->wall[player] || b->goalDist[from] != INF_DIST) continue;
+            b->goalDist[from] = (unsigned short)(b->goalDist[c] + 1);
+            queue[tail++] = from;
+        }
+    }
+}
+
+static SokobanStatus buildBoard(Board *b, const SokobanLevel *level) {
+    memset(b, 0, sizeof(*b));
+    int w = level->width, h = level->height;
+    if (w < 3 || h < 3 || w > SOKO_MAX_SIZE || h > SOKO_MAX_SIZE) return SOKO_GAVE_UP;
+    if (level->playerX <= 0 || level->playerY <= 0 || level->playerX >= w - 1 || level->playerY >= h - 1) return SOKO_GAVE_UP;
+    b->w = w; b->h = h; b->cells = w * h;
+    b->delta[SOKO_UP] = -w; b->delta[SOKO_DOWN] = w;
+    b->delta[SOKO_LEFT] = -1; b->delta[SOKO_RIGHT] = 1;
+    b->wall = calloc(b->cells, 1);
+    b->target = calloc(b->cells, 1);
+    b->goalDist = malloc(sizeof(unsigned short) * b->cells);
+    b->zBox = malloc(sizeof(uint64_t) * b->cells);
+    b->zPlayer = malloc(sizeof(uint64_t) * b->cells);
+    int *queue = malloc(sizeof(int) * b->cells);
+    unsigned char *seen = calloc(b->cells, 1);
+    if (!b->wall || !b->target || !b->goalDist || !b->zBox || !b->zPlayer || !queue || !seen) {
+        free(queue); free(seen); freeBoard(b);
+        return SOKO_GAVE_UP;
+    }
+
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            int c = y * w + x;
+            unsigned char f = level->cells[c];
+            // les bords comptent comme des murs : aucun voisin ne déborde d'une ligne
+            b->wall[c] = (f & SOKO_WALL) || x == 0 || y == 0 || x == w - 1 || y == h - 1;
+            b->target[c] = (f & SOKO_TARGET) != 0;
+        }
+    }
+    // Les cases que le joueur ne peut jamais atteindre (caisses ignorées) deviennent des murs
+    int start = level->playerY * w + level->playerX;
+    int head = 0, tail = 0;
+    queue[tail++] = start;
+    seen[start] = 1;
+    while (head < tail) {
+        int c = queue[head++];
+        for (int d = 0; d < 4; ++d) {
+            int n = c + b->delta[d];
+            if (b->wall[n] || seen[n]) continue;
+            seen[n] = 1;
+            queue[tail++] = n;
+        }
+    }
+    int targets = 0;
+    for (int c = 0; c < b->cells; ++c) {
+        if (!seen[c]) b->wall[c] = 1;
+        if (b->wall[c]) { b->target[c] = 0; continue; }
+        if (b->target[c]) targets++;
+        if (level->cells[c] & SOKO_BOX) {
+            if (b->boxCount >= SOKO_MAX_BOXES) { free(queue); free(seen); freeBoard(b); return SOKO_GAVE_UP; }
+            b->startBoxes[b->boxCount++] = (uint16_t)c;   // parcours croissant : déjà triées
+        }
+    }
+    b->startPlayer = start;
+    computeGoalDistances(b, queue);
+    free(queue);
+    free(seen);
+
+    uint64_t seed = 0x5EED50C0BA11ULL;
+    for (int c = 0; c < b->cells; ++c) {
+        b->zBox[c] = splitmix64(&seed);
+        b->zPlayer[c] = splitmix64(&seed);
+    }
+    if (b->boxCount == 0 || targets < b->boxCount) return SOKO_UNSOLVABLE;
+    return SOKO_SOLVED; // plateau valide
+}
+
+/* ----- Recherche ----- */
+
+static bool isBox(const Search *s, int c) {
+    return s->boxAt[c] == s->boxStamp;
+}
+
+static bool isWallLike(const Search *s, int c) {
+    return s->b->wall[c] || s->frozenMark[c];
+}
+
+static bool boxFrozen(Search *s, int c, int depth);
+
+// La caisse en c ne peut plus bouger sur l'axe d (1 : horizontal, w : vertical)
+static bool blockedOnAxis(Search *s, int c, int d, int depth) {
+    int a = c - d, z = c + d;
+    if (isWallLike(s, a) || isWallLike(s, z)) return true;
+    if (s->b->goalDist[a] == INF_DIST && s->b->goalDist[z] == INF_DIST) return true;
+    if (depth > 12) return false;
+    // une caisse voisine elle-même gelée bloque aussi ; c compte comme un mur pendant le test
+    s->frozenMark[c] = 1;
+    bool blocked = (isBox(s, a) && boxFrozen(s, a, depth + 1)) || (isBox(s, z) && boxFrozen(s, z, depth + 1));
+    s->frozenMark[c] = 0;
+    return blocked;
+}
+
+static bool boxFrozen(Search *s, int c, int depth) {
+    if (s->frozenMark[c]) return true;
+    return blockedOnAxis(s, c, 1, depth) && blockedOnAxis(s, c, s->b->w, depth);
+}
+
+// Parcours de la zone du joueur ; retourne la plus petite case atteinte
+static int floodPlayer(Search *s, int start, uint32_t *mark, uint32_t stamp) {
+    const Board *b = s->b;
+    int head = 0, tail = 0, minCell = start;
+    s->queue[tail++] = start;
+    mark[start] = stamp;
+    while (head < tail) {
+        int c = s->queue[head++];
+        if (c < minCell) minCell = c;
+        for (int d = 0; d < 4; ++d) {
+            int n = c + b->delta[d];
+            if (b->wall[n] || mark[n] == stamp || isBox(s, n)) continue;
+            mark[n] = stamp;
+            s->queue[tail++] = n;
+        }
+    }
+    return minCell;
+}
+
+static void placeBoxes(Search *s, const uint16_t *boxes) {
+    if (++s->boxStamp == 0) { memset(s->boxAt, 0, sizeof(uint32_t) * s->b->cells); s->boxStamp = 1; }
+    for (int i = 0; i < s->b->boxCount; ++i) s->boxAt[boxes[i]] = s->boxStamp;
+}
+
+static bool heapPush(Search *s, HeapEntry e) {
+    if (s->heapCount == s->heapCap) {
+        uint32_t cap = s->heapCap ? s->heapCap * 2 : 4096;
+        HeapEntry *heap = realloc(s->heap, sizeof(HeapEntry) * cap);
+        if (!heap) return false;
+        s->heap = heap;
+        s->heapCap = cap;
+    }
+    // plus petit f d'abord, à f égal le plus profond (g le plus grand)
+    uint32_t i = s->heapCount++;
+    while (i > 0) {
+        uint32_t p = (i - 1) / 2;
+        HeapEntry q = s->heap[p];
+        if (q.f < e.f || (q.f == e.f && q.g >= e.g)) break;
+        s->heap[i] = q;
+        i = p;
+    }
+    s->heap[i] = e;
+    return true;
+}
+
+static HeapEntry heapPop(Search *s) {
+    HeapEntry top = s->heap[0];
+    HeapEntry last = s->heap[--s->heapCount];
+    uint32_t i = 0;
+    for (;;) {
+        uint32_t l = i * 2 + 1, r = l + 1, m = i;
+        HeapEntry best = last;
+        if (l < s->heapCount && (s->heap[l].f < best.f || (s->heap[l].f == best.f && s->heap[l].g > best.g))) { m = l; best = s->heap[l]; }
+        if (r < s->heapCount && (s->heap[r].f < best.f || (s->heap[r].f == best.f && s->heap[r].g > best.g))) { m = r; best = s->heap[r]; }
+        if (m == i) break;
+        s->heap[i] = s->heap[m];
+        i = m;
+    }
+    if (s->heapCount > 0) s->heap[i] = last;
+    return top;
+}
+
+static bool sameState(const Search *s, uint32_t n, const uint16_t *boxes, uint16_t player) {
+    return s->nodes[n].player == player &&
+           memcmp(&s->boxPool[s->nodes[n].boxes], boxes, sizeof(uint16_t) * s->b->boxCount) == 0;
+}
+
+static uint32_t tableFind(const Search *s, uint64_t hash, const uint16_t *boxes, uint16_t player) {
+    uint32_t i = (uint32_t)hash & s->tableMask;
+    while (s->table[i] != NO_NODE) {
+        uint32_t n = s->table[i];
+        if (s->nodes[n].hash == hash && sameState(s, n, boxes, player)) return n;
+        i = (i + 1) & s->tableMask;
+    }
+    return NO_NODE;
+}
+
+static void tableInsert(Search *s, uint32_t node) {
+    uint32_t i = (uint32_t)s->nodes[node].hash & s->tableMask;
+    while (s->table[i] != NO_NODE) i = (i + 1) & s->tableMask;
+    s->table[i] = node;
+}
+
+// Agrandit nœuds, pool de caisses et table (facteur de charge <= 1/2)
+static bool ensureCapacity(Search *s, uint32_t maxNodes) {
+    if (s->nodeCount < s->nodeCap) return true;
+    if (s->nodeCap >= maxNodes) return false;
+    uint32_t cap = s->nodeCap ? s->nodeCap * 2 : 4096;
+    if (cap > maxNodes) cap = maxNodes;
+    Node *nodes = realloc(s->nodes, sizeof(Node) * cap);
+    if (!nodes) return false;
+    s->nodes = nodes;
+    uint16_t *pool = realloc(s->boxPool, sizeof(uint16_t) * cap * s->b->boxCount);
+    if (!pool) return false;
+    s->boxPool = pool;
+    s->nodeCap = cap;
+
+    uint32_t tableSize = 1;
+    while (tableSize < cap * 2) tableSize <<= 1;
+    if (tableSize - 1 != s->tableMask) {
+        free(s->table);
+        s->table = malloc(sizeof(uint32_t) * tableSize);
+        if (!s->table) return false;
+        memset(s->table, 0xFF, sizeof(uint32_t) * tableSize);
+        s->tableMask = tableSize - 1;
+        for (uint32_t n = 0; n < s->nodeCount; ++n) tableInsert(s, n);
+    }
+    return true;
+}
+
+static uint32_t addNode(Search *s, const uint16_t *boxes, uint16_t player, uint64_t hash,
+                        uint32_t parent, uint16_t g, uint16_t h, uint16_t pushFrom, uint8_t dir) {
+    uint32_t n = s->nodeCount++;
+    Node *node = &s->nodes[n];
+    node->hash = hash;
+    node->parent = parent;
+    node->boxes = n * s->b->boxCount;
+    node->player = player;
+    node->g = g;
+    node->h = h;
+    node->pushFrom = pushFrom;
+    node->dir = dir;
+    node->closed = 0;
+    memcpy(&s->boxPool[node->boxes], boxes, sizeof(uint16_t) * s->b->boxCount);
+    tableInsert(s, n);
+    return n;
+}
+
+static void extractSolution(const Search *s, uint32_t goal, SokobanSolution *out) {
+    int length = s->nodes[goal].g;
+    out->pushCount = length;
+    // remontée depuis le but : la poussée k est rangée à l'indice k si elle tient
+    for (uint32_t n = goal; s->nodes[n].parent != NO_NODE; n = s->nodes[n].parent) {
+        int k = s->nodes[n].g - 1;
+        if (k >= SOKO_MAX_SOLUTION) continue;
+        int c = s->nodes[n].pushFrom;
+        out->pushes[k] = (SokobanPush){ c % s->b->w, c / s->b->w, (SokobanDir)s->nodes[n].dir };
+    }
+}
+
+static void freeSearch(Search *s) {
+    free(s->nodes); free(s->boxPool); free(s->table); free(s->heap);
+    free(s->boxAt); free(s->reach); free(s->reach2); free(s->frozenMark); free(s->queue);
+}
+
+SokobanStatus SokobanSolve(const SokobanLevel *level, int maxNodes, SokobanSolution *out, atomic_bool *cancel) {
+    TRACE_SCOPE("solver.solve");
+    out->status = SOKO_GAVE_UP;
+    out->pushCount = 0;
+    out->nodesExpanded = 0;
+    out->branching = 0.0f;
+
+    Board board;
+    SokobanStatus valid = buildBoard(&board, level);
+    if (valid != SOKO_SOLVED) {
+        freeBoard(&board);
+        return out->status = valid;
+    }
+    const Board *b = &board;
+
+    Search s = { 0 };
+    int expanded = 0;
+    s.b = b;
+    s.boxAt = calloc(b->cells, sizeof(uint32_t));
+    s.reach = calloc(b->cells, sizeof(uint32_t));
+    s.reach2 = calloc(b->cells, sizeof(uint32_t));
+    s.frozenMark = calloc(b->cells, 1);
+    s.queue = malloc(sizeof(int) * b->cells);
+    SokobanStatus status = SOKO_GAVE_UP;
+    if (!s.boxAt || !s.reach || !s.reach2 || !s.frozenMark || !s.queue || !ensureCapacity(&s, (uint32_t)maxNodes)) goto done;
+
+    // Nœud initial
+    {
+        unsigned int h = 0;
+        for (int i = 0; i < b->boxCount; ++i) {
+            if (b->goalDist[b->startBoxes[i]] == INF_DIST) { status = SOKO_UNSOLVABLE; goto done; }
+            h += b->goalDist[b->startBoxes[i]];
+        }
+        placeBoxes(&s, b->startBoxes);
+        s.reachStamp++;
+        uint16_t player = (uint16_t)floodPlayer(&s, b->startPlayer, s.reach, s.reachStamp);
+        uint64_t hash = b->zPlayer[player];
+        for (int i = 0; i < b->boxCount; ++i) hash ^= b->zBox[b->startBoxes[i]];
+        uint32_t root = addNode(&s, b->startBoxes, player, hash, NO_NODE, 0, (uint16_t)h, 0, 0);
+        heapPush(&s, (HeapEntry){ h, 0, root });
+    }
+
+    uint16_t boxes[SOKO_MAX_BOXES];
+    uint16_t child[SOKO_MAX_BOXES];
+    while (s.heapCount > 0) {
+        if (cancel && (expanded % CANCEL_CHECK) == 0 && atomic_load(cancel)) { status = SOKO_CANCELLED; goto done; }
+        HeapEntry e = heapPop(&s);
+        Node *node = &s.nodes[e.node];
+        if (node->closed || node->g != e.g) continue; // entrée périmée
+        if (node->h == 0) {
+            extractSolution(&s, e.node, out);
+            status = SOKO_SOLVED;
+            break;
+        }
+        node->closed = 1;
+        expanded++;
+
+        uint32_t current = e.node;
+        memcpy(boxes, &s.boxPool[node->boxes], sizeof(uint16_t) * b->boxCount);
+        uint16_t g = node->g, h = node->h;
+        uint64_t hash = node->hash ^ b->zPlayer[node->player];
+        placeBoxes(&s, boxes);
+        if (++s.reachStamp == 0) { memset(s.reach, 0, sizeof(uint32_t) * b->cells); s.reachStamp = 1; }
+        floodPlayer(&s, node->player, s.reach, s.reachStamp);
+
+        for (int i = 0; i < b->boxCount; ++i) {
+            int c = boxes[i];
+            for (int d = 0; d < 4; ++d) {
+                int behind = c - b->delta[d];
+                int ahead = c + b->delta[d];
+                if (s.reach[behind] != s.reachStamp || b->wall[ahead] || isBox(&s, ahead) || b->goalDist[ahead] == INF_DIST) continue;
+
+                // caisse déplacée provisoirement pour le test de gel et la zone du joueur
+                s.boxAt[c] = 0;
+                s.boxAt[ahead] = s.boxStamp;
+                bool dead = !b->target[ahead] && boxFrozen(&s, ahead, 0);
+                int player = 0;
+                if (!dead) {
+                    if (++s.reach2Stamp == 0) { memset(s.reach2, 0, sizeof(uint32_t) * b->cells); s.reach2Stamp = 1; }
+                    player = floodPlayer(&s, c, s.reach2, s.reach2Stamp);
+                }
+                s.boxAt[ahead] = 0;
+                s.boxAt[c] = s.boxStamp;
+                if (dead) continue;
+
+                // caisses triées : on décale la caisse déplacée à sa place
+                memcpy(child, boxes, sizeof(uint16_t) * b->boxCount);
+                int k = i;
+                child[k] = (uint16_t)ahead;
+                while (k > 0 && child[k - 1] > child[k]) { uint16_t t = child[k]; child[k] = child[k - 1]; child[k - 1] = t; k--; }
+                while (k < b->boxCount - 1 && child[k + 1] < child[k]) { uint16_t t = child[k]; child[k] = child[k + 1]; child[k + 1] = t; k++; }
+
+                uint64_t childHash = hash ^ b->zBox[c] ^ b->zBox[ahead] ^ b->zPlayer[player];
+                uint16_t childG = (uint16_t)(g + 1);
+                uint16_t childH = (uint16_t)(h - b->goalDist[c] + b->goalDist[ahead]);
+                s.generated++;
+
+                uint32_t found = tableFind(&s, childHash, child, (uint16_t)player);
+                if (found != NO_NODE) {
+                    Node *f = &s.nodes[found];
+                    if (f->closed || f->g <= childG) continue;
+                    f->g = childG;
+                    f->parent = current;
+                    f->pushFrom = (uint16_t)c;
+                    f->dir = (uint8_t)d;
+                    heapPush(&s, (HeapEntry){ (uint32_t)childG + f->h, childG, found });
+                    continue;
+                }
+                if (!ensureCapacity(&s, (uint32_t)maxNodes)) { status = SOKO_GAVE_UP; goto done; }
+                uint32_t n = addNode(&s, child, (uint16_t)player, childHash, current, childG, childH, (uint16_t)c, (uint8_t)d);
+                if (!heapPush(&s, (HeapEntry){ (uint32_t)childG + childH, childG, n })) { status = SOKO_GAVE_UP; goto done; }
+            }
+        }
+    }
+    if (s.heapCount == 0 && status == SOKO_GAVE_UP) status = SOKO_UNSOLVABLE;
+
+done:
+    out->nodesExpanded = expanded;
+    out->branching = expanded > 0 ? (float)s.generated / (float)expanded : 0.0f;
+    freeSearch(&s);
+    freeBoard(&board);
+    return out->status = status;
+}
+
+bool SokobanQuickDeadlock(const SokobanLevel *level) {
+    Board board;
+    if (buildBoard(&board, level) != SOKO_SOLVED) {
+        freeBoard(&board);
+        return false;
+    }
+    Search s = { 0 };
+    s.b = &board;
+    s.boxAt = calloc(board.cells, sizeof(uint32_t));
+    s.frozenMark = calloc(board.cells, 1);
+    bool dead = false;
+    if (s.boxAt && s.frozenMark) {
+        placeBoxes(&s, board.startBoxes);
+        for (int i = 0; i < board.boxCount && !dead; ++i) {
+            int c = board.startBoxes[i];
+            if (board.target[c]) continue;
+            dead = board.goalDist[c] == INF_DIST || boxFrozen(&s, c, 0);
+        }
+    }
+    freeSearch(&s);
+    freeBoard(&board);
+    return dead;
+}
+
+/* ----- Solveur en tâche de fond ----- */
+
+// Un job de recherche à la fois (engine/jobs.h) : il traite les requêtes
+// jusqu'à ce qu'il n'y en ait plus, puis se termine
+static bool solverStarted;
+static Mutex *solverLock;
+static atomic_bool solverCancel;
+static bool solverRunning;          // job lancé (protégé par solverLock)
+static JobCounter solverJobs;
+
+static unsigned char *requestCells;
+static int requestCapacity;
+static SokobanLevel request;
+static int requestTicket;
+static bool requestPending;
+static int nextTicket;
+
+static SokobanSolution result;
+static int resultTicket = -1;
+
+// Copie de travail du job en cours (un seul à la fois)
+static unsigned char *jobCells;
+static int jobCapacity;
+
+static void solverJob(void *arg) {
+    (void)arg;
+    static SokobanSolution local;
+    MutexLock(solverLock);
+    while (requestPending) {
+        // copie de la requête : le thread principal peut en poster une autre pendant la recherche
+        int size = request.width * request.height;
+        if (size > jobCapacity) {
+            unsigned char *grown = realloc(jobCells, size);
+            if (grown) { jobCells = grown; jobCapacity = size; }
+        }
+        SokobanLevel level = request;
+        int ticket = requestTicket;
+        requestPending = false;
+        atomic_store(&solverCancel, false);
+        if (size > jobCapacity) continue;
+        memcpy(jobCells, requestCells, size);
+        level.cells = jobCells;
+        MutexUnlock(solverLock);
+
+        SokobanSolve(&level, SOKO_DEFAULT_NODES, &local, &solverCancel);
+
+        MutexLock(solverLock);
+        if (local.status != SOKO_CANCELLED) {
+            result = local;
+            resultTicket = ticket;
+        }
+    }
+    solverRunning = false;
+    MutexUnlock(solverLock);
+}
+
+void SokobanSolverStart(void) {
+    if (solverStarted || JobsWorkerCount() == 0) return; // sans thread de travail : recherche immédiate
+    solverLock = MutexCreate();
+    if (!solverLock) return;
+    requestPending = false;
+    solverRunning = false;
+    resultTicket = -1;
+    atomic_store(&solverCancel, false);
+    solverStarted = true;
+}
+
+void SokobanSolverStop(void) {
+    if (!solverStarted) return;
+    MutexLock(solverLock);
+    requestPending = false;
+    atomic_store(&solverCancel, true);
+    MutexUnlock(solverLock);
+    JobsWait(&solverJobs);
+    MutexDestroy(solverLock);
+    solverStarted = false;
+    free(requestCells);
+    requestCells = NULL;
+    requestCapacity = 0;
+    free(jobCells);
+    jobCells = NULL;
+    jobCapacity = 0;
+}
+
+int SokobanSolverRequest(const SokobanLevel *level) {
+    int size = level->width * level->height;
+    if (!solverStarted) {
+        // pas de thread : recherche immédiate avec un budget réduit
+        SokobanSolve(level, SOKO_DEFAULT_NODES / 10, &result, NULL);
+        resultTicket = ++nextTicket;
+        return resultTicket;
+    }
+    MutexLock(solverLock);
+    if (size > requestCapacity) {
+        unsigned char *grown = realloc(requestCells, size);
+        if (!grown) { MutexUnlock(solverLock); return -1; }
+        requestCells = grown;
+        requestCapacity = size;
+    }
+    memcpy(requestCells, level->cells, size);
+    request = *level;
+    requestTicket = ++nextTicket;
+    requestPending = true;
+    atomic_store(&solverCancel, true); // la recherche en cours est devenue inutile
+    bool launch = !solverRunning;
+    solverRunning = true;
+    int ticket = requestTicket;
+    MutexUnlock(solverLock);
+    if (launch) JobsRun(solverJob, NULL, &solverJobs);
+    return ticket;
+}
+
+bool SokobanSolverPoll(int ticket, SokobanSolution *out) {
+    if (!solverStarted) {
+        if (resultTicket != ticket) return false;
+        *out = result;
+        return true;
+    }
+    MutexLock(solverLock);
+    bool ready = (resultTicket == ticket);
+    if (ready) *out = result;
+    MutexUnlock(solverLock);
+    return ready;
+}
@@ -0,0 +1,65 @@
+#ifndef MINIGAME_POUSSE_POUSSE_SOKOBAN_SOLVER_H
+#define MINIGAME_POUSSE_POUSSE_SOKOBAN_SOLVER_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+
+// Solveur de Sokoban indépendant du stockage du jeu : il travaille sur une
+// description générique du niveau (une case = un octet de drapeaux).
+// A* sur les poussées (le joueur se déplace librement entre deux poussées),
+// table de transposition indexée par hachage de Zobrist, cases mortes
+// précalculées et détection des blocages "gelés" après chaque poussée.
+
+#define SOKO_WALL   1
+#define SOKO_TARGET 2
+#define SOKO_BOX    4
+
+#define SOKO_MAX_SIZE 256          // largeur / hauteur max
+#define SOKO_MAX_BOXES 64
+#define SOKO_MAX_SOLUTION 1024     // poussées max d'une solution
+#define SOKO_DEFAULT_NODES 300000  // budget de la recherche en tâche de fond
+
+typedef enum { SOKO_UP = 0, SOKO_DOWN, SOKO_LEFT, SOKO_RIGHT } SokobanDir;
+
+typedef struct {
+    int width, height;
+    const unsigned char *cells;   // width * height, drapeaux SOKO_*
+    int playerX, playerY;
+} SokobanLevel;
+
+typedef enum {
+    SOKO_SOLVED = 0,
+    SOKO_UNSOLVABLE,   // espace de recherche épuisé : le joueur est bloqué
+    SOKO_GAVE_UP,      // budget de nœuds atteint (ou niveau invalide)
+    SOKO_CANCELLED
+} SokobanStatus;
+
+typedef struct {
+    int boxX, boxY;    // caisse à pousser
+    SokobanDir dir;
+} SokobanPush;
+
+typedef struct {
+    SokobanStatus status;
+    int pushCount;                          // longueur totale de la solution
+    SokobanPush pushes[SOKO_MAX_SOLUTION];  // ses premières poussées
+    int nodesExpanded;
+    float branching;   // successeurs moyens par nœud développé (difficulté)
+} SokobanSolution;
+
+// Recherche synchrone ; cancel (optionnel) est relu régulièrement
+SokobanStatus SokobanSolve(const SokobanLevel *level, int maxNodes, SokobanSolution *out, atomic_bool *cancel);
+
+// Test instantané : une caisse hors cible est sur une case morte ou gelée
+bool SokobanQuickDeadlock(const SokobanLevel *level);
+
+// Solveur en tâche de fond : une requête remplace la précédente (annulée)
+void SokobanSolverStart(void);
+void SokobanSolverStop(void);
+int SokobanSolverRequest(const SokobanLevel *level);        // retourne un ticket
+bool SokobanSolverPoll(int ticket, SokobanSolution *out);   // vrai quand le résultat est prêt
+
+static inline int SokobanDirDX(SokobanDir d) { return d == SOKO_LEFT ? -1 : (d == SOKO_RIGHT ? 1 : 0); }
+static inline int SokobanDirDY(SokobanDir d) { return d == SOKO_UP ? -1 : (d == SOKO_DOWN ? 1 : 0); }
+
+#endif // MINIGAME_POUSSE_POUSSE_SOKOBAN_SOLVER_H
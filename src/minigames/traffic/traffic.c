@@ -1,6 +1,16 @@
 // Traffic runner avancé (textures, pièces, distance, complétion)
 #include "traffic.h"
+#include "engine/anim.h"
+#include "engine/audio.h"
+#include "engine/bitmask.h"
+#include "engine/hotreload.h"
+#include "engine/input.h"
+#include "engine/parallax.h"
+#include "engine/particles.h"
+#include "engine/pipeline.h"
+#include "engine/texture.h"
 #include <stdbool.h>
+#include <string.h>
 #include <math.h>
 
 typedef struct { float x, y, w, h; } RectF;
@@ -18,29 +28,85 @@ static float maxSpeedPx   = 1200.0f; // > 15 m/s (1200/48 = 25 m/s)
 static float goalMeters   = 1000.0f;
 static bool levelCompleted;
 
-// Textures
-static Texture2D texPlayer; // fallback single frame
-static Texture2D texPlayerFrames[4];
-static int playerFrameCount;
-static int playerFrameIndex;
-static float playerFrameTimer; // accumulates time for frame switching
-static float playerFrameDuration = 0.12f; // ~8 FPS
-static Texture2D texObstacle;
+// Textures & animations (décrites dans assets/traffic/anims.ini)
+static const char *ANIM_MANIFEST = "assets/traffic/anims.ini";
+static AnimBank anims;
+static AnimPlayer playerAnim;
+static int clipCoin;
+static int obstacleClips[ANIM_MAX_CLIPS]; // variantes "obstacle*"
+static int obstacleClipCount;
+static float animClock;
 static Texture2D texRoad;
-static Texture2D texCoin;
-static bool texturesReady;
+static Texture2D texVerge;   // bas-côtés (optionnel)
+static Texture2D texScenery; // décor en parallaxe (optionnel, avec transparence)
+static ParallaxPass roadPass;
+static int layerVerge = -1, layerScenery = -1, layerRoad = -1;
+static int textureWatches[3] = { -1, -1, -1 }; // route, bas-côtés, décor (rechargement à chaud)
 static float roadScroll;
 
-#define MAX_OBS 32
+#define MAX_OBS 256
+#define OBSTACLE_W 64
+#define OBSTACLE_H 84
 static RectF obs[MAX_OBS];
+static int obsClip[MAX_OBS]; // variante tirée au spawn (-1 : rectangle)
 static int obsCount;
 static float spawnTimer;
+static float spawnDensity = 1.0f; // multiplie la cadence des obstacles et des pièces
 
-#define MAX_COINS 64
+#define MAX_COINS 256
+#define COIN_SIZE 24
 static RectF coins[MAX_COINS];
 static int coinCount;
 static float coinSpawnTimer;
 static int collectedCoins;
+static int coinEmitter[MAX_COINS]; // scintillement attaché à chaque pièce
+
+// Masques de collision par clip et par frame, à la taille d'affichage de
+// l'entité (construits au lancement depuis l'alpha des sprites) ; entités
+// dessinées sans sprite : masque de leur forme de secours
+static Bitmask clipMasks[ANIM_MAX_CLIPS][ANIM_MAX_CLIP_FRAMES];
+static Bitmask fallbackPlayerMask, fallbackObstacleMask, fallbackCoinMask;
+
+// Effets (bulles, étincelles, fumée du moteur)
+static const ParticlePreset FX_ENGINE_PUFF = {
+    PARTICLE_SPRITE_PUFF, 0.5f, 0.9f, 40.0f, 90.0f, PI*0.5f, 0.35f,
+    10.0f, 26.0f, 0.0f, 1.2f, 6.0f, { 235, 235, 235, 150 }, { 200, 200, 200, 0 }
+};
+static const ParticlePreset FX_COIN_GLINT = {
+    PARTICLE_SPRITE_STAR, 0.3f, 0.6f, 5.0f, 20.0f, -PI*0.5f, PI,
+    12.0f, 2.0f, 0.0f, 0.5f, 10.0f, { 255, 250, 200, 255 }, { 255, 215, 0, 0 }
+};
+static const ParticlePreset FX_COIN_SPARKLE = {
+    PARTICLE_SPRITE_STAR, 0.4f, 0.8f, 80.0f, 220.0f, -PI*0.5f, PI,
+    14.0f, 2.0f, 260.0f, 1.5f, 4.0f, { 255, 240, 120, 255 }, { 255, 180, 0, 0 }
+};
+static const ParticlePreset FX_CRASH_PUFF = {
+    PARTICLE_SPRITE_PUFF, 0.4f, 0.7f, 60.0f, 180.0f, 0.0f, PI,
+    16.0f, 40.0f, 0.0f, 2.5f, 12.0f, { 220, 220, 220, 200 }, { 160, 160, 170, 0 }
+};
+static const ParticlePreset FX_CRASH_BUBBLES = {
+    PARTICLE_SPRITE_BUBBLE, 0.6f, 1.2f, 40.0f, 120.0f, -PI*0.5f, 1.2f,
+    8.0f, 18.0f, -60.0f, 1.0f, 16.0f, { 190, 230, 255, 230 }, { 190, 230, 255, 0 }
+};
+static int fxEnginePuff, fxCoinGlint, fxCoinSparkle, fxCrashPuff, fxCrashBubbles;
+static int playerEmitter = -1;
+
+// État lu par mg_draw, publié après chaque mise à jour : la simulation de
+// l'image suivante peut tourner pendant le dessin (engine/pipeline.h)
+typedef struct {
+    RectF player;
+    AnimPlayer playerAnim;
+    float roadX, roadW, roadScroll;
+    float animClock;
+    float distancePixels, speedScroll;
+    int lives, collectedCoins;
+    RectF obs[MAX_OBS];
+    int obsClip[MAX_OBS];
+    int obsCount;
+    RectF coins[MAX_COINS];
+    int coinCount;
+} DrawState;
+static DrawState drawStates[2];
 
 static void resetTraffic(void) {
     roadW = GetScreenWidth() * 0.45f;
@@ -54,87 +120,139 @@ static void resetTraffic(void) {
     obsCount = 0; spawnTimer = 0.0f;
     lives = 3;
     distancePixels = 0.0f;
+    for (int i=0;i<coinCount;i++) ParticlesRemoveEmitter(coinEmitter[i]);
     coinCount = 0; coinSpawnTimer = 0.0f; collectedCoins = 0;
+    ParticlesSetEmitterActive(playerEmitter, true);
 }
 
 static bool intersect(const RectF *a, const RectF *b) {
     return !(a->x + a->w < b->x || b->x + b->w < a->x || a->y + a->h < b->y || b->y + b->h < a->y);
 }
 
-static RectF shrinkRect(RectF r, float padX, float padY) {
-    RectF s;
-    s.x = r.x + padX;
-    s.y = r.y + padY;
-    s.w = r.w - 2*padX;
-    s.h = r.h - 2*padY;
-    if (s.w < 0) s.w = 0; if (s.h < 0) s.h = 0;
-    return s;
+static void buildClipMasks(int clip, int width, int height) {
+    if (clip < 0) return;
+    for (int f = 0; f < anims.clips[clip].frameCount; ++f) {
+        if (!clipMasks[clip][f].bits) AnimFrameMask(&anims, clip, f, width, height, &clipMasks[clip][f]);
+    }
+}
+
+static void buildCollisionMasks(void) {
+    buildClipMasks(playerAnim.clip, (int)player.w, (int)player.h);
+    for (int i = 0; i < obstacleClipCount; ++i) buildClipMasks(obstacleClips[i], OBSTACLE_W, OBSTACLE_H);
+    buildClipMasks(clipCoin, COIN_SIZE, COIN_SIZE);
+    // Formes de secours : rectangles pleins, pièce en disque
+    if (BitmaskCreate(&fallbackPlayerMask, (int)player.w, (int)player.h)) BitmaskFill(&fallbackPlayerMask);
+    if (BitmaskCreate(&fallbackObstacleMask, OBSTACLE_W, OBSTACLE_H)) BitmaskFill(&fallbackObstacleMask);
+    if (BitmaskCreate(&fallbackCoinMask, COIN_SIZE, COIN_SIZE)) {
+        float r = COIN_SIZE * 0.5f;
+        for (int y = 0; y < COIN_SIZE; ++y) {
+            for (int x = 0; x < COIN_SIZE; ++x) {
+                float dx = x + 0.5f - r, dy = y + 0.5f - r;
+                if (dx*dx + dy*dy <= r*r) BitmaskSet(&fallbackCoinMask, x, y);
+            }
+        }
+    }
+}
+
+static void freeCollisionMasks(void) {
+    for (int c = 0; c < ANIM_MAX_CLIPS; ++c) {
+        for (int f = 0; f < ANIM_MAX_CLIP_FRAMES; ++f) BitmaskFree(&clipMasks[c][f]);
+    }
+    BitmaskFree(&fallbackPlayerMask);
+    BitmaskFree(&fallbackObstacleMask);
+    BitmaskFree(&fallbackCoinMask);
+}
+
+static const Bitmask *frameMask(int clip, int frame, const Bitmask *fallback) {
+    if (clip < 0 || frame < 0 || frame >= ANIM_MAX_CLIP_FRAMES || !clipMasks[clip][frame].bits) return fallback;
+    return &clipMasks[clip][frame];
+}
+
+// Boîtes englobantes d'abord, puis masques alignés au pixel (mots de 64 bits)
+static bool spritesCollide(const RectF *a, const Bitmask *maskA, const RectF *b, const Bitmask *maskB) {
+    if (!intersect(a, b)) return false;
+    return BitmaskOverlap(maskA, (int)floorf(a->x), (int)floorf(a->y), maskB, (int)floorf(b->x), (int)floorf(b->y));
 }
 
 static void spawnObstacle(void) {
     if (obsCount >= MAX_OBS) return;
     RectF r;
     // Obstacles plus gros et position aléatoire sur toute la largeur
-    r.w = 64; r.h = 84;
+    r.w = OBSTACLE_W; r.h = OBSTACLE_H;
     int maxOffset = (int)(roadW - r.w);
     if (maxOffset < 0) maxOffset = 0;
     r.x = roadX + (float)GetRandomValue(0, maxOffset);
     r.y = -r.h - 10.0f;
+    obsClip[obsCount] = obstacleClipCount > 0 ? obstacleClips[GetRandomValue(0, obstacleClipCount - 1)] : -1;
     obs[obsCount++] = r;
 }
 
 static void spawnCoin(void) {
     if (coinCount >= MAX_COINS) return;
     RectF c;
-    c.w = 24; c.h = 24;
+    c.w = COIN_SIZE; c.h = COIN_SIZE;
     int maxOffset = (int)(roadW - c.w);
     if (maxOffset < 0) maxOffset = 0;
     c.x = roadX + (float)GetRandomValue(0, maxOffset);
     c.y = -c.h - 10.0f;
+    coinEmitter[coinCount] = ParticlesAddEmitter(fxCoinGlint, 6.0f);
     coins[coinCount++] = c;
 }
 
+// Texture modifiée sur disque : identifiant conservé si la taille ne change pas,
+// sinon les couches reprennent la nouvelle texture
+static void roadTexturesReloaded(void *arg) {
+    (void)arg;
+    ParallaxSetLayerTexture(&roadPass, layerRoad, texRoad);
+    ParallaxSetLayerTexture(&roadPass, layerVerge, texVerge);
+    ParallaxSetLayerTexture(&roadPass, layerScenery, texScenery);
+}
+
 static void mg_init(void) {
+    // Effets : presets et émetteurs propres à ce mini-jeu
+    coinCount = 0;
+    ParticlesClear();
+    fxEnginePuff = ParticlesRegisterPreset(&FX_ENGINE_PUFF);
+    fxCoinGlint = ParticlesRegisterPreset(&FX_COIN_GLINT);
+    fxCoinSparkle = ParticlesRegisterPreset(&FX_COIN_SPARKLE);
+    fxCrashPuff = ParticlesRegisterPreset(&FX_CRASH_PUFF);
+    fxCrashBubbles = ParticlesRegisterPreset(&FX_CRASH_BUBBLES);
+    playerEmitter = ParticlesAddEmitter(fxEnginePuff, 24.0f);
+
     resetTraffic();
-    texturesReady = false;
+    ParticlesAttachEmitter(playerEmitter, &player.x, &player.y, (Vector2){ player.w*0.5f, player.h - 6.0f });
     roadScroll = 0.0f;
     levelCompleted = false;
-
-    texPlayer = (Texture2D){0};
-    texObstacle = (Texture2D){0};
-    texRoad = (Texture2D){0};
-    texCoin = (Texture2D){0};
-    for (int i=0;i<4;i++) texPlayerFrames[i] = (Texture2D){0};
-    playerFrameCount = 0;
-    playerFrameIndex = 0;
-    playerFrameTimer = 0.0f;
-
-    // Chargement optionnel des textures (fallback sur rectangles si absent)
-    Image img = LoadImage("assets/traffic/player1.png");
-    if (img.data) { texPlayerFrames[playerFrameCount++] = LoadTextureFromImage(img); UnloadImage(img); }
-    img = LoadImage("assets/traffic/player2.png");
-    if (img.data) { texPlayerFrames[playerFrameCount++] = LoadTextureFromImage(img); UnloadImage(img); }
-    // Fallback single-frame sprite if no numbered frames present
-    if (playerFrameCount == 0) {
-        img = LoadImage("assets/traffic/player.png");
-        if (img.data) { texPlayer = LoadTextureFromImage(img); UnloadImage(img); }
-    }
-
-    img = LoadImage("assets/traffic/obstacle1.png");
-    if (img.data) { texObstacle = LoadTextureFromImage(img); UnloadImage(img); }
-
-    img = LoadImage("assets/traffic/road.png");
-    if (img.data) { texRoad = LoadTextureFromImage(img); UnloadImage(img); }
-
-    img = LoadImage("assets/traffic/coin.png");
-    if (img.data) { texCoin = LoadTextureFromImage(img); UnloadImage(img); }
-
-    texturesReady = ((playerFrameCount > 0) || (texPlayer.id != 0)) && (texObstacle.id != 0);
+    animClock = 0.0f;
+
+    // Sprites : une texture par feuille, clips absents -> rectangles de secours
+    AnimLoadManifest(&anims, ANIM_MANIFEST);
+    playerAnim = (AnimPlayer){ .clip = -1 };
+    AnimPlay(&playerAnim, AnimFindClip(&anims, "player_run"));
+    clipCoin = AnimFindClip(&anims, "coin");
+    obstacleClipCount = AnimFindClipsWithPrefix(&anims, "obstacle", obstacleClips, ANIM_MAX_CLIPS);
+    buildCollisionMasks();
+
+    texRoad = TextureLoad("assets/traffic/road.png"); // .dds compressé si présent
+    texVerge = TextureLoad("assets/traffic/verge.png");
+    texScenery = TextureLoad("assets/traffic/scenery.png");
+
+    // Route + couches de parallaxe : un seul quad, composé par le shader
+    Rectangle screen = { 0, 0, (float)GetScreenWidth(), (float)GetScreenHeight() };
+    ParallaxInit(&roadPass);
+    layerVerge = ParallaxAddLayer(&roadPass, texVerge, screen, 256.0f, 1.0f);
+    layerScenery = ParallaxAddLayer(&roadPass, texScenery, screen, 512.0f, 1.25f);
+    layerRoad = ParallaxAddLayer(&roadPass, texRoad, (Rectangle){ roadX, 0, roadW, screen.height }, 0.0f, 1.0f);
+
+    textureWatches[0] = HotReloadWatchTexture("assets/traffic/road.png", &texRoad, roadTexturesReloaded, NULL);
+    textureWatches[1] = HotReloadWatchTexture("assets/traffic/verge.png", &texVerge, roadTexturesReloaded, NULL);
+    textureWatches[2] = HotReloadWatchTexture("assets/traffic/scenery.png", &texScenery, roadTexturesReloaded, NULL);
 }
 
 static void mg_update(float dt) {
+    ParticlesUpdate(dt);
     if (lives <= 0) {
-        if (IsKeyPressed(KEY_R)) resetTraffic();
+        if (InputKeyPressed(KEY_R)) resetTraffic();
         return;
     }
 
@@ -145,10 +263,10 @@ static void mg_update(float dt) {
         float maxX = roadX + roadW - player.w;
         float minY = 10.0f;
         float maxY = GetScreenHeight() - player.h - 10.0f;
-        if (IsKeyDown(KEY_LEFT))  player.x -= moveSpeedX * dt;
-        if (IsKeyDown(KEY_RIGHT)) player.x += moveSpeedX * dt;
-        if (IsKeyDown(KEY_UP))    player.y -= moveSpeedY * dt;
-        if (IsKeyDown(KEY_DOWN))  player.y += moveSpeedY * dt;
+        if (InputKeyDown(KEY_LEFT))  player.x -= moveSpeedX * dt;
+        if (InputKeyDown(KEY_RIGHT)) player.x += moveSpeedX * dt;
+        if (InputKeyDown(KEY_UP))    player.y -= moveSpeedY * dt;
+        if (InputKeyDown(KEY_DOWN))  player.y += moveSpeedY * dt;
         if (player.x < roadX) player.x = roadX;
         if (player.x > maxX)  player.x = maxX;
         if (player.y < minY)  player.y = minY;
@@ -159,12 +277,12 @@ static void mg_update(float dt) {
     spawnTimer -= dt;
     if (spawnTimer <= 0.0f) {
         spawnObstacle();
-        spawnTimer = 0.8f; // cadence
+        spawnTimer = 0.8f / spawnDensity; // cadence
     }
     coinSpawnTimer -= dt;
     if (coinSpawnTimer <= 0.0f) {
         spawnCoin();
-        coinSpawnTimer = 1.2f; // coins slightly less frequent
+        coinSpawnTimer = 1.2f / spawnDensity; // coins slightly less frequent
     }
 
     // Update obstacles
@@ -174,15 +292,11 @@ static void mg_update(float dt) {
     // Update coins
     for (int i=0;i<coinCount;i++) {
         coins[i].y += speedScroll * dt;
+        ParticlesSetEmitterPosition(coinEmitter[i], (Vector2){ coins[i].x + coins[i].w*0.5f, coins[i].y + coins[i].h*0.5f });
     }
-    // Player animation (loops while running)
-    if (playerFrameCount > 1) {
-        playerFrameTimer += dt;
-        while (playerFrameTimer >= playerFrameDuration) {
-            playerFrameTimer -= playerFrameDuration;
-            playerFrameIndex = (playerFrameIndex + 1) % playerFrameCount;
-        }
-    }
+    // Animations (joueur en boucle, obstacles échantillonnés sur l'horloge commune)
+    AnimUpdate(&anims, &playerAnim, dt);
+    animClock += dt;
     // Road visual scroll (purement visuel)
     roadScroll -= speedScroll * dt;
     // Score/distance and dynamic speed increase
@@ -191,28 +305,39 @@ static void mg_update(float dt) {
     if (speedScroll > maxSpeedPx) speedScroll = maxSpeedPx;
     // Remove off-screen
     int w = 0;
-    for (int i=0;i<obsCount;i++) if (obs[i].y < GetScreenHeight()+20) obs[w++] = obs[i];
+    for (int i=0;i<obsCount;i++) if (obs[i].y < GetScreenHeight()+20) { obsClip[w] = obsClip[i]; obs[w++] = obs[i]; }
     obsCount = w;
     w = 0;
-    for (int i=0;i<coinCount;i++) if (coins[i].y < GetScreenHeight()+20) coins[w++] = coins[i];
+    for (int i=0;i<coinCount;i++) {
+        if (coins[i].y < GetScreenHeight()+20) { coinEmitter[w] = coinEmitter[i]; coins[w++] = coins[i]; }
+        else ParticlesRemoveEmitter(coinEmitter[i]);
+    }
     coinCount = w;
 
-    // Collisions
+    // Collisions (au pixel près, sur l'alpha des sprites)
+    const Bitmask *playerMask = frameMask(playerAnim.clip, playerAnim.frame, &fallbackPlayerMask);
     for (int i=0;i<obsCount;i++) {
-        RectF pbox = shrinkRect(player, 8, 8);
-        RectF obox = shrinkRect(obs[i], 10, 12);
-        if (intersect(&pbox, &obox)) {
+        int frame = obsClip[i] >= 0 ? AnimFrameAt(&anims, obsClip[i], animClock) : -1;
+        if (spritesCollide(&player, playerMask, &obs[i], frameMask(obsClip[i], frame, &fallbackObstacleMask))) {
+            Vector2 hit = { obs[i].x + obs[i].w*0.5f, obs[i].y + obs[i].h };
+            ParticlesBurst(fxCrashPuff, hit, 18);
+            ParticlesBurst(fxCrashBubbles, hit, 10);
+            // mg_update tourne sur le thread de simulation : seul producteur de la file audio pendant ce temps
+            AudioPlaySfx(SFX_CRASH);
             lives -= 1;
+            if (lives <= 0) ParticlesSetEmitterActive(playerEmitter, false);
             // knockback
             player.y += 12;
             obs[i].y = GetScreenHeight()+100; // discard
         }
     }
+    const Bitmask *coinMask = frameMask(clipCoin, clipCoin >= 0 ? AnimFrameAt(&anims, clipCoin, animClock) : -1, &fallbackCoinMask);
     for (int i=0;i<coinCount;i++) {
-        RectF pbox = shrinkRect(player, 8, 8);
-        RectF cbox = shrinkRect(coins[i], 4, 4);
-        if (intersect(&pbox, &cbox)) {
+        if (spritesCollide(&player, playerMask, &coins[i], coinMask)) {
             collectedCoins += 1;
+            AudioPlaySfx(SFX_COIN);
+            ParticlesBurst(fxCoinSparkle, (Vector2){ coins[i].x + coins[i].w*0.5f, coins[i].y + coins[i].h*0.5f }, 24);
+            ParticlesSetEmitterActive(coinEmitter[i], false);
             coins[i].y = GetScreenHeight()+100; // discard
         }
     }
@@ -224,85 +349,102 @@ static void mg_update(float dt) {
     }
 }
 
+static void mg_publish(void) {
+    DrawState *d = &drawStates[PipelineBackSlot()];
+    d->player = player;
+    d->playerAnim = playerAnim;
+    d->roadX = roadX; d->roadW = roadW; d->roadScroll = roadScroll;
+    d->animClock = animClock;
+    d->distancePixels = distancePixels; d->speedScroll = speedScroll;
+    d->lives = lives; d->collectedCoins = collectedCoins;
+    d->obsCount = obsCount;
+    memcpy(d->obs, obs, sizeof(RectF) * obsCount);
+    memcpy(d->obsClip, obsClip, sizeof(int) * obsCount);
+    d->coinCount = coinCount;
+    memcpy(d->coins, coins, sizeof(RectF) * coinCount);
+    ParticlesPublish();
+}
+
 static void mg_draw(void) {
-    // Route (texture répétée si disponible, sinon rectangles)
-    if (texRoad.id) {
-        float scale = roadW / (float)texRoad.width;
-        float tileH = texRoad.height * scale;
-        // point de départ pour bouclage
-        float startY = fmodf(-roadScroll, tileH);
-        if (startY > 0) startY -= tileH; // s'assurer de commencer au‑dessus
-        for (float y = startY; y < GetScreenHeight(); y += tileH) {
-            Rectangle src = { 0, 0, (float)texRoad.width, (float)texRoad.height };
-            Rectangle dst = { roadX, y, roadW, tileH };
-            DrawTexturePro(texRoad, src, dst, (Vector2){0,0}, 0.0f, WHITE);
-        }
-    } else {
-        DrawRectangle((int)roadX, 0, (int)roadW, GetScreenHeight(), (Color){ 40, 40, 40, 255 });
-        for (int y=-40;y<GetScreenHeight();y+=60) DrawRectangle((int)(roadX+roadW/2-4), y, 8, 30, (Color){220,220,220,180});
+    const DrawState *d = &drawStates[PipelineFrontSlot()];
+    // Route et bas-côtés (un quad, défilement dans le shader), sinon rectangles
+    Rectangle screen = { 0, 0, (float)GetScreenWidth(), (float)GetScreenHeight() };
+    ParallaxSetLayerArea(&roadPass, layerVerge, screen, 256.0f);
+    ParallaxSetLayerArea(&roadPass, layerScenery, screen, 512.0f);
+    ParallaxSetLayerArea(&roadPass, layerRoad, (Rectangle){ d->roadX, 0, d->roadW, screen.height }, 0.0f);
+    ParallaxDraw(&roadPass, -d->roadScroll);
+    if (layerRoad < 0) {
+        DrawRectangle((int)d->roadX, 0, (int)d->roadW, GetScreenHeight(), (Color){ 40, 40, 40, 255 });
+        for (int y=-40;y<GetScreenHeight();y+=60) DrawRectangle((int)(d->roadX+d->roadW/2-4), y, 8, 30, (Color){220,220,220,180});
     }
 
     // Joueur
-    if (playerFrameCount > 0 && texPlayerFrames[playerFrameIndex].id) {
-        Texture2D t = texPlayerFrames[playerFrameIndex];
-        Rectangle src = { 0, 0, (float)t.width, (float)t.height };
-        Rectangle dst = { player.x, player.y, player.w, player.h };
-        DrawTexturePro(t, src, dst, (Vector2){0,0}, 0.0f, WHITE);
-    } else if (texturesReady && texPlayer.id) {
-        Rectangle src = { 0, 0, (float)texPlayer.width, (float)texPlayer.height };
-        Rectangle dst = { player.x, player.y, player.w, player.h };
-        DrawTexturePro(texPlayer, src, dst, (Vector2){0,0}, 0.0f, WHITE);
+    const RectF *p = &d->player;
+    if (d->playerAnim.clip >= 0) {
+        AnimDraw(&anims, &d->playerAnim, (Rectangle){ p->x, p->y, p->w, p->h }, WHITE);
     } else {
-        DrawRectangle((int)player.x, (int)player.y, (int)player.w, (int)player.h, (Color){255, 190, 80, 255});
+        DrawRectangle((int)p->x, (int)p->y, (int)p->w, (int)p->h, (Color){255, 190, 80, 255});
     }
 
     // Obstacles
-    for (int i=0;i<obsCount;i++) {
-        if (texturesReady && texObstacle.id) {
-            Rectangle src = { 0, 0, (float)texObstacle.width, (float)texObstacle.height };
-            Rectangle dst = { obs[i].x, obs[i].y, obs[i].w, obs[i].h };
-            DrawTexturePro(texObstacle, src, dst, (Vector2){0,0}, 0.0f, WHITE);
+    for (int i=0;i<d->obsCount;i++) {
+        const RectF *o = &d->obs[i];
+        if (d->obsClip[i] >= 0) {
+            Rectangle dst = { o->x, o->y, o->w, o->h };
+            AnimDrawFrame(&anims, d->obsClip[i], AnimFrameAt(&anims, d->obsClip[i], d->animClock), dst, WHITE);
         } else {
-            DrawRectangle((int)obs[i].x, (int)obs[i].y, (int)obs[i].w, (int)obs[i].h, (Color){200,80,80,255});
+            DrawRectangle((int)o->x, (int)o->y, (int)o->w, (int)o->h, (Color){200,80,80,255});
         }
     }
 
     // Coins
-    for (int i=0;i<coinCount;i++) {
-        if (texCoin.id) {
-            Rectangle src = { 0, 0, (float)texCoin.width, (float)texCoin.height };
-            Rectangle dst = { coins[i].x, coins[i].y, coins[i].w, coins[i].h };
-            DrawTexturePro(texCoin, src, dst, (Vector2){0,0}, 0.0f, WHITE);
+    for (int i=0;i<d->coinCount;i++) {
+        const RectF *c = &d->coins[i];
+        if (clipCoin >= 0) {
+            Rectangle dst = { c->x, c->y, c->w, c->h };
+            AnimDrawFrame(&anims, clipCoin, AnimFrameAt(&anims, clipCoin, d->animClock), dst, WHITE);
         } else {
-            DrawCircle((int)(coins[i].x + coins[i].w*0.5f), (int)(coins[i].y + coins[i].h*0.5f), coins[i].w*0.5f, (Color){255, 216, 0, 255});
+            DrawCircle((int)(c->x + c->w*0.5f), (int)(c->y + c->h*0.5f), c->w*0.5f, (Color){255, 216, 0, 255});
         }
     }
 
+    // Effets (un seul draw call pour toutes les particules)
+    ParticlesDraw();
+
     // HUD
-    DrawText(TextFormat("Vies: %d  |  Gauche/Droite pour bouger  |  R pour recommencer", lives), 20, 20, 18, LIGHTGRAY);
+    DrawText(TextFormat("Vies: %d  |  Gauche/Droite pour bouger  |  R pour recommencer", d->lives), 20, 20, 18, LIGHTGRAY);
     // Retro-style top-right speed & distance & coins
     {
-        float meters = distancePixels / pixelsPerMeter;
-        float speedMs = speedScroll / pixelsPerMeter;
+        float meters = d->distancePixels / pixelsPerMeter;
+        float speedMs = d->speedScroll / pixelsPerMeter;
         const int fontSize = 20;
         const int margin = 20;
-        const char *hud = TextFormat("%0.1f m  |  %0.1f m/s  |  %d", meters, speedMs, collectedCoins);
+        const char *hud = TextFormat("%0.1f m  |  %0.1f m/s  |  %d", meters, speedMs, d->collectedCoins);
         int w = MeasureText(hud, fontSize);
         int x = GetScreenWidth() - margin - w;
         int y = 16;
         DrawText(hud, x+1, y+1, fontSize, (Color){20,20,20,180});
         DrawText(hud, x,   y,   fontSize, (Color){255, 240, 160, 255});
     }
-    if (lives <= 0) DrawText("Oups! Tu as perdu. Appuie sur R pour rejouer.", 20, 60, 24, (Color){255,230,120,255});
+    if (d->lives <= 0) DrawText("Oups! Tu as perdu. Appuie sur R pour rejouer.", 20, 60, 24, (Color){255,230,120,255});
 }
 
 static void mg_unload(void) {
-    if (texPlayer.id) UnloadTexture(texPlayer);
-    for (int i=0;i<playerFrameCount;i++) if (texPlayerFrames[i].id) UnloadTexture(texPlayerFrames[i]);
-    if (texObstacle.id) UnloadTexture(texObstacle);
+    AnimUnloadBank(&anims);
+    playerAnim.clip = -1;
+    clipCoin = -1;
+    obstacleClipCount = 0;
+    for (int i = 0; i < 3; ++i) { HotReloadUnwatch(textureWatches[i]); textureWatches[i] = -1; }
+    freeCollisionMasks();
+    ParallaxUnload(&roadPass);
+    layerVerge = layerScenery = layerRoad = -1;
     if (texRoad.id) UnloadTexture(texRoad);
-    if (texCoin.id) UnloadTexture(texCoin);
-    texturesReady = false;
+    if (texVerge.id) UnloadTexture(texVerge);
+    if (texScenery.id) UnloadTexture(texScenery);
+    texRoad = texVerge = texScenery = (Texture2D){0};
+    ParticlesClear();
+    playerEmitter = -1;
+    coinCount = 0;
 }
 
 static bool mg_isCompleted(int *coinsOut) {
@@ -310,8 +452,12 @@ static bool mg_isCompleted(int *coinsOut) {
     return levelCompleted;
 }
 
+void TrafficSetDensity(float factor) {
+    spawnDensity = factor > 0.1f ? factor : 0.1f;
+}
+
 MinigameAPI GetMinigameTraffic(void) {
-    MinigameAPI api = { mg_init, mg_update, mg_draw, mg_unload, mg_isCompleted };
+    MinigameAPI api = { mg_init, mg_update, mg_draw, mg_unload, mg_isCompleted, mg_publish };
     return api;
 }
 
@@ -4,6 +4,8 @@
 #include "minigame.h"
 
 MinigameAPI GetMinigameTraffic(void);
+// Cadence des obstacles et des pièces (1 : normal ; utilisé par le bench "dense")
+void TrafficSetDensity(float factor);
 
 #endif // MINIGAME_TRAFFIC_H
 
@@ -0,0 +1,48 @@
+// Outil hors ligne : génère un paquet de niveaux Pousse-Pousse trié par difficulté
+//   levelgen [nombre] [graine] [fichier.xsb]
+#include "pousse_pousse/level_gen.h"
+#include "engine/jobs.h"
+#include "engine/thread.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+int main(int argc, char **argv) {
+    LevelGenParams params;
+    LevelGenDefaults(&params);
+    const char *path = "assets/pousse_pousse/generated.xsb";
+    if (argc > 1) params.count = atoi(argv[1]);
+    if (argc > 2) params.seed = (unsigned int)strtoul(argv[2], NULL, 10);
+    if (argc > 3) path = argv[3];
+
+    JobsInit(ThreadHardwareConcurrency()); // le thread principal ne fait qu'attendre
+    double start = ThreadNowSeconds();
+    LevelGenJob *job = LevelGenStart(&params);
+    if (!job) {
+        fprintf(stderr, "levelgen: impossible de lancer la génération\n");
+        return 1;
+    }
+    // sans thread de travail, LevelGenFinish génère tout sur ce thread
+    while (JobsWorkerCount() > 0 && !LevelGenDone(job)) {
+        fprintf(stderr, "\r%d/%d", LevelGenProgress(job), params.count);
+        ThreadSleepMs(100);
+    }
+    GeneratedLevel *levels = NULL;
+    int count = LevelGenFinish(job, &levels);
+    double elapsed = ThreadNowSeconds() - start;
+
+    if (count < params.count) {
+        fprintf(stderr, "\rlevelgen: abandon après %d/%d niveaux (paramètres trop stricts ?)\n", count, params.count);
+        LevelGenFree(levels, count);
+        JobsShutdown();
+        return 1;
+    }
+    bool ok = LevelGenWritePack(levels, count, path);
+    fprintf(stderr, "\r%d niveaux en %.2f s (%d threads) -> %s\n", count, elapsed, JobsWorkerCount(), ok ? path : "échec d'écriture");
+    if (count > 0) {
+        fprintf(stderr, "difficulté : %.0f (min) .. %.0f (max), poussées %d .. %d\n",
+                levels[0].difficulty, levels[count - 1].difficulty, levels[0].pushes, levels[count - 1].pushes);
+    }
+    LevelGenFree(levels, count);
+    JobsShutdown();
+    return ok ? 0 : 1;
+}
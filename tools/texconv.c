@@ -0,0 +1,277 @@
+// Outil hors ligne : convertit les grandes images en textures compressées GPU
+//   texconv                    liste par défaut (fonds du menu, couches de Traffic)
+//   texconv image.png [...]    écrit image.dds à côté de chaque image
+// BC1 (DXT1, 4 bits/pixel) pour les images opaques, BC3 (DXT5, 8 bits/pixel)
+// dès qu'un pixel est transparent ; chaîne de mips complète, filtre boîte
+// pondéré par l'alpha. Le jeu charge le .dds tant qu'il est plus récent que
+// le PNG (engine/texture.h).
+#include "raylib.h"
+#include "engine/texture.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *DEFAULT_IMAGES[] = {
+    "assets/imagefond.png",
+    "assets/nounoursmenu.png",
+    "assets/traffic/road.png",
+    "assets/traffic/verge.png",
+    "assets/traffic/scenery.png",
+};
+
+typedef struct {
+    int width, height;
+    uint8_t *rgba;
+} Level;
+
+static uint16_t pack565(const float c[3]) {
+    int r = (int)lroundf(fminf(fmaxf(c[0], 0.0f), 255.0f) * 31.0f / 255.0f);
+    int g = (int)lroundf(fminf(fmaxf(c[1], 0.0f), 255.0f) * 63.0f / 255.0f);
+    int b = (int)lroundf(fminf(fmaxf(c[2], 0.0f), 255.0f) * 31.0f / 255.0f);
+    return (uint16_t)((r << 11) | (g << 5) | b);
+}
+
+static void unpack565(uint16_t v, int out[3]) {
+    int r = (v >> 11) & 31, g = (v >> 5) & 63, b = v & 31;
+    out[0] = (r << 3) | (r >> 2);
+    out[1] = (g << 2) | (g >> 4);
+    out[2] = (b << 3) | (b >> 2);
+}
+
+static void put16(uint8_t *dst, uint16_t v) {
+    dst[0] = (uint8_t)(v & 0xFF);
+    dst[1] = (uint8_t)(v >> 8);
+}
+
+// Bloc couleur BC1 (8 octets), mode 4 couleurs : extrémités sur l'axe
+// principal des 16 pixels, légèrement rentrées pour limiter l'erreur
+static void encodeColorBlock(const uint8_t block[16][4], uint8_t *dst) {
+    float mean[3] = { 0 };
+    for (int i = 0; i < 16; ++i) for (int c = 0; c < 3; ++c) mean[c] += block[i][c] / 16.0f;
+    float cov[6] = { 0 }; // rr rg rb gg gb bb
+    for (int i = 0; i < 16; ++i) {
+        float d[3] = { block[i][0] - mean[0], block[i][1] - mean[1], block[i][2] - mean[2] };
+        cov[0] += d[0]*d[0]; cov[1] += d[0]*d[1]; cov[2] += d[0]*d[2];
+        cov[3] += d[1]*d[1]; cov[4] += d[1]*d[2]; cov[5] += d[2]*d[2];
+    }
+    float axis[3] = { 1.0f, 1.0f, 1.0f };
+    for (int it = 0; it < 8; ++it) { // itération de la puissance
+        float x = cov[0]*axis[0] + cov[1]*axis[1] + cov[2]*axis[2];
+        float y = cov[1]*axis[0] + cov[3]*axis[1] + cov[4]*axis[2];
+        float z = cov[2]*axis[0] + cov[4]*axis[1] + cov[5]*axis[2];
+        float len = sqrtf(x*x + y*y + z*z);
+        if (len < 1e-6f) break;
+        axis[0] = x / len; axis[1] = y / len; axis[2] = z / len;
+    }
+    float lo = 1e9f, hi = -1e9f;
+    for (int i = 0; i < 16; ++i) {
+        float t = (block[i][0] - mean[0])*axis[0] + (block[i][1] - mean[1])*axis[1] + (block[i][2] - mean[2])*axis[2];
+        if (t < lo) lo = t;
+        if (t > hi) hi = t;
+    }
+    float inset = (hi - lo) / 32.0f;
+    lo += inset; hi -= inset;
+    float cmax[3], cmin[3];
+    for (int c = 0; c < 3; ++c) { cmax[c] = mean[c] + axis[c]*hi; cmin[c] = mean[c] + axis[c]*lo; }
+
+    uint16_t c0 = pack565(cmax), c1 = pack565(cmin);
+    if (c0 < c1) { uint16_t t = c0; c0 = c1; c1 = t; }
+    put16(dst, c0);
+    put16(dst + 2, c1);
+    uint32_t indices = 0;
+    if (c0 != c1) { // c0 == c1 : bloc uni, indices à 0
+        int p[4][3];
+        unpack565(c0, p[0]);
+        unpack565(c1, p[1]);
+        for (int c = 0; c < 3; ++c) {
+            p[2][c] = (2*p[0][c] + p[1][c]) / 3;
+            p[3][c] = (p[0][c] + 2*p[1][c]) / 3;
+        }
+        for (int i = 0; i < 16; ++i) {
+            int best = 0, bestDist = 1 << 30;
+            for (int k = 0; k < 4; ++k) {
+                int dr = block[i][0] - p[k][0], dg = block[i][1] - p[k][1], db = block[i][2] - p[k][2];
+                int dist = dr*dr + dg*dg + db*db;
+                if (dist < bestDist) { bestDist = dist; best = k; }
+            }
+            indices |= (uint32_t)best << (2*i);
+        }
+    }
+    for (int b = 0; b < 4; ++b) dst[4 + b] = (uint8_t)(indices >> (8*b));
+}
+
+// Bloc alpha BC3 (8 octets), mode 8 niveaux entre le min et le max
+static void encodeAlphaBlock(const uint8_t block[16][4], uint8_t *dst) {
+    int a0 = 0, a1 = 255;
+    for (int i = 0; i < 16; ++i) {
+        if (block[i][3] > a0) a0 = block[i][3];
+        if (block[i][3] < a1) a1 = block[i][3];
+    }
+    dst[0] = (uint8_t)a0;
+    dst[1] = (uint8_t)a1;
+    uint64_t indices = 0;
+    if (a0 != a1) {
+        int levels[8] = { a0, a1 };
+        for (int k = 1; k < 7; ++k) levels[k + 1] = ((7 - k)*a0 + k*a1) / 7;
+        for (int i = 0; i < 16; ++i) {
+            int best = 0, bestDist = 1 << 30;
+            for (int k = 0; k < 8; ++k) {
+                int d = abs(block[i][3] - levels[k]);
+                if (d < bestDist) { bestDist = d; best = k; }
+            }
+            indices |= (uint64_t)best << (3*i);
+        }
+    }
+    for (int b = 0; b < 6; ++b) dst[2 + b] = (uint8_t)(indices >> (8*b));
+}
+
+static size_t levelSize(int width, int height, int blockBytes) {
+    return (size_t)((width + 3) / 4) * (size_t)((height + 3) / 4) * (size_t)blockBytes;
+}
+
+static void compressLevel(const Level *level, bool alpha, uint8_t *dst) {
+    int blockBytes = alpha ? 16 : 8;
+    for (int by = 0; by < level->height; by += 4) {
+        for (int bx = 0; bx < level->width; bx += 4) {
+            uint8_t block[16][4];
+            for (int i = 0; i < 16; ++i) { // bords : pixels répétés
+                int x = bx + (i & 3), y = by + (i >> 2);
+                if (x >= level->width) x = level->width - 1;
+                if (y >= level->height) y = level->height - 1;
+                memcpy(block[i], &level->rgba[((size_t)y * level->width + x) * 4], 4);
+            }
+            if (alpha) {
+                encodeAlphaBlock(block, dst);
+                encodeColorBlock(block, dst + 8);
+            } else {
+                encodeColorBlock(block, dst);
+            }
+            dst += blockBytes;
+        }
+    }
+}
+
+// Niveau suivant : moyenne 2x2, couleurs pondérées par l'alpha (pas de halo
+// sombre autour des zones transparentes)
+static Level downsample(const Level *src) {
+    Level dst = { src->width > 1 ? src->width / 2 : 1, src->height > 1 ? src->height / 2 : 1, NULL };
+    dst.rgba = malloc((size_t)dst.width * dst.height * 4);
+    if (!dst.rgba) return dst;
+    for (int y = 0; y < dst.height; ++y) {
+        for (int x = 0; x < dst.width; ++x) {
+            float sum[4] = { 0 };
+            for (int s = 0; s < 4; ++s) {
+                int sx = x*2 + (s & 1), sy = y*2 + (s >> 1);
+                if (sx >= src->width) sx = src->width - 1;
+                if (sy >= src->height) sy = src->height - 1;
+                const uint8_t *p = &src->rgba[((size_t)sy * src->width + sx) * 4];
+                float a = p[3] / 255.0f;
+                for (int c = 0; c < 3; ++c) sum[c] += p[c] * a;
+                sum[3] += a;
+            }
+            uint8_t *q = &dst.rgba[((size_t)y * dst.width + x) * 4];
+            for (int c = 0; c < 3; ++c) q[c] = sum[3] > 0.0f ? (uint8_t)lroundf(sum[c] / sum[3]) : 0;
+            q[3] = (uint8_t)lroundf(sum[3] / 4.0f * 255.0f);
+        }
+    }
+    return dst;
+}
+
+static void writeU32(FILE *f, uint32_t v) {
+    uint8_t b[4] = { (uint8_t)v, (uint8_t)(v >> 8), (uint8_t)(v >> 16), (uint8_t)(v >> 24) };
+    fwrite(b, 1, 4, f);
+}
+
+static void writeDdsHeader(FILE *f, int width, int height, int mipmaps, bool alpha, uint32_t linearSize) {
+    fwrite("DDS ", 1, 4, f);
+    writeU32(f, 124);                                   // taille de l'en-tête
+    writeU32(f, 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000 | 0x80000); // CAPS HEIGHT WIDTH PIXELFORMAT MIPMAPCOUNT LINEARSIZE
+    writeU32(f, (uint32_t)height);
+    writeU32(f, (uint32_t)width);
+    writeU32(f, linearSize);
+    writeU32(f, 0);                                     // profondeur
+    writeU32(f, (uint32_t)mipmaps);
+    for (int i = 0; i < 11; ++i) writeU32(f, 0);
+    writeU32(f, 32);                                    // DDS_PIXELFORMAT
+    writeU32(f, 0x4);                                   // FOURCC seul (raylib : DXT1 sans alpha)
+    fwrite(alpha ? "DXT5" : "DXT1", 1, 4, f);
+    for (int i = 0; i < 5; ++i) writeU32(f, 0);
+    writeU32(f, 0x1000 | 0x400000 | 0x8);               // TEXTURE MIPMAP COMPLEX
+    for (int i = 0; i < 4; ++i) writeU32(f, 0);
+}
+
+static bool convert(const char *path) {
+    char outPath[TEXTURE_PATH_LEN];
+    if (!TextureCompressedPath(path, outPath, sizeof(outPath))) {
+        fprintf(stderr, "texconv: %s : chemin sans extension\n", path);
+        return false;
+    }
+    Image image = LoadImage(path);
+    if (!image.data) {
+        fprintf(stderr, "texconv: %s : image illisible\n", path);
+        return false;
+    }
+    ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    Level level = { image.width, image.height, image.data };
+    bool alpha = false;
+    for (size_t i = 0; i < (size_t)level.width * level.height && !alpha; ++i) alpha = level.rgba[i*4 + 3] < 255;
+
+    int blockBytes = alpha ? 16 : 8;
+    int mipmaps = 1;
+    size_t total = levelSize(level.width, level.height, blockBytes);
+    for (int w = level.width, h = level.height; w > 1 || h > 1; ++mipmaps) {
+        w = w > 1 ? w / 2 : 1;
+        h = h > 1 ? h / 2 : 1;
+        total += levelSize(w, h, blockBytes);
+    }
+    // raylib lit 1,5 x la taille du niveau 0 dès qu'il y a des mips : le
+    // fichier est complété jusque-là
+    size_t base = levelSize(level.width, level.height, blockBytes);
+    size_t padded = total > base + base / 2 ? total : base + base / 2;
+    uint8_t *data = calloc(padded, 1);
+    if (!data) { UnloadImage(image); return false; }
+
+    uint8_t *dst = data;
+    Level current = level;
+    for (int m = 0; m < mipmaps; ++m) {
+        compressLevel(&current, alpha, dst);
+        dst += levelSize(current.width, current.height, blockBytes);
+        if (m + 1 == mipmaps) break;
+        Level next = downsample(&current);
+        if (current.rgba != level.rgba) free(current.rgba);
+        if (!next.rgba) { mipmaps = m + 1; break; }
+        current = next;
+    }
+    if (current.rgba != level.rgba) free(current.rgba);
+
+    FILE *f = fopen(outPath, "wb");
+    bool ok = f != NULL;
+    if (ok) {
+        writeDdsHeader(f, level.width, level.height, mipmaps, alpha, (uint32_t)base);
+        ok = fwrite(data, 1, padded, f) == padded;
+        ok = fclose(f) == 0 && ok;
+    }
+    size_t rgbaBytes = (size_t)level.width * level.height * 4;
+    fprintf(stderr, "%s -> %s : %dx%d %s, %d mips, %.1f Mo -> %.1f Mo en mémoire vidéo\n",
+            path, ok ? outPath : "échec d'écriture", level.width, level.height, alpha ? "BC3" : "BC1",
+            mipmaps, rgbaBytes / 1048576.0, total / 1048576.0);
+    free(data);
+    UnloadImage(image);
+    return ok;
+}
+
+int main(int argc, char **argv) {
+    SetTraceLogLevel(LOG_WARNING);
+    int failures = 0;
+    if (argc > 1) {
+        for (int i = 1; i < argc; ++i) failures += !convert(argv[i]);
+    } else {
+        for (size_t i = 0; i < sizeof(DEFAULT_IMAGES) / sizeof(DEFAULT_IMAGES[0]); ++i) {
+            if (!FileExists(DEFAULT_IMAGES[i])) continue; // couches optionnelles
+            failures += !convert(DEFAULT_IMAGES[i]);
+        }
+    }
+    return failures ? 1 : 0;
+}